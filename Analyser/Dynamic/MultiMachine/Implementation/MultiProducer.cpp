@@ -53,7 +53,7 @@ void MultiInterface<MachineType>::perform_serial(const std::function<void(Machin
 }
 
 // MARK: - MultiScanProducer
-void MultiScanProducer::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
+void MultiScanProducer::apply_scan_target(Outputs::Display::ScanTarget *scan_target) {
 	scan_target_ = scan_target;
 
 	std::lock_guard<decltype(machines_mutex_)> machines_lock(machines_mutex_);
@@ -103,3 +103,16 @@ void MultiTimedMachine::run_for(Time::Seconds duration) {
 
 	if(delegate_) delegate_->did_run_machines(this);
 }
+
+void MultiTimedMachine::set_output_enabled(bool enabled) {
+	TimedMachine::set_output_enabled(enabled);
+	perform_serial([enabled](::MachineTypes::TimedMachine *machine) {
+		machine->set_output_enabled(enabled);
+	});
+}
+
+void MultiTimedMachine::set_approximate_timing_enabled(bool enabled) {
+	perform_serial([enabled](::MachineTypes::TimedMachine *machine) {
+		machine->set_approximate_timing_enabled(enabled);
+	});
+}
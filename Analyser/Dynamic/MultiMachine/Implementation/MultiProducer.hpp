@@ -67,6 +67,8 @@ class MultiTimedMachine: public MultiInterface<MachineTypes::TimedMachine>, publ
 		}
 
 		void run_for(Time::Seconds duration) final;
+		void set_output_enabled(bool enabled) final;
+		void set_approximate_timing_enabled(bool enabled) final;
 
 	private:
 		void run_for(const Cycles cycles) final {}
@@ -84,7 +86,7 @@ class MultiScanProducer: public MultiInterface<MachineTypes::ScanProducer>, publ
 		*/
 		void did_change_machine_order();
 
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final;
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final;
 		Outputs::Display::ScanStatus get_scan_status() const final;
 
 	private:
@@ -51,6 +51,14 @@ MachineTypes::MouseMachine *MultiMachine::mouse_machine() {
 	return nullptr;
 }
 
+MachineTypes::StateProducer *MultiMachine::state_producer() {
+	// State can be captured only once a single machine has been settled upon.
+	if(has_picked_) {
+		return machines_.front()->state_producer();
+	}
+	return nullptr;
+}
+
 #undef Provider
 
 bool MultiMachine::would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines) {
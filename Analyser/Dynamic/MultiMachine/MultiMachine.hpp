@@ -60,6 +60,7 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::
 		MachineTypes::KeyboardMachine *keyboard_machine() final;
 		MachineTypes::MouseMachine *mouse_machine() final;
 		MachineTypes::MediaTarget *media_target() final;
+		MachineTypes::StateProducer *state_producer() final;
 		void *raw_pointer() final;
 
 	private:
@@ -9,9 +9,20 @@
 #include "StaticAnalyser.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iterator>
+#include <mutex>
+#include <set>
+#include <typeinfo>
+
+#include "../../Concurrency/AsyncTaskQueue.hpp"
 
 // Analysers
 #include "Acorn/StaticAnalyser.hpp"
@@ -28,6 +39,18 @@
 #include "Sega/StaticAnalyser.hpp"
 #include "ZX8081/StaticAnalyser.hpp"
 
+// Targets
+#include "Acorn/Target.hpp"
+#include "AmstradCPC/Target.hpp"
+#include "AppleII/Target.hpp"
+#include "AtariST/Target.hpp"
+#include "Commodore/Target.hpp"
+#include "Macintosh/Target.hpp"
+#include "MSX/Target.hpp"
+#include "Oric/Target.hpp"
+#include "Sega/Target.hpp"
+#include "ZX8081/Target.hpp"
+
 // Cartridges
 #include "../../Storage/Cartridge/Formats/BinaryDump.hpp"
 #include "../../Storage/Cartridge/Formats/PRG.hpp"
@@ -66,9 +89,22 @@
 // Target Platform Types
 #include "../../Storage/TargetPlatforms.hpp"
 
+#include "../../Storage/FileHolder.hpp"
+
 using namespace Analyser::Static;
 
-static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::IntType &potential_platforms) {
+/*!
+	Constructs all media that @c file_name might contain, forming the union of all platforms it might be a target for
+	in @c potential_platforms.
+
+	If @c formats is supplied, the name of each format successfully constructed is appended to it, in the same order
+	as media was added. If @c permitted_formats is supplied, only those formats are attempted.
+*/
+static Media GetMediaAndPlatforms(
+	const std::string &file_name,
+	TargetPlatform::IntType &potential_platforms,
+	std::vector<std::string> *formats = nullptr,
+	const std::set<std::string> *permitted_formats = nullptr) {
 	Media result;
 
 	// Get the extension, if any; it will be assumed that extensions are reliable, so an extension is a broad-phase
@@ -79,7 +115,9 @@ static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::
 	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
 #define Insert(list, class, platforms) \
+	if(permitted_formats && permitted_formats->find(#class) == permitted_formats->end()) throw std::exception();\
 	list.emplace_back(new Storage::class(file_name));\
+	if(formats) formats->push_back(#class);\
 	potential_platforms |= platforms;\
 	TargetPlatform::TypeDistinguisher *distinguisher = dynamic_cast<TargetPlatform::TypeDistinguisher *>(list.back().get());\
 	if(distinguisher) potential_platforms &= distinguisher->target_platform_type();
@@ -168,20 +206,317 @@ Media Analyser::Static::GetMedia(const std::string &file_name) {
 	return GetMediaAndPlatforms(file_name, throwaway);
 }
 
-TargetList Analyser::Static::GetTargets(const std::string &file_name) {
+namespace {
+
+/// Any target with at least this confidence ends analysis of all other platforms.
+constexpr float HighConfidence = 0.95f;
+
+/*!
+	Wraps a tape so that analysis of it can be cut short: once @c is_cancelled is set the
+	tape reports that it has ended, and supplies only silence.
+*/
+class CancellableTape: public Storage::Tape::Tape {
+	public:
+		CancellableTape(const std::shared_ptr<Storage::Tape::Tape> &tape, const std::atomic<bool> &is_cancelled, size_t index) :
+			tape_(tape), is_cancelled_(is_cancelled), index_(index) {}
+
+		bool is_at_end() final {
+			return is_cancelled_.load(std::memory_order_relaxed) || tape_->is_at_end();
+		}
+
+		const std::shared_ptr<Storage::Tape::Tape> &tape() const {
+			return tape_;
+		}
+
+		/// @returns The index of this tape within the media that was analysed.
+		size_t index() const {
+			return index_;
+		}
+
+	private:
+		std::shared_ptr<Storage::Tape::Tape> tape_;
+		const std::atomic<bool> &is_cancelled_;
+		const size_t index_;
+
+		Pulse virtual_get_next_pulse() final {
+			if(is_cancelled_.load(std::memory_order_relaxed)) return Pulse(Pulse::Zero, Storage::Time(1));
+			return tape_->get_next_pulse();
+		}
+
+		void virtual_reset() final {
+			tape_->reset();
+		}
+};
+
+// MARK: - Analysis cache.
+
+using Analyser::Machine;
+
+/// Increment whenever a change to any analyser or media format might alter its results, to invalidate all cached analysis.
+constexpr uint32_t AnalysisCacheVersion = 1;
+
+/// The media referred to by a target, as indices into each list of the Media from which it was analysed.
+struct MediaIndices {
+	std::vector<uint8_t> disks, tapes, mass_storage_devices;
+};
+
+/*!
+	@returns A new target of the type that analysers produce for @c machine, or @c nullptr if
+	those targets have state that can't be cached.
+*/
+std::unique_ptr<Target> NewCacheableTarget(Machine machine) {
+	switch(machine) {
+		default:					return nullptr;
+		case Machine::AmstradCPC:	return std::make_unique<AmstradCPC::Target>();
+		case Machine::AppleII:		return std::make_unique<AppleII::Target>();
+		case Machine::AtariST:		return std::make_unique<AtariST::Target>();
+		case Machine::Electron:		return std::make_unique<Acorn::Target>();
+		case Machine::Macintosh:	return std::make_unique<Macintosh::Target>();
+		case Machine::MSX:			return std::make_unique<MSX::Target>();
+		case Machine::Oric:			return std::make_unique<Oric::Target>();
+		case Machine::Vic20:		return std::make_unique<Commodore::Target>();
+		case Machine::ZX8081:		return std::make_unique<ZX8081::Target>();
+	}
+}
+
+/// Points to those fields of a cacheable target that are set by analysers but aren't exposed for reflection.
+struct UnreflectedFields {
+	std::string *loading_command = nullptr;
+	bool *flag = nullptr;
+};
+
+UnreflectedFields GetUnreflectedFields(Target &target) {
+#define LoadingCommand(ns)	\
+	if(const auto ns##_target = dynamic_cast<ns::Target *>(&target)) return {&ns##_target->loading_command};
+
+	if(const auto acorn_target = dynamic_cast<Acorn::Target *>(&target)) {
+		return {&acorn_target->loading_command, &acorn_target->should_shift_restart};
+	}
+	if(const auto oric_target = dynamic_cast<Oric::Target *>(&target)) {
+		return {&oric_target->loading_command, &oric_target->should_start_jasmin};
+	}
+	LoadingCommand(AmstradCPC);
+	LoadingCommand(Commodore);
+	LoadingCommand(MSX);
+	LoadingCommand(ZX8081);
+
+#undef LoadingCommand
+	return {};
+}
+
+/*!
+	@returns The name of the file within @c cache_directory that holds, or would hold, analysis of @c file_name;
+	it's a hash of the file's contents, of its lower-cased name — which some analysers inspect for hints, and which
+	includes the extension — and of the cache version. Also provides the size of the file.
+	Returns the empty string if @c file_name can't be read.
+*/
+std::string CacheFileName(const std::string &file_name, const std::string &cache_directory, uint64_t &file_size) {
+	try {
+		Storage::FileHolder file(file_name, Storage::FileHolder::FileMode::Read);
+		const auto contents = file.contents();
+		file_size = contents.size();
+
+		// FNV-1a.
+		uint64_t hash = 0xcbf2'9ce4'8422'2325;
+		const auto add = [&hash] (uint8_t value) {
+			hash = (hash ^ value) * 0x100'0000'01b3;
+		};
+		for(const auto value: contents) add(value);
+		for(const auto value: file_name) add(uint8_t(std::tolower(static_cast<unsigned char>(value))));
+		for(int c = 0; c < 32; c += 8) add(uint8_t(AnalysisCacheVersion >> c));
+
+		char name[21];
+		std::snprintf(name, sizeof(name), "%016llx.clk", static_cast<unsigned long long>(hash));
+		if(cache_directory.back() == '/') return cache_directory + name;
+		return cache_directory + "/" + name;
+	} catch(...) {
+		return "";
+	}
+}
+
+constexpr char CacheSignature[] = "CLKAnalysis";
+
+/*!
+	Attempts to read a cached analysis of @c file_name from @c cache_file_name, constructing only those
+	media formats that the original analysis found.
+
+	@returns @c true if @c targets has been populated; @c false if there's no usable cached analysis.
+*/
+bool ReadCache(const std::string &file_name, const std::string &cache_file_name, uint64_t file_size, TargetList &targets) {
+	try {
+		Storage::FileHolder file(cache_file_name, Storage::FileHolder::FileMode::Read);
+		auto cursor = file.cursor();
+		if(!cursor.check_signature(CacheSignature, sizeof(CacheSignature))) return false;
+		if(cursor.get32le() != AnalysisCacheVersion) return false;
+		uint64_t cached_size = cursor.get32le();
+		cached_size |= uint64_t(cursor.get32le()) << 32;
+		if(cached_size != file_size) return false;
+
+		const auto read_string = [&cursor] {
+			const auto text = cursor.read(cursor.get16le());
+			return std::string(text.begin(), text.end());
+		};
+
+		// Reconstruct the media, using only the formats found originally.
+		std::vector<std::string> cached_formats(cursor.get16le());
+		for(auto &format: cached_formats) {
+			format = read_string();
+		}
+		if(cursor.eof()) return false;
+
+		const std::set<std::string> permitted_formats(cached_formats.begin(), cached_formats.end());
+		std::vector<std::string> formats;
+		TargetPlatform::IntType throwaway;
+		const Media media = GetMediaAndPlatforms(file_name, throwaway, &formats, &permitted_formats);
+		if(formats != cached_formats) return false;
+
+		// Reconstruct the targets.
+		TargetList result;
+		const size_t target_count = cursor.get16le();
+		for(size_t c = 0; c < target_count; ++c) {
+			auto target = NewCacheableTarget(Machine(cursor.get8()));
+			if(!target) return false;
+
+			const uint32_t confidence = cursor.get32le();
+			std::memcpy(&target->confidence, &confidence, sizeof(confidence));
+
+			const auto fields = GetUnreflectedFields(*target);
+			const bool flag = cursor.get8();
+			const std::string loading_command = read_string();
+			if(fields.flag) *fields.flag = flag;
+			if(fields.loading_command) *fields.loading_command = loading_command;
+
+			const auto attach = [&cursor] (auto &destination, const auto &source) {
+				const size_t count = cursor.get8();
+				for(size_t index = 0; index < count; ++index) {
+					const size_t source_index = cursor.get8();
+					if(source_index >= source.size()) return false;
+					destination.push_back(source[source_index]);
+				}
+				return true;
+			};
+			if(
+				!attach(target->media.disks, media.disks) ||
+				!attach(target->media.tapes, media.tapes) ||
+				!attach(target->media.mass_storage_devices, media.mass_storage_devices)
+			) return false;
+
+			const auto state = cursor.read(cursor.get32le());
+			if(cursor.eof()) return false;
+			if(!state.empty()) {
+				const auto reflectable = dynamic_cast<Reflection::Struct *>(target.get());
+				if(!reflectable || !reflectable->deserialise(std::vector<uint8_t>(state.begin(), state.end()))) return false;
+			}
+
+			result.push_back(std::move(target));
+		}
+
+		targets = std::move(result);
+		return true;
+	} catch(...) {
+		return false;
+	}
+}
+
+/*!
+	Writes @c targets, which were found from media constructed using @c formats, to @c cache_file_name.
+*/
+void WriteCache(
+	const std::string &cache_file_name,
+	uint64_t file_size,
+	const std::vector<std::string> &formats,
+	const TargetList &targets,
+	const std::vector<MediaIndices> &indices) {
+	std::vector<uint8_t> output;
+	const auto put_le = [&output] (auto value) {
+		for(size_t c = 0; c < sizeof(value); ++c) {
+			output.push_back(uint8_t(value >> (c * 8)));
+		}
+	};
+	const auto put_data = [&output] (const auto &data) {
+		std::copy(data.begin(), data.end(), std::back_inserter(output));
+	};
+
+	for(const auto character: CacheSignature) {
+		output.push_back(uint8_t(character));
+	}
+	put_le(AnalysisCacheVersion);
+	put_le(file_size);
+
+	put_le(uint16_t(formats.size()));
+	for(const auto &format: formats) {
+		put_le(uint16_t(format.size()));
+		put_data(format);
+	}
+
+	put_le(uint16_t(targets.size()));
+	for(size_t c = 0; c < targets.size(); ++c) {
+		Target &target = *targets[c];
+		put_le(uint8_t(target.machine));
+
+		uint32_t confidence;
+		std::memcpy(&confidence, &target.confidence, sizeof(confidence));
+		put_le(confidence);
+
+		const auto fields = GetUnreflectedFields(target);
+		put_le(uint8_t(fields.flag ? *fields.flag : false));
+		const std::string loading_command = fields.loading_command ? *fields.loading_command : "";
+		put_le(uint16_t(loading_command.size()));
+		put_data(loading_command);
+
+		for(const auto list: {&indices[c].disks, &indices[c].tapes, &indices[c].mass_storage_devices}) {
+			put_le(uint8_t(list->size()));
+			put_data(*list);
+		}
+
+		const auto reflectable = dynamic_cast<Reflection::Struct *>(&target);
+		const auto state = reflectable ? reflectable->serialise() : std::vector<uint8_t>();
+		put_le(uint32_t(state.size()));
+		put_data(state);
+	}
+
+	// Write to a temporary file and then move it into place, so that the cache never
+	// contains a partial file.
+	const std::string temporary_name =
+		cache_file_name + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+	try {
+		{
+			Storage::FileHolder file(temporary_name, Storage::FileHolder::FileMode::Rewrite);
+			if(file.write(output) != output.size()) throw std::exception();
+		}
+		if(std::rename(temporary_name.c_str(), cache_file_name.c_str())) throw std::exception();
+	} catch(...) {
+		std::remove(temporary_name.c_str());
+	}
+}
+
+}
+
+TargetList Analyser::Static::GetTargets(const std::string &file_name, Time::Seconds budget, const std::string &cache_directory) {
 	TargetList targets;
 
+	// Use a cached analysis if there is one.
+	std::string cache_file_name;
+	uint64_t file_size = 0;
+	if(!cache_directory.empty()) {
+		cache_file_name = CacheFileName(file_name, cache_directory, file_size);
+		if(!cache_file_name.empty() && ReadCache(file_name, cache_file_name, file_size, targets)) {
+			return targets;
+		}
+	}
+
 	// Collect all disks, tapes ROMs, etc as can be extrapolated from this file, forming the
 	// union of all platforms this file might be a target for.
 	TargetPlatform::IntType potential_platforms = 0;
-	Media media = GetMediaAndPlatforms(file_name, potential_platforms);
+	std::vector<std::string> formats;
+	Media media = GetMediaAndPlatforms(file_name, potential_platforms, &formats);
 
 	// Hand off to platform-specific determination of whether these things are actually compatible and,
 	// if so, how to load them.
-	#define Append(x) {\
-		auto new_targets = x::GetTargets(media, file_name, potential_platforms);\
-		std::move(new_targets.begin(), new_targets.end(), std::back_inserter(targets));\
-	}
+	std::vector<std::function<TargetList(const Media &)>> analysers;
+	#define Append(x) analysers.push_back([&file_name, potential_platforms] (const Media &media) {\
+		return x::GetTargets(media, file_name, potential_platforms);\
+	})
 	if(potential_platforms & TargetPlatform::Acorn)			Append(Acorn);
 	if(potential_platforms & TargetPlatform::AmstradCPC)	Append(AmstradCPC);
 	if(potential_platforms & TargetPlatform::AppleII)		Append(AppleII);
@@ -197,6 +532,121 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 	if(potential_platforms & TargetPlatform::ZX8081)		Append(ZX8081);
 	#undef Append
 
+	// Reflective targets declare their fields upon first construction, to registries that aren't
+	// thread safe; make sure that has happened before any analysers run.
+	static std::once_flag declare_targets;
+	std::call_once(declare_targets, [] {
+		Acorn::Target();
+		AmstradCPC::Target();
+		AppleII::Target();
+		AtariST::Target();
+		Commodore::Target();
+		Macintosh::Target();
+		MSX::Target();
+		Oric::Target();
+		Sega::Target();
+		ZX8081::Target();
+	});
+
+	// Run each analyser on a queue of its own. Disks, cartridges and mass-storage devices are
+	// random access so can be shared, but tapes have a read position so each analyser other than
+	// the first gets tapes of its own.
+	std::vector<TargetList> results(analysers.size());
+	std::atomic<bool> is_cancelled(false), was_cut_short(false);
+	std::mutex mutex;
+	std::condition_variable condition;
+	size_t outstanding = analysers.size();
+
+	std::vector<std::unique_ptr<Concurrency::AsyncTaskQueue>> queues;
+	for(size_t c = 0; c < analysers.size(); ++c) {
+		queues.push_back(std::make_unique<Concurrency::AsyncTaskQueue>());
+		queues.back()->enqueue([&, c] {
+			Media analyser_media = media;
+			if(c && !analyser_media.tapes.empty()) {
+				analyser_media.tapes = GetMedia(file_name).tapes;
+			}
+			for(size_t index = 0; index < analyser_media.tapes.size(); ++index) {
+				auto &tape = analyser_media.tapes[index];
+				tape = std::make_shared<CancellableTape>(tape, is_cancelled, index);
+			}
+
+			results[c] = analysers[c](analyser_media);
+			if(is_cancelled && !analyser_media.tapes.empty()) {
+				was_cut_short = true;
+			}
+			for(const auto &target: results[c]) {
+				if(target->confidence >= HighConfidence) {
+					is_cancelled = true;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			--outstanding;
+			condition.notify_all();
+		});
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		const auto is_finished = [&outstanding, &is_cancelled] { return !outstanding || is_cancelled; };
+		if(budget > 0.0) {
+			condition.wait_for(lock, std::chrono::duration<Time::Seconds>(budget), is_finished);
+		} else {
+			condition.wait(lock, is_finished);
+		}
+
+		// Cut short anything still running, and wait for it to notice.
+		is_cancelled = true;
+		condition.wait(lock, [&outstanding] { return !outstanding; });
+	}
+
+	// Collect results in platform order, exchanging each cancellable tape for the original.
+	// If a cache is in use, also note where in the original media each target's media was found;
+	// if that can't be expressed then the analysis isn't cached.
+	bool is_cacheable = !cache_file_name.empty() && !was_cut_short && media.cartridges.empty();
+	std::vector<MediaIndices> indices;
+	const auto find_index = [&is_cacheable] (const auto &list, const auto &item) {
+		const auto iterator = std::find(list.begin(), list.end(), item);
+		if(iterator == list.end() || list.size() > 256) is_cacheable = false;
+		return uint8_t(iterator - list.begin());
+	};
+
+	for(auto &result: results) {
+		for(auto &target: result) {
+			MediaIndices target_indices;
+			for(auto &tape: target->media.tapes) {
+				const auto cancellable = dynamic_cast<CancellableTape *>(tape.get());
+				if(cancellable) {
+					target_indices.tapes.push_back(uint8_t(cancellable->index()));
+					tape = cancellable->tape();
+				} else {
+					is_cacheable = false;
+				}
+			}
+
+			if(is_cacheable) {
+				for(const auto &disk: target->media.disks) {
+					target_indices.disks.push_back(find_index(media.disks, disk));
+				}
+				for(const auto &device: target->media.mass_storage_devices) {
+					target_indices.mass_storage_devices.push_back(find_index(media.mass_storage_devices, device));
+				}
+
+				const auto prototype = NewCacheableTarget(target->machine);
+				const Target &prototype_target = prototype ? *prototype : *target;
+				if(!prototype || typeid(prototype_target) != typeid(*target) || !target->media.cartridges.empty()) {
+					is_cacheable = false;
+				}
+			}
+			indices.push_back(std::move(target_indices));
+		}
+		std::move(result.begin(), result.end(), std::back_inserter(targets));
+	}
+	std::vector<const Target *> cache_order;
+	for(const auto &target: targets) {
+		cache_order.push_back(target.get());
+	}
+
 	// Reset any tapes to their initial position
 	for(const auto &target : targets) {
 		for(auto &tape : target->media.tapes) {
@@ -211,5 +661,19 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 			return a->confidence > b->confidence;
 		});
 
+	if(is_cacheable) {
+		// Sort the indices to match.
+		std::vector<MediaIndices> sorted_indices;
+		for(const auto &target: targets) {
+			for(size_t c = 0; c < targets.size(); ++c) {
+				if(cache_order[c] == target.get()) {
+					sorted_indices.push_back(indices[c]);
+					break;
+				}
+			}
+		}
+		WriteCache(cache_file_name, file_size, formats, targets, sorted_indices);
+	}
+
 	return targets;
 }
@@ -11,6 +11,7 @@
 
 #include "../Machines.hpp"
 
+#include "../../ClockReceiver/TimeTypes.hpp"
 #include "../../Storage/Cartridge/Cartridge.hpp"
 #include "../../Storage/Disk/Disk.hpp"
 #include "../../Storage/MassStorage/MassStorageDevice.hpp"
@@ -64,9 +65,19 @@ typedef std::vector<std::unique_ptr<Target>> TargetList;
 /*!
 	Attempts, through any available means, to return a list of potential targets for the file with the given name.
 
+	All potentially-applicable platforms are analysed concurrently. Analysis is cut short if any platform
+	produces a target of high confidence, or once @c budget seconds have elapsed, in which case any platform
+	still inspecting a tape will see it end where it then is.
+
+	If @c cache_directory is supplied then it is used to store the results of complete analyses, indexed by
+	a hash of the file's contents. A later request for a file with the same contents is then answered without
+	analysis, constructing only those media formats that were originally found to accept the file.
+
+	@param budget The maximum amount of time to spend before cutting analysis short, or 0 for no limit.
+	@param cache_directory An existing directory in which to cache analysis, or the empty string for no cache.
 	@returns The list of potential targets, sorted from most to least probable.
 */
-TargetList GetTargets(const std::string &file_name);
+TargetList GetTargets(const std::string &file_name, Time::Seconds budget = 0.0, const std::string &cache_directory = "");
 
 /*!
 	Inspects the supplied file and determines the media included.
@@ -16,6 +16,7 @@
 #include "Implementation/6522Storage.hpp"
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
 namespace MOS {
 namespace MOS6522 {
@@ -135,6 +136,123 @@ template <class T> class MOS6522: public MOS6522Storage {
 		/// if this affects the visible output, it will be passed to the handler.
 		void set_control_line_output(Port port, Line line, LineState value);
 		void evaluate_cb2_output();
+
+		friend struct State;
+};
+
+/*!
+	Provides a means for capturing or restoring complete 6522 state.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t output[2]{}, input[2]{}, data_direction[2]{};
+	uint16_t timer[2]{}, timer_latch[2]{}, last_timer[2]{};
+	int next_timer[2] = {-1, -1};
+	uint8_t shift = 0;
+	uint8_t auxiliary_control = 0;
+	uint8_t peripheral_control = 0;
+	uint8_t interrupt_flags = 0;
+	uint8_t interrupt_enable = 0;
+	bool timer_needs_reload = false;
+
+	bool control_inputs[4]{};
+	int control_outputs[4]{};
+	int handshake_modes[2]{};
+	bool timer_is_running[2]{};
+	bool last_posted_interrupt_status = false;
+	int shift_bits_remaining = 8;
+	bool is_phase2 = false;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(output);
+			DeclareField(input);
+			DeclareField(data_direction);
+			DeclareField(timer);
+			DeclareField(timer_latch);
+			DeclareField(last_timer);
+			DeclareField(next_timer);
+			DeclareField(shift);
+			DeclareField(auxiliary_control);
+			DeclareField(peripheral_control);
+			DeclareField(interrupt_flags);
+			DeclareField(interrupt_enable);
+			DeclareField(timer_needs_reload);
+			DeclareField(control_inputs);
+			DeclareField(control_outputs);
+			DeclareField(handshake_modes);
+			DeclareField(timer_is_running);
+			DeclareField(last_posted_interrupt_status);
+			DeclareField(shift_bits_remaining);
+			DeclareField(is_phase2);
+		}
+	}
+
+	/// Instantiates a new State based on the 6522 @c src.
+	template <typename T> State(const MOS6522<T> &src) : State() {
+		for(int c = 0; c < 2; c++) {
+			output[c] = src.registers_.output[c];
+			input[c] = src.registers_.input[c];
+			data_direction[c] = src.registers_.data_direction[c];
+			timer[c] = src.registers_.timer[c];
+			timer_latch[c] = src.registers_.timer_latch[c];
+			last_timer[c] = src.registers_.last_timer[c];
+			next_timer[c] = src.registers_.next_timer[c];
+
+			control_inputs[c*2 + 0] = src.control_inputs_[c].lines[0];
+			control_inputs[c*2 + 1] = src.control_inputs_[c].lines[1];
+			control_outputs[c*2 + 0] = int(src.control_outputs_[c].lines[0]);
+			control_outputs[c*2 + 1] = int(src.control_outputs_[c].lines[1]);
+			handshake_modes[c] = int(src.handshake_modes_[c]);
+			timer_is_running[c] = src.timer_is_running_[c];
+		}
+		shift = src.registers_.shift;
+		auxiliary_control = src.registers_.auxiliary_control;
+		peripheral_control = src.registers_.peripheral_control;
+		interrupt_flags = src.registers_.interrupt_flags;
+		interrupt_enable = src.registers_.interrupt_enable;
+		timer_needs_reload = src.registers_.timer_needs_reload;
+
+		last_posted_interrupt_status = src.last_posted_interrupt_status_;
+		shift_bits_remaining = src.shift_bits_remaining_;
+		is_phase2 = src.is_phase2_;
+	}
+
+	/// Applies this state to @c target, and posts the resulting port and control line outputs to its bus handler.
+	template <typename T> void apply(MOS6522<T> &target) const {
+		for(int c = 0; c < 2; c++) {
+			target.registers_.output[c] = output[c];
+			target.registers_.input[c] = input[c];
+			target.registers_.data_direction[c] = data_direction[c];
+			target.registers_.timer[c] = timer[c];
+			target.registers_.timer_latch[c] = timer_latch[c];
+			target.registers_.last_timer[c] = last_timer[c];
+			target.registers_.next_timer[c] = next_timer[c];
+
+			target.control_inputs_[c].lines[0] = control_inputs[c*2 + 0];
+			target.control_inputs_[c].lines[1] = control_inputs[c*2 + 1];
+			target.control_outputs_[c].lines[0] = MOS6522Storage::LineState(control_outputs[c*2 + 0]);
+			target.control_outputs_[c].lines[1] = MOS6522Storage::LineState(control_outputs[c*2 + 1]);
+			target.handshake_modes_[c] = MOS6522Storage::HandshakeMode(handshake_modes[c]);
+			target.timer_is_running_[c] = timer_is_running[c];
+		}
+		target.registers_.shift = shift;
+		target.registers_.auxiliary_control = auxiliary_control;
+		target.registers_.peripheral_control = peripheral_control;
+		target.registers_.interrupt_flags = interrupt_flags;
+		target.registers_.interrupt_enable = interrupt_enable;
+		target.registers_.timer_needs_reload = timer_needs_reload;
+
+		target.last_posted_interrupt_status_ = last_posted_interrupt_status;
+		target.shift_bits_remaining_ = shift_bits_remaining;
+		target.is_phase2_ = is_phase2;
+
+		target.bus_handler_.set_port_output(Port::A, output[0], data_direction[0]);
+		target.bus_handler_.set_port_output(Port::B, output[1], data_direction[1]);
+		if(target.control_outputs_[0].lines[1] != MOS6522Storage::LineState::Input) {
+			target.bus_handler_.set_control_line_output(Port::A, Line::Two, target.control_outputs_[0].lines[1] != MOS6522Storage::LineState::Off);
+		}
+		target.evaluate_cb2_output();
+	}
 };
 
 }
@@ -14,6 +14,8 @@
 namespace MOS {
 namespace MOS6522 {
 
+struct State;
+
 class MOS6522Storage {
 	protected:
 		// Phase toggle
@@ -85,6 +87,8 @@ class MOS6522Storage {
 		bool is_shifting_out() const {
 			return registers_.auxiliary_control & 0x10;
 		}
+
+		friend struct State;
 };
 
 }
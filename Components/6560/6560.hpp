@@ -14,6 +14,10 @@
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Reflection/Struct.hpp"
+
+#include <algorithm>
+#include <iterator>
 
 namespace MOS {
 namespace MOS6560 {
@@ -53,6 +57,8 @@ enum class OutputMode {
 	PAL, NTSC
 };
 
+struct State;
+
 /*!
 	The 6560 Video Interface Chip ('VIC') is a video and audio output chip; it therefore vends both a @c CRT and a @c Speaker.
 
@@ -518,6 +524,117 @@ template <class BusHandler> class MOS6560 {
 			bool supports_interlacing;
 		} timing_;
 		OutputMode output_mode_;
+
+		friend struct MOS::MOS6560::State;
+};
+
+/*!
+	Provides a means for capturing or restoring complete 6560 state, other than that
+	of the CRT. Audio state is restored by rewriting the relevant registers.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[16]{};
+
+	int output_state = 0, this_state = 0;
+	int cycles_in_state = 0;
+
+	int horizontal_counter = 0, vertical_counter = 0;
+	bool vertical_drawing_latch = false, horizontal_drawing_latch = false;
+	int rows_this_field = 0, columns_this_line = 0;
+
+	int pixel_line_cycle = 0, column_counter = 0;
+	int current_row = 0;
+	uint16_t current_character_row = 0;
+	uint16_t video_matrix_address_counter = 0, base_video_matrix_address_counter = 0;
+
+	uint8_t character_code = 0, character_colour = 0, character_value = 0;
+	bool is_odd_frame = false, is_odd_line = false;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(registers);
+			DeclareField(output_state);
+			DeclareField(this_state);
+			DeclareField(cycles_in_state);
+			DeclareField(horizontal_counter);
+			DeclareField(vertical_counter);
+			DeclareField(vertical_drawing_latch);
+			DeclareField(horizontal_drawing_latch);
+			DeclareField(rows_this_field);
+			DeclareField(columns_this_line);
+			DeclareField(pixel_line_cycle);
+			DeclareField(column_counter);
+			DeclareField(current_row);
+			DeclareField(current_character_row);
+			DeclareField(video_matrix_address_counter);
+			DeclareField(base_video_matrix_address_counter);
+			DeclareField(character_code);
+			DeclareField(character_colour);
+			DeclareField(character_value);
+			DeclareField(is_odd_frame);
+			DeclareField(is_odd_line);
+		}
+	}
+
+	/// Instantiates a new State based on the 6560 @c src.
+	template <typename T> State(const MOS6560<T> &src) : State() {
+		std::copy(std::begin(src.registers_.direct_values), std::end(src.registers_.direct_values), std::begin(registers));
+
+		output_state = int(src.output_state_);
+		this_state = int(src.this_state_);
+		cycles_in_state = src.cycles_in_state_;
+
+		horizontal_counter = src.horizontal_counter_;
+		vertical_counter = src.vertical_counter_;
+		vertical_drawing_latch = src.vertical_drawing_latch_;
+		horizontal_drawing_latch = src.horizontal_drawing_latch_;
+		rows_this_field = src.rows_this_field_;
+		columns_this_line = src.columns_this_line_;
+
+		pixel_line_cycle = src.pixel_line_cycle_;
+		column_counter = src.column_counter_;
+		current_row = src.current_row_;
+		current_character_row = src.current_character_row_;
+		video_matrix_address_counter = src.video_matrix_address_counter_;
+		base_video_matrix_address_counter = src.base_video_matrix_address_counter_;
+
+		character_code = src.character_code_;
+		character_colour = src.character_colour_;
+		character_value = src.character_value_;
+		is_odd_frame = src.is_odd_frame_;
+		is_odd_line = src.is_odd_line_;
+	}
+
+	/// Applies this state to @c target.
+	template <typename T> void apply(MOS6560<T> &target) const {
+		for(int c = 0; c < 16; c++) {
+			target.write(c, registers[c]);
+		}
+
+		target.output_state_ = decltype(target.output_state_)(output_state & 3);
+		target.this_state_ = decltype(target.this_state_)(this_state & 3);
+		target.cycles_in_state_ = cycles_in_state;
+
+		target.horizontal_counter_ = horizontal_counter;
+		target.vertical_counter_ = vertical_counter;
+		target.vertical_drawing_latch_ = vertical_drawing_latch;
+		target.horizontal_drawing_latch_ = horizontal_drawing_latch;
+		target.rows_this_field_ = rows_this_field;
+		target.columns_this_line_ = columns_this_line;
+
+		target.pixel_line_cycle_ = pixel_line_cycle;
+		target.column_counter_ = column_counter;
+		target.current_row_ = current_row;
+		target.current_character_row_ = current_character_row;
+		target.video_matrix_address_counter_ = video_matrix_address_counter;
+		target.base_video_matrix_address_counter_ = base_video_matrix_address_counter;
+
+		target.character_code_ = character_code;
+		target.character_colour_ = character_colour;
+		target.character_value_ = character_value;
+		target.is_odd_frame_ = is_odd_frame;
+		target.is_odd_line_ = is_odd_line;
+	}
 };
 
 }
@@ -10,9 +10,12 @@
 #define CRTC6845_hpp
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <iterator>
 
 namespace Motorola {
 namespace CRTC {
@@ -51,6 +54,8 @@ enum Personality {
 	AMS40226	// Type 3. Status is get register, fixed-length VSYNC, no zero-length HSYNC.
 };
 
+struct State;
+
 // TODO UM6845R and R12/R13; see http://www.cpcwiki.eu/index.php/CRTC#CRTC_Differences
 
 template <class T> class CRTC6845 {
@@ -267,6 +272,126 @@ template <class T> class CRTC6845 {
 
 		int display_skew_mask_ = 1;
 		unsigned int character_is_visible_shifter_ = 0;
+
+		friend struct State;
+};
+
+/*!
+	Provides a means for capturing or restoring complete 6845 state.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[18]{};
+	uint8_t dummy_register = 0;
+	int selected_register = 0;
+
+	uint8_t character_counter = 0;
+	uint8_t line_counter = 0;
+	bool character_is_visible = false;
+	bool line_is_visible = false;
+
+	int hsync_counter = 0;
+	int vsync_counter = 0;
+	bool is_in_adjustment_period = false;
+
+	uint16_t line_address = 0;
+	uint16_t end_of_line_address = 0;
+	uint8_t status = 0;
+
+	int display_skew_mask = 1;
+	uint32_t character_is_visible_shifter = 0;
+
+	bool display_enable = false;
+	bool hsync = false;
+	bool vsync = false;
+	bool cursor = false;
+	uint16_t refresh_address = 0;
+	uint16_t row_address = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(registers);
+			DeclareField(dummy_register);
+			DeclareField(selected_register);
+			DeclareField(character_counter);
+			DeclareField(line_counter);
+			DeclareField(character_is_visible);
+			DeclareField(line_is_visible);
+			DeclareField(hsync_counter);
+			DeclareField(vsync_counter);
+			DeclareField(is_in_adjustment_period);
+			DeclareField(line_address);
+			DeclareField(end_of_line_address);
+			DeclareField(status);
+			DeclareField(display_skew_mask);
+			DeclareField(character_is_visible_shifter);
+			DeclareField(display_enable);
+			DeclareField(hsync);
+			DeclareField(vsync);
+			DeclareField(cursor);
+			DeclareField(refresh_address);
+			DeclareField(row_address);
+		}
+	}
+
+	/// Instantiates a new State based on the 6845 @c src.
+	template <typename T> State(const CRTC6845<T> &src) : State() {
+		std::copy(std::begin(src.registers_), std::end(src.registers_), std::begin(registers));
+		dummy_register = src.dummy_register_;
+		selected_register = src.selected_register_;
+
+		character_counter = src.character_counter_;
+		line_counter = src.line_counter_;
+		character_is_visible = src.character_is_visible_;
+		line_is_visible = src.line_is_visible_;
+
+		hsync_counter = src.hsync_counter_;
+		vsync_counter = src.vsync_counter_;
+		is_in_adjustment_period = src.is_in_adjustment_period_;
+
+		line_address = src.line_address_;
+		end_of_line_address = src.end_of_line_address_;
+		status = src.status_;
+
+		display_skew_mask = src.display_skew_mask_;
+		character_is_visible_shifter = src.character_is_visible_shifter_;
+
+		display_enable = src.bus_state_.display_enable;
+		hsync = src.bus_state_.hsync;
+		vsync = src.bus_state_.vsync;
+		cursor = src.bus_state_.cursor;
+		refresh_address = src.bus_state_.refresh_address;
+		row_address = src.bus_state_.row_address;
+	}
+
+	/// Applies this state to @c target.
+	template <typename T> void apply(CRTC6845<T> &target) const {
+		std::copy(std::begin(registers), std::end(registers), std::begin(target.registers_));
+		target.dummy_register_ = dummy_register;
+		target.selected_register_ = selected_register & 31;
+
+		target.character_counter_ = character_counter;
+		target.line_counter_ = line_counter;
+		target.character_is_visible_ = character_is_visible;
+		target.line_is_visible_ = line_is_visible;
+
+		target.hsync_counter_ = hsync_counter;
+		target.vsync_counter_ = vsync_counter;
+		target.is_in_adjustment_period_ = is_in_adjustment_period;
+
+		target.line_address_ = line_address;
+		target.end_of_line_address_ = end_of_line_address;
+		target.status_ = status;
+
+		target.display_skew_mask_ = display_skew_mask;
+		target.character_is_visible_shifter_ = character_is_visible_shifter;
+
+		target.bus_state_.display_enable = display_enable;
+		target.bus_state_.hsync = hsync;
+		target.bus_state_.vsync = vsync;
+		target.bus_state_.cursor = cursor;
+		target.bus_state_.refresh_address = refresh_address;
+		target.bus_state_.row_address = row_address;
+	}
 };
 
 }
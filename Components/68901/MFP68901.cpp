@@ -208,7 +208,24 @@ void MFP68901::run_for(HalfCycles time) {
 }
 
 HalfCycles MFP68901::get_next_sequence_point() {
-	return HalfCycles(-1);
+	// Find the timer that will next count down to zero; per run_for, each decrements upon every
+	// prescale'th cycle and, per decrement_timer, expires upon reaching zero, a value of zero
+	// initially meaning 256.
+	HalfCycles::IntType cycles = -1;
+	for(int c = 0; c < 4; ++c) {
+		if(timers_[c].mode < TimerMode::Delay) continue;
+
+		const int decrements = timers_[c].value ? timers_[c].value : 256;
+		const HalfCycles::IntType timer_cycles =
+			std::max(timers_[c].prescale - timers_[c].prescale_count, 1) +
+			HalfCycles::IntType(decrements - 1) * timers_[c].prescale;
+		if(cycles < 0 || timer_cycles < cycles) {
+			cycles = timer_cycles;
+		}
+	}
+
+	if(cycles < 0) return HalfCycles(-1);
+	return HalfCycles(cycles * 2) - cycles_left_;
 }
 
 // MARK: - Timers
@@ -39,7 +39,9 @@ class MFP68901: public ClockingHint::Source {
 		/// at which the interrupt line _might_ change. This object conforms to ClockingHint::Source
 		/// so that mechanism can also be used to reduce the quantity of calls into this class.
 		///
-		/// @discussion TODO, alas.
+		/// @discussion Only the timers are considered: this is the time until the next of them
+		/// expires, or -1 if none is running. Changes in the GPIP or timer event inputs are
+		/// necessarily unpredictable.
 		HalfCycles get_next_sequence_point();
 
 		/// Sets the current level of either of the timer event inputs — TAI and TBI in datasheet terms.
@@ -9,6 +9,10 @@
 #ifndef i8255_hpp
 #define i8255_hpp
 
+#include "../../Reflection/Struct.hpp"
+
+#include <cstdint>
+
 namespace Intel {
 namespace i8255 {
 
@@ -18,6 +22,8 @@ class PortHandler {
 		uint8_t get_value(int port) { return 0xff; }
 };
 
+struct State;
+
 // TODO: Modes 1 and 2.
 template <class T> class i8255 {
 	public:
@@ -84,6 +90,40 @@ template <class T> class i8255 {
 		uint8_t control_;
 		uint8_t outputs_[3];
 		T &port_handler_;
+
+		friend struct State;
+};
+
+/*!
+	Provides a means for capturing or restoring complete 8255 state.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t control = 0;
+	uint8_t outputs[3]{};
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(control);
+			DeclareField(outputs);
+		}
+	}
+
+	/// Instantiates a new State based on the 8255 @c src.
+	template <typename T> State(const i8255<T> &src) : State() {
+		control = src.control_;
+		outputs[0] = src.outputs_[0];
+		outputs[1] = src.outputs_[1];
+		outputs[2] = src.outputs_[2];
+	}
+
+	/// Applies this state to @c target, and posts the resulting outputs to its port handler.
+	template <typename T> void apply(i8255<T> &target) const {
+		target.control_ = control;
+		target.outputs_[0] = outputs[0];
+		target.outputs_[1] = outputs[1];
+		target.outputs_[2] = outputs[2];
+		target.update_outputs();
+	}
 };
 
 }
@@ -8,7 +8,9 @@
 
 #include "9918.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <cstring>
 #include <cstdlib>
 #include "../../Outputs/Log.hpp"
@@ -1046,3 +1048,190 @@ void Base::draw_sms(int start, int end, uint32_t cram_dot) {
 		}
 	}
 }
+
+// MARK: - State
+
+State::State() {
+	if(needs_declare()) {
+		DeclareField(ram);
+
+		DeclareField(ram_pointer);
+		DeclareField(read_ahead_buffer);
+		DeclareField(queued_access);
+		DeclareField(cycles_until_access);
+		DeclareField(minimum_access_column);
+
+		DeclareField(status);
+		DeclareField(write_phase);
+		DeclareField(low_write);
+
+		DeclareField(mode1_enable);
+		DeclareField(mode2_enable);
+		DeclareField(mode3_enable);
+		DeclareField(blank_display);
+		DeclareField(sprites_16x16);
+		DeclareField(sprites_magnified);
+		DeclareField(generate_interrupts);
+		DeclareField(sprite_height);
+		DeclareField(pattern_name_address);
+		DeclareField(colour_table_address);
+		DeclareField(pattern_generator_table_address);
+		DeclareField(sprite_attribute_table_address);
+		DeclareField(sprite_generator_table_address);
+		DeclareField(text_colour);
+		DeclareField(background_colour);
+
+		DeclareField(cycles_error);
+		DeclareField(latched_column);
+		DeclareField(pixel_lines);
+		DeclareField(first_vsync_line);
+		DeclareField(allow_sprite_terminator);
+		DeclareField(read_row);
+		DeclareField(read_column);
+		DeclareField(write_row);
+		DeclareField(write_column);
+
+		DeclareField(line_interrupt_target);
+		DeclareField(line_interrupt_counter);
+		DeclareField(enable_line_interrupts);
+		DeclareField(line_interrupt_pending);
+
+		DeclareField(vertical_scroll_lock);
+		DeclareField(horizontal_scroll_lock);
+		DeclareField(hide_left_column);
+		DeclareField(shift_sprites_8px_left);
+		DeclareField(mode4_enable);
+		DeclareField(horizontal_scroll);
+		DeclareField(vertical_scroll);
+		DeclareField(latched_vertical_scroll);
+		DeclareField(colour_ram);
+		DeclareField(cram_is_selected);
+		DeclareField(master_system_pattern_name_address);
+		DeclareField(master_system_sprite_attribute_table_address);
+		DeclareField(master_system_sprite_generator_table_address);
+	}
+}
+
+State::State(const TMS9918 &src) : State() {
+	ram = src.ram_;
+
+	ram_pointer = src.ram_pointer_;
+	read_ahead_buffer = src.read_ahead_buffer_;
+	queued_access = int(src.queued_access_);
+	cycles_until_access = src.cycles_until_access_;
+	minimum_access_column = src.minimum_access_column_;
+
+	status = src.status_;
+	write_phase = src.write_phase_;
+	low_write = src.low_write_;
+
+	mode1_enable = src.mode1_enable_;
+	mode2_enable = src.mode2_enable_;
+	mode3_enable = src.mode3_enable_;
+	blank_display = src.blank_display_;
+	sprites_16x16 = src.sprites_16x16_;
+	sprites_magnified = src.sprites_magnified_;
+	generate_interrupts = src.generate_interrupts_;
+	sprite_height = src.sprite_height_;
+	pattern_name_address = uint32_t(src.pattern_name_address_);
+	colour_table_address = uint32_t(src.colour_table_address_);
+	pattern_generator_table_address = uint32_t(src.pattern_generator_table_address_);
+	sprite_attribute_table_address = uint32_t(src.sprite_attribute_table_address_);
+	sprite_generator_table_address = uint32_t(src.sprite_generator_table_address_);
+	text_colour = src.text_colour_;
+	background_colour = src.background_colour_;
+
+	cycles_error = src.cycles_error_;
+	latched_column = src.latched_column_;
+	pixel_lines = src.mode_timing_.pixel_lines;
+	first_vsync_line = src.mode_timing_.first_vsync_line;
+	allow_sprite_terminator = src.mode_timing_.allow_sprite_terminator;
+	read_row = src.read_pointer_.row;
+	read_column = src.read_pointer_.column;
+	write_row = src.write_pointer_.row;
+	write_column = src.write_pointer_.column;
+
+	line_interrupt_target = src.line_interrupt_target;
+	line_interrupt_counter = src.line_interrupt_counter;
+	enable_line_interrupts = src.enable_line_interrupts_;
+	line_interrupt_pending = src.line_interrupt_pending_;
+
+	vertical_scroll_lock = src.master_system_.vertical_scroll_lock;
+	horizontal_scroll_lock = src.master_system_.horizontal_scroll_lock;
+	hide_left_column = src.master_system_.hide_left_column;
+	shift_sprites_8px_left = src.master_system_.shift_sprites_8px_left;
+	mode4_enable = src.master_system_.mode4_enable;
+	horizontal_scroll = src.master_system_.horizontal_scroll;
+	vertical_scroll = src.master_system_.vertical_scroll;
+	latched_vertical_scroll = src.master_system_.latched_vertical_scroll;
+	std::copy(std::begin(src.master_system_.colour_ram), std::end(src.master_system_.colour_ram), std::begin(colour_ram));
+	cram_is_selected = src.master_system_.cram_is_selected;
+	master_system_pattern_name_address = uint32_t(src.master_system_.pattern_name_address);
+	master_system_sprite_attribute_table_address = uint32_t(src.master_system_.sprite_attribute_table_address);
+	master_system_sprite_generator_table_address = uint32_t(src.master_system_.sprite_generator_table_address);
+}
+
+void State::apply(TMS9918 &target) const {
+	// Accept RAM only if it's of the expected size.
+	if(ram.size() == target.ram_.size()) {
+		target.ram_ = ram;
+	}
+
+	target.ram_pointer_ = ram_pointer;
+	target.read_ahead_buffer_ = read_ahead_buffer;
+	target.queued_access_ = Base::MemoryAccess(queued_access);
+	target.cycles_until_access_ = cycles_until_access;
+	target.minimum_access_column_ = minimum_access_column;
+
+	target.status_ = status;
+	target.write_phase_ = write_phase;
+	target.low_write_ = low_write;
+
+	target.mode1_enable_ = mode1_enable;
+	target.mode2_enable_ = mode2_enable;
+	target.mode3_enable_ = mode3_enable;
+	target.blank_display_ = blank_display;
+	target.sprites_16x16_ = sprites_16x16;
+	target.sprites_magnified_ = sprites_magnified;
+	target.generate_interrupts_ = generate_interrupts;
+	target.sprite_height_ = sprite_height;
+	target.pattern_name_address_ = pattern_name_address;
+	target.colour_table_address_ = colour_table_address;
+	target.pattern_generator_table_address_ = pattern_generator_table_address;
+	target.sprite_attribute_table_address_ = sprite_attribute_table_address;
+	target.sprite_generator_table_address_ = sprite_generator_table_address;
+	target.text_colour_ = text_colour;
+	target.background_colour_ = background_colour;
+
+	target.cycles_error_ = cycles_error;
+	target.latched_column_ = latched_column;
+	target.mode_timing_.pixel_lines = pixel_lines;
+	target.mode_timing_.first_vsync_line = first_vsync_line;
+	target.mode_timing_.allow_sprite_terminator = allow_sprite_terminator;
+	target.read_pointer_.row = read_row;
+	target.read_pointer_.column = read_column;
+	target.write_pointer_.row = write_row;
+	target.write_pointer_.column = write_column;
+
+	target.line_interrupt_target = line_interrupt_target;
+	target.line_interrupt_counter = line_interrupt_counter;
+	target.enable_line_interrupts_ = enable_line_interrupts;
+	target.line_interrupt_pending_ = line_interrupt_pending;
+
+	target.master_system_.vertical_scroll_lock = vertical_scroll_lock;
+	target.master_system_.horizontal_scroll_lock = horizontal_scroll_lock;
+	target.master_system_.hide_left_column = hide_left_column;
+	target.master_system_.shift_sprites_8px_left = shift_sprites_8px_left;
+	target.master_system_.mode4_enable = mode4_enable;
+	target.master_system_.horizontal_scroll = horizontal_scroll;
+	target.master_system_.vertical_scroll = vertical_scroll;
+	target.master_system_.latched_vertical_scroll = latched_vertical_scroll;
+	std::copy(std::begin(colour_ram), std::end(colour_ram), std::begin(target.master_system_.colour_ram));
+	target.master_system_.cram_is_selected = cram_is_selected;
+	target.master_system_.pattern_name_address = master_system_pattern_name_address;
+	target.master_system_.sprite_attribute_table_address = master_system_sprite_attribute_table_address;
+	target.master_system_.sprite_generator_table_address = master_system_sprite_generator_table_address;
+
+	target.upcoming_cram_dots_.clear();
+	target.set_current_screen_mode();
+}
@@ -12,9 +12,12 @@
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 
+#include "../../Reflection/Struct.hpp"
+
 #include "Implementation/9918Base.hpp"
 
 #include <cstdint>
+#include <vector>
 
 namespace TI {
 namespace TMS {
@@ -99,6 +102,79 @@ class TMS9918: public Base {
 		bool get_interrupt_line();
 };
 
+/*!
+	Provides a means for capturing or restoring TMS state: its RAM, all programmer-set
+	registers and the current raster position.
+
+	Line buffers, i.e. fetched-but-not-yet-output data, are not captured; the remainder
+	of the line in progress at restoration may therefore be output incorrectly.
+*/
+struct State: public Reflection::StructImpl<State> {
+	std::vector<uint8_t> ram;
+
+	// Memory access state.
+	uint16_t ram_pointer = 0;
+	uint8_t read_ahead_buffer = 0;
+	int queued_access = 0;
+	int cycles_until_access = 0;
+	int minimum_access_column = 0;
+
+	// Status and programmer input.
+	uint8_t status = 0;
+	bool write_phase = false;
+	uint8_t low_write = 0;
+
+	// Programmable flags and addresses.
+	bool mode1_enable = false, mode2_enable = false, mode3_enable = false;
+	bool blank_display = false;
+	bool sprites_16x16 = false, sprites_magnified = false;
+	bool generate_interrupts = false;
+	int sprite_height = 8;
+	uint32_t pattern_name_address = 0;
+	uint32_t colour_table_address = 0;
+	uint32_t pattern_generator_table_address = 0;
+	uint32_t sprite_attribute_table_address = 0;
+	uint32_t sprite_generator_table_address = 0;
+	uint8_t text_colour = 0, background_colour = 0;
+
+	// Position and timing.
+	int cycles_error = 0;
+	int latched_column = 0;
+	int pixel_lines = 192;
+	int first_vsync_line = 227;
+	bool allow_sprite_terminator = true;
+	int read_row = 0, read_column = 0;
+	int write_row = 0, write_column = 0;
+
+	// Line interrupts.
+	uint8_t line_interrupt_target = 0xff;
+	uint8_t line_interrupt_counter = 0;
+	bool enable_line_interrupts = false;
+	bool line_interrupt_pending = false;
+
+	// Master System extensions.
+	bool vertical_scroll_lock = false, horizontal_scroll_lock = false;
+	bool hide_left_column = false;
+	bool shift_sprites_8px_left = false;
+	bool mode4_enable = false;
+	uint8_t horizontal_scroll = 0, vertical_scroll = 0;
+	uint8_t latched_vertical_scroll = 0;
+	uint32_t colour_ram[32]{};
+	bool cram_is_selected = false;
+	uint32_t master_system_pattern_name_address = 0;
+	uint32_t master_system_sprite_attribute_table_address = 0;
+	uint32_t master_system_sprite_generator_table_address = 0;
+
+	/// Default constructor; makes no guarantees as to field values beyond those given above.
+	State();
+
+	/// Instantiates a new State based on the TMS @c src.
+	State(const TMS9918 &src);
+
+	/// Applies this state to @c target.
+	void apply(TMS9918 &target) const;
+};
+
 }
 }
 
@@ -38,6 +38,8 @@ enum class TVStandard {
 
 #define is_sega_vdp(x) ((x) >= SMSVDP)
 
+struct State;
+
 class Base {
 	public:
 		static const uint32_t palette_pack(uint8_t r, uint8_t g, uint8_t b) {
@@ -51,6 +53,8 @@ class Base {
 		}
 
 	protected:
+		friend struct State;
+
 		static constexpr int output_lag = 11;	// i.e. pixel output will occur 11 cycles after corresponding data read.
 
 		// The default TMS palette.
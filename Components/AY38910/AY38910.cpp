@@ -172,6 +172,60 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	master_divider_ &= 3;
 }
 
+namespace {
+
+/*!
+	Advances a counter that decrements once per tick and reloads with @c reload upon
+	reaching zero by @c ticks ticks.
+
+	@returns The number of reloads that occurred.
+*/
+std::size_t advance_counter(int &counter, int reload, std::size_t ticks) {
+	if(ticks <= std::size_t(counter)) {
+		counter -= int(ticks);
+		return 0;
+	}
+
+	ticks -= std::size_t(counter) + 1;
+	const std::size_t period = std::size_t(reload) + 1;
+	counter = reload - int(ticks % period);
+	return 1 + ticks / period;
+}
+
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::skip_samples(std::size_t number_of_samples) {
+	// Determine how many times the divide-by-four would have triggered an update.
+	const std::size_t ticks = ((std::size_t(master_divider_) + number_of_samples + 3) >> 2) - ((std::size_t(master_divider_) + 3) >> 2);
+	master_divider_ = int((std::size_t(master_divider_) + number_of_samples) & 3);
+	if(!ticks) return;
+
+	// Tone channels just toggle upon each reload.
+	for(int c = 0; c < 3; c++) {
+		tone_outputs_[c] ^= int(advance_counter(tone_counters_[c], tone_periods_[c] << 1, ticks) & 1);
+	}
+
+	// Noise needs to be stepped once per reload.
+	for(auto reloads = advance_counter(noise_counter_, noise_period_ << 1, ticks); reloads; --reloads) {
+		noise_output_ ^= noise_shift_register_&1;
+		noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
+		noise_shift_register_ >>= 1;
+	}
+
+	// The envelope advances once per reload, looping within the portion of its table
+	// beyond the overflow mask after it first reaches the end.
+	const auto envelope_steps = advance_counter(envelope_divider_, envelope_period_, ticks);
+	const std::size_t position = std::size_t(envelope_position_) + envelope_steps;
+	if(position < 64) {
+		envelope_position_ = int(position);
+	} else {
+		const int overflow = envelope_overflow_masks_[output_registers_[13]];
+		envelope_position_ = overflow + int((position - 64) % std::size_t(64 - overflow));
+	}
+
+	evaluate_output_volume();
+}
+
 template <bool is_stereo> void AY38910<is_stereo>::evaluate_output_volume() {
 	int envelope_volume = envelope_shapes_[output_registers_[13]][envelope_position_ | envelope_position_mask_];
 
@@ -11,6 +11,10 @@
 
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../Reflection/Struct.hpp"
+
+#include <algorithm>
+#include <iterator>
 
 namespace GI {
 namespace AY38910 {
@@ -52,6 +56,8 @@ enum ControlLines {
 	BDIR	= (1 << 2)
 };
 
+struct State;
+
 enum class Personality {
 	/// Provides 16 volume levels to envelopes.
 	AY38910,
@@ -107,6 +113,7 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 
 		// to satisfy ::Outputs::Speaker (included via ::Outputs::Filter.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		void skip_samples(std::size_t number_of_samples);
 		bool is_zero_level() const;
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return is_stereo; }
@@ -162,6 +169,41 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 		uint8_t a_left_ = 255, a_right_ = 255;
 		uint8_t b_left_ = 255, b_right_ = 255;
 		uint8_t c_left_ = 255, c_right_ = 255;
+
+		friend struct State;
+};
+
+/*!
+	Provides a means for capturing or restoring AY state.
+
+	Only programmer-visible register state is captured; the audio thread's tone, noise
+	and envelope counters are not, so restoration will pick up with those in a fresh state.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[16]{};
+	uint8_t selected_register = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(registers);
+			DeclareField(selected_register);
+		}
+	}
+
+	/// Instantiates a new State based on the AY @c src.
+	template <bool is_stereo> State(const AY38910<is_stereo> &src) : State() {
+		std::copy(std::begin(src.registers_), std::end(src.registers_), std::begin(registers));
+		selected_register = uint8_t(src.selected_register_);
+	}
+
+	/// Applies this state to @c target, posting all register values through the normal write path.
+	template <bool is_stereo> void apply(AY38910<is_stereo> &target) const {
+		for(uint8_t c = 0; c < 16; c++) {
+			target.select_register(c);
+			target.set_register_value(registers[c]);
+		}
+		target.select_register(selected_register);
+	}
 };
 
 
@@ -51,6 +51,36 @@ void SCC::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 }
 
+void SCC::skip_samples(std::size_t number_of_samples) {
+	// As per get_samples, nothing advances while all channels are disabled.
+	if(is_zero_level()) return;
+
+	// Channels are updated upon each sample for which the master divider is a multiple of eight;
+	// count those that fall within this skip.
+	const std::size_t phase = std::size_t(master_divider_ & 7);
+	const std::size_t lead_in = (8 - phase) & 7;
+	master_divider_ = int((phase + number_of_samples) & 7);
+	if(number_of_samples <= lead_in) return;
+	const std::size_t updates = (number_of_samples - lead_in + 7) / 8;
+
+	// Each channel advances its offset once whenever its tone counter is reloaded, i.e.
+	// once upon reaching zero and then once per (period + 1) further updates.
+	for(int channel = 0; channel < 5; ++channel) {
+		auto &target = channels_[channel];
+		if(updates <= std::size_t(target.tone_counter)) {
+			target.tone_counter -= int(updates);
+			continue;
+		}
+
+		const std::size_t cycle_length = std::size_t(target.period) + 1;
+		const std::size_t remaining = updates - std::size_t(target.tone_counter) - 1;
+		target.offset = int((std::size_t(target.offset) + 1 + remaining / cycle_length) & 0x1f);
+		target.tone_counter = target.period - int(remaining % cycle_length);
+	}
+
+	evaluate_output_volume();
+}
+
 void SCC::write(uint16_t address, uint8_t value) {
 	address &= 0xff;
 	if(address < 0x80) ram_[address] = value;
@@ -295,7 +295,38 @@ void OPLL::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 }
 
-void OPLL::update_all_channels() {
+void OPLL::skip_samples(std::size_t number_of_samples) {
+	const int update_period = 72 / audio_divider_;
+
+	// Determine how many channel updates would have occurred.
+	std::size_t updates =
+		(std::size_t(audio_offset_) + number_of_samples + std::size_t(update_period) - 1) / std::size_t(update_period) -
+		(audio_offset_ ? 1 : 0);
+	audio_offset_ = int((std::size_t(audio_offset_) + number_of_samples) % std::size_t(update_period));
+	if(!updates) return;
+
+	// For all but the final update, advance the generators and the melodic modulators, which
+	// are subject to feedback, but calculate no output. The final update is performed in full
+	// so that output levels are correct for whatever follows.
+	while(--updates) {
+		update_generators();
+
+		const int melodic_channels = rhythm_mode_enabled_ ? 6 : 9;
+		for(int c = 0; c < melodic_channels; ++c) {
+			update_modulator(c);
+		}
+
+		// Rhythm mode steps the LFSR once per slot.
+		if(rhythm_mode_enabled_) {
+			for(int c = 0; c < 6; ++c) {
+				oscillator_.update_lfsr();
+			}
+		}
+	}
+	update_all_channels();
+}
+
+void OPLL::update_generators() {
 	oscillator_.update();
 
 	// Update all phase generators. That's guaranteed.
@@ -309,14 +340,25 @@ void OPLL::update_all_channels() {
 		envelope_generators_[c + 9].update(oscillator_);
 	}
 
-#define VOLUME(x)	int16_t(((x) * total_volume_) >> 12)
-
 	if(rhythm_mode_enabled_) {
 		// Advance the rhythm envelope generators.
 		for(int c = 0; c < 6; ++c) {
 			rhythm_envelope_generators_[c].update(oscillator_);
 		}
+	} else {
+		for(int c = 6; c < 9; ++c) {
+			envelope_generators_[c + 0].update(oscillator_);
+			envelope_generators_[c + 9].update(oscillator_);
+		}
+	}
+}
 
+void OPLL::update_all_channels() {
+	update_generators();
+
+#define VOLUME(x)	int16_t(((x) * total_volume_) >> 12)
+
+	if(rhythm_mode_enabled_) {
 		// Fill in the melodic channels.
 		output_levels_[3] = VOLUME(melodic_output(0));
 		output_levels_[4] = VOLUME(melodic_output(1));
@@ -350,11 +392,6 @@ void OPLL::update_all_channels() {
 		output_levels_[8] = output_levels_[12] = 0;
 		oscillator_.update_lfsr();
 	} else {
-		for(int c = 6; c < 9; ++c) {
-			envelope_generators_[c + 0].update(oscillator_);
-			envelope_generators_[c + 9].update(oscillator_);
-		}
-
 		// All melodic. Fairly easy.
 		output_levels_[0] = output_levels_[1] = output_levels_[2] =
 		output_levels_[6] = output_levels_[7] = output_levels_[8] =
@@ -387,6 +424,11 @@ int OPLL::melodic_output(int channel) {
 	auto carrier = WaveformGenerator<period_precision>::wave(channels_[channel].carrier_waveform, phase_generators_[channel].scaled_phase(), channels_[channel].modulator_output);
 	carrier += envelope_generators_[channel].attenuation() + ATTENUATION(channels_[channel].attenuation) + key_level_scalers_[channel].attenuation();
 
+	update_modulator(channel);
+	return carrier.level();
+}
+
+void OPLL::update_modulator(int channel) {
 	// Get the modulator's new value.
 	auto modulation = WaveformGenerator<period_precision>::wave(channels_[channel].modulator_waveform, phase_generators_[channel + 9].phase());
 	modulation += envelope_generators_[channel + 9].attenuation() + (channels_[channel].modulator_attenuation << 5) + key_level_scalers_[channel + 9].attenuation();
@@ -394,8 +436,6 @@ int OPLL::melodic_output(int channel) {
 	// Apply feedback, if any.
 	phase_generators_[channel + 9].apply_feedback(channels_[channel].modulator_output, modulation, channels_[channel].modulator_feedback);
 	channels_[channel].modulator_output = modulation;
-
-	return carrier.level();
 }
 
 int OPLL::bass_drum() {
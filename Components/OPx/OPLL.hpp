@@ -28,6 +28,7 @@ class OPLL: public OPLBase<OPLL> {
 
 		/// As per ::SampleSource; provides audio output.
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
+		void skip_samples(std::size_t number_of_samples);
 		void set_sample_volume_range(std::int16_t range);
 
 		// The OPLL is generally 'half' as loud as it's told to be. This won't strictly be true in
@@ -47,8 +48,10 @@ class OPLL: public OPLBase<OPLL> {
 
 		int16_t output_levels_[18];
 		void update_all_channels();
+		void update_generators();
 
 		int melodic_output(int channel);
+		void update_modulator(int channel);
 		int bass_drum();
 		int tom_tom();
 		int snare_drum();
@@ -8,6 +8,7 @@
 
 #include "SN76489.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -99,6 +100,22 @@ void SN76489::evaluate_output_volume() {
 	);
 }
 
+inline void SN76489::step_noise() {
+	channels_[3].level = noise_shifter_ & 1;
+	int new_bit = channels_[3].level;
+	switch(noise_mode_) {
+		default: break;
+		case Noise15:
+			new_bit ^= (noise_shifter_ >> 1);
+		break;
+		case Noise16:
+			new_bit ^= (noise_shifter_ >> 3);
+		break;
+	}
+	noise_shifter_ >>= 1;
+	noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
+}
+
 void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	std::size_t c = 0;
 	while((master_divider_& (master_divider_period_ - 1)) && c < number_of_samples) {
@@ -132,21 +149,7 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 			}
 		}
 
-		if(did_flip) {
-			channels_[3].level = noise_shifter_ & 1;
-			int new_bit = channels_[3].level;
-			switch(noise_mode_) {
-				default: break;
-				case Noise15:
-					new_bit ^= (noise_shifter_ >> 1);
-				break;
-				case Noise16:
-					new_bit ^= (noise_shifter_ >> 3);
-				break;
-			}
-			noise_shifter_ >>= 1;
-			noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
-		}
+		if(did_flip) step_noise();
 
 		evaluate_output_volume();
 
@@ -159,3 +162,63 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 
 	master_divider_ &= (master_divider_period_ - 1);
 }
+
+void SN76489::skip_samples(std::size_t number_of_samples) {
+	// Determine how many times the master divider would have triggered an update.
+	const std::size_t period = std::size_t(master_divider_period_);
+	const std::size_t ticks =
+		(std::size_t(master_divider_) + number_of_samples + period - 1) / period -
+		(std::size_t(master_divider_) + period - 1) / period;
+	master_divider_ = int((std::size_t(master_divider_) + number_of_samples) & (period - 1));
+
+	// Channels 0 and 1 affect nothing but their own levels, so can be advanced arithmetically.
+	for(int c = 0; c < 2; ++c) {
+		auto &channel = channels_[c];
+		if(ticks <= channel.counter) {
+			channel.counter -= ticks;
+			continue;
+		}
+
+		const std::size_t remaining = ticks - channel.counter - 1;
+		const std::size_t reload_period = std::size_t(channel.divider) + 1;
+		channel.level ^= int((1 + remaining / reload_period) & 1);
+		channel.counter = uint16_t(channel.divider - remaining % reload_period);
+	}
+
+	// Channel 2 and the noise channel's own counter both clock the noise generator, so jump from
+	// one reload of either to the next.
+	const bool noise_has_counter = channels_[3].divider != 0xffff;
+	std::size_t remaining = ticks;
+	while(remaining) {
+		std::size_t next_reload = channels_[2].counter;
+		if(noise_has_counter) next_reload = std::min(next_reload, std::size_t(channels_[3].counter));
+
+		if(next_reload >= remaining) {
+			channels_[2].counter -= remaining;
+			if(noise_has_counter) channels_[3].counter -= remaining;
+			break;
+		}
+
+		channels_[2].counter -= next_reload;
+		if(noise_has_counter) channels_[3].counter -= next_reload;
+		remaining -= next_reload + 1;
+
+		bool did_flip = false;
+		if(channels_[2].counter) channels_[2].counter--;
+		else {
+			channels_[2].level ^= 1;
+			channels_[2].counter = channels_[2].divider;
+			did_flip = true;
+		}
+		if(noise_has_counter) {
+			if(channels_[3].counter) channels_[3].counter--;
+			else {
+				channels_[3].counter = channels_[3].divider;
+				did_flip = true;
+			}
+		}
+		if(did_flip) step_noise();
+	}
+
+	evaluate_output_volume();
+}
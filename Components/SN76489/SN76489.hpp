@@ -30,6 +30,7 @@ class SN76489: public Outputs::Speaker::SampleSource {
 
 		// As per SampleSource.
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
+		void skip_samples(std::size_t number_of_samples);
 		bool is_zero_level() const;
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
@@ -60,6 +61,7 @@ class SN76489: public Outputs::Speaker::SampleSource {
 		} noise_mode_ = Periodic15;
 		uint16_t noise_shifter_ = 0;
 		int active_register_ = 0;
+		void step_noise();
 
 		bool shifter_is_16bit_ = false;
 };
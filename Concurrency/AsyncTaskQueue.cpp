@@ -8,38 +8,177 @@
 
 #include "AsyncTaskQueue.hpp"
 
+#ifndef __APPLE__
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <vector>
+#endif
+
 using namespace Concurrency;
 
+#ifndef __APPLE__
+namespace Concurrency {
+
+/*!
+	The set of worker threads shared by all AsyncTaskQueues.
+
+	Each worker keeps a deque of queues that have work outstanding. It takes from the front of its own
+	and, when that is empty, steals from the back of the others'. A queue is in at most one deque at a
+	time, and is drained by at most one worker at a time, which is what keeps its functions serial.
+*/
+class TaskPool {
+	public:
+		static TaskPool &shared() {
+			// This is deliberately never destroyed, so that queues with static storage duration
+			// can still be flushed during exit.
+			static TaskPool *const pool = new TaskPool();
+			return *pool;
+		}
+
+		/// Adds @c queue, which has just acquired work, to the pool.
+		void schedule(AsyncTaskQueue *queue) {
+			// Prefer the calling worker's own deque, if the caller is a worker.
+			Worker &worker = (current_worker_ >= 0) ?
+				workers_[size_t(current_worker_)] :
+				workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+			{
+				std::lock_guard<std::mutex> lock(worker.mutex);
+				worker.queues.push_back(queue);
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				++available_;
+			}
+			condition_.notify_one();
+		}
+
+		/// Sets @c flag and wakes anybody waiting for it via @c wait_for.
+		void signal(std::atomic<bool> &flag) {
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				flag = true;
+			}
+			flush_condition_.notify_all();
+			condition_.notify_all();
+		}
+
+		/// Blocks until @c flag is set by @c signal.
+		void wait_for(std::atomic<bool> &flag) {
+			std::unique_lock<std::mutex> lock(mutex_);
+
+			if(current_worker_ < 0) {
+				flush_condition_.wait(lock, [&flag] { return flag.load(); });
+				return;
+			}
+
+			// A worker can't just block, as it might be the only one available to do whatever
+			// is being waited for. So it helps out instead.
+			while(true) {
+				condition_.wait(lock, [this, &flag] { return available_ > 0 || flag; });
+				if(flag) return;
+
+				--available_;
+				lock.unlock();
+				perform(take());
+				lock.lock();
+			}
+		}
+
+	private:
+		// The maximum number of functions to perform from one queue before giving others a turn.
+		static constexpr size_t BatchSize = 32;
+
+		struct Worker {
+			std::mutex mutex;
+			std::deque<AsyncTaskQueue *> queues;
+		};
+		std::vector<Worker> workers_;
+		std::vector<std::thread> threads_;
+		std::atomic<size_t> next_worker_;
+
+		// available_ counts entries across all deques that no worker has yet claimed.
+		std::mutex mutex_;
+		std::condition_variable condition_, flush_condition_;
+		std::atomic<size_t> available_;
+
+		static thread_local int current_worker_;
+
+		TaskPool() :
+			workers_(std::max(2u, std::thread::hardware_concurrency())),
+			next_worker_(0),
+			available_(0) {
+			for(size_t c = 0; c < workers_.size(); ++c) {
+				threads_.emplace_back([this, c] {
+					current_worker_ = int(c);
+
+					while(true) {
+						{
+							std::unique_lock<std::mutex> lock(mutex_);
+							condition_.wait(lock, [this] { return available_ > 0; });
+							--available_;
+						}
+						perform(take());
+					}
+				});
+			}
+		}
+
+		/// Removes and returns a queue from any deque; the caller must already have claimed one via @c available_.
+		AsyncTaskQueue *take() {
+			const size_t own = current_worker_ >= 0 ? size_t(current_worker_) : 0;
+			while(true) {
+				for(size_t c = 0; c < workers_.size(); ++c) {
+					const size_t index = (own + c) % workers_.size();
+					Worker &worker = workers_[index];
+
+					std::lock_guard<std::mutex> lock(worker.mutex);
+					if(worker.queues.empty()) continue;
+
+					AsyncTaskQueue *queue;
+					if(index == own) {
+						queue = worker.queues.front();
+						worker.queues.pop_front();
+					} else {
+						queue = worker.queues.back();
+						worker.queues.pop_back();
+					}
+					return queue;
+				}
+
+				// Another worker may be between claiming and taking an entry, in which case
+				// this one's entry is in flight; it'll be visible momentarily.
+				std::this_thread::yield();
+			}
+		}
+
+		void perform(AsyncTaskQueue *queue) {
+			while(queue->perform_tasks(BatchSize)) {
+				// Give other queues a turn if any are waiting; otherwise keep going.
+				if(available_.load(std::memory_order_relaxed)) {
+					schedule(queue);
+					return;
+				}
+			}
+		}
+};
+
+thread_local int TaskPool::current_worker_ = -1;
+
+}
+#endif
+
 AsyncTaskQueue::AsyncTaskQueue()
 #ifndef __APPLE__
-	: should_destruct_(false)
+	: ring_(new Slot[RingSize]), enqueue_position_(0), pending_(0), overflow_size_(0)
 #endif
 {
 #ifdef __APPLE__
 	serial_dispatch_queue_ = dispatch_queue_create("com.thomasharte.clocksignal.asyntaskqueue", DISPATCH_QUEUE_SERIAL);
 #else
-	thread_ = std::make_unique<std::thread>([this]() {
-		while(!should_destruct_) {
-			std::function<void(void)> next_function;
-
-			// Take lock, check for a new task
-			std::unique_lock<std::mutex> lock(queue_mutex_);
-			if(!pending_tasks_.empty()) {
-				next_function = pending_tasks_.front();
-				pending_tasks_.pop_front();
-			}
-
-			if(next_function) {
-				// If there is a task, release lock and perform it
-				lock.unlock();
-				next_function();
-			} else {
-				// If there isn't a task, atomically block on the processing condition and release the lock
-				// until there's something pending (and then release it again via scope)
-				processing_condition_.wait(lock);
-			}
-		}
-	});
+	for(size_t c = 0; c < RingSize; ++c) {
+		ring_[c].sequence = c;
+	}
 #endif
 }
 
@@ -49,35 +188,106 @@ AsyncTaskQueue::~AsyncTaskQueue() {
 	dispatch_release(serial_dispatch_queue_);
 	serial_dispatch_queue_ = nullptr;
 #else
-	should_destruct_ = true;
-	enqueue([](){});
-	thread_->join();
-	thread_.reset();
+	flush();
+
+	// The worker that performed the flush may not yet have let go of this queue;
+	// it is done with it once nothing is pending.
+	while(pending_.load(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
 #endif
 }
 
-void AsyncTaskQueue::enqueue(std::function<void(void)> function) {
-#ifdef __APPLE__
-	dispatch_async(serial_dispatch_queue_, ^{function();});
-#else
-	std::lock_guard<std::mutex> lock(queue_mutex_);
-	pending_tasks_.push_back(function);
-	processing_condition_.notify_all();
-#endif
+#ifndef __APPLE__
+AsyncTaskQueue::Slot *AsyncTaskQueue::acquire_slot() {
+	if(overflow_size_.load(std::memory_order_relaxed)) {
+		return nullptr;
+	}
+
+	size_t position = enqueue_position_.load(std::memory_order_relaxed);
+	while(true) {
+		Slot &slot = ring_[position & (RingSize - 1)];
+		const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+		if(sequence == position) {
+			// The slot is free; try to claim it.
+			if(enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				return &slot;
+			}
+		} else if(sequence < position) {
+			// The ring is full. Waiting for it to drain could be waiting forever, e.g. if this is
+			// a function being performed by this queue, so use the overflow instead.
+			return nullptr;
+		} else {
+			// Another producer got here first.
+			position = enqueue_position_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+void AsyncTaskQueue::publish_slot(Slot &slot) {
+	slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	did_enqueue();
+}
+
+void AsyncTaskQueue::did_enqueue() {
+	if(!pending_.fetch_add(1, std::memory_order_acq_rel)) {
+		TaskPool::shared().schedule(this);
+	}
+}
+
+bool AsyncTaskQueue::perform_tasks(size_t limit) {
+	while(true) {
+		// Anything claimed in the ring precedes anything in the overflow, since the overflow is
+		// used only once the ring is full. Check under the overflow lock so that any ring claim
+		// made before the most recent addition to the overflow is visible.
+		std::list<Task> overflow_task;
+		if(enqueue_position_.load(std::memory_order_acquire) == dequeue_position_) {
+			std::lock_guard<std::mutex> lock(overflow_mutex_);
+			if(enqueue_position_.load(std::memory_order_acquire) == dequeue_position_) {
+				overflow_task.splice(overflow_task.begin(), overflow_, overflow_.begin());
+				overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		if(!overflow_task.empty()) {
+			overflow_task.front()();
+			overflow_task.clear();
+		} else {
+			Slot &slot = ring_[dequeue_position_ & (RingSize - 1)];
+
+			// If anything is pending then this slot has been claimed, but its producer
+			// might not yet have finished filling it in.
+			while(slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+				std::this_thread::yield();
+			}
+
+			slot.task();
+			slot.task.reset();
+			slot.sequence.store(dequeue_position_ + RingSize, std::memory_order_release);
+			++dequeue_position_;
+		}
+
+		// Once nothing is pending, the queue may be enqueued upon anew, or destroyed; don't touch it.
+		if(pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			return false;
+		}
+		if(!--limit) {
+			return true;
+		}
+	}
 }
+#endif
 
 void AsyncTaskQueue::flush() {
 #ifdef __APPLE__
 	dispatch_sync(serial_dispatch_queue_, ^{});
 #else
-	auto flush_mutex = std::make_shared<std::mutex>();
-	auto flush_condition = std::make_shared<std::condition_variable>();
-	std::unique_lock<std::mutex> lock(*flush_mutex);
-	enqueue([=] () {
-		std::unique_lock<std::mutex> inner_lock(*flush_mutex);
-		flush_condition->notify_all();
+	std::atomic<bool> flushed(false);
+	enqueue([&flushed] {
+		TaskPool::shared().signal(flushed);
 	});
-	flush_condition->wait(lock);
+	TaskPool::shared().wait_for(flushed);
 #endif
 }
 
@@ -86,20 +296,50 @@ DeferringAsyncTaskQueue::~DeferringAsyncTaskQueue() {
 	flush();
 }
 
-void DeferringAsyncTaskQueue::defer(std::function<void(void)> function) {
-	if(!deferred_tasks_) {
-		deferred_tasks_ = std::make_shared<std::list<std::function<void(void)>>>();
+void *DeferringAsyncTaskQueue::allocate_record(size_t size, void (*perform)(void *)) {
+	if(!deferred_) {
+		deferred_ = take_spare();
 	}
-	deferred_tasks_->push_back(function);
+
+	const size_t length = RecordLength + (size + sizeof(Unit) - 1) / sizeof(Unit);
+	const size_t offset = deferred_->size();
+	deferred_->resize(offset + length);
+
+	new (&(*deferred_)[offset]) Record{perform, length};
+	return &(*deferred_)[offset + RecordLength];
+}
+
+std::unique_ptr<DeferringAsyncTaskQueue::Buffer> DeferringAsyncTaskQueue::take_spare() {
+	std::lock_guard<std::mutex> lock(spares_mutex_);
+	if(spares_.empty()) {
+		return std::make_unique<Buffer>();
+	}
+
+	auto buffer = std::move(spares_.back());
+	spares_.pop_back();
+	return buffer;
+}
+
+void DeferringAsyncTaskQueue::return_spare(std::unique_ptr<Buffer> buffer) {
+	buffer->clear();
+
+	std::lock_guard<std::mutex> lock(spares_mutex_);
+	spares_.push_back(std::move(buffer));
 }
 
 void DeferringAsyncTaskQueue::perform() {
-	if(!deferred_tasks_) return;
-	std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks = deferred_tasks_;
-	deferred_tasks_.reset();
-	enqueue([deferred_tasks] {
-		for(const auto &function : *deferred_tasks) {
-			function();
+	if(!deferred_ || deferred_->empty()) return;
+
+	// Ownership of the buffer passes to the enqueued function, which returns it to
+	// the spares once done.
+	Buffer *const deferred = deferred_.release();
+	enqueue([this, deferred] {
+		size_t offset = 0;
+		while(offset < deferred->size()) {
+			const Record *const record = reinterpret_cast<const Record *>(&(*deferred)[offset]);
+			record->perform(&(*deferred)[offset + RecordLength]);
+			offset += record->length;
 		}
+		return_spare(std::unique_ptr<Buffer>(deferred));
 	});
 }
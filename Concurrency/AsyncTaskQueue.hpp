@@ -11,10 +11,17 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #ifdef __APPLE__
 #include <dispatch/dispatch.h>
@@ -26,6 +33,12 @@ namespace Concurrency {
 	An async task queue allows a caller to enqueue void(void) functions. Those functions are guaranteed
 	to be performed serially and asynchronously from the caller. A caller may also request to flush,
 	causing it to block until all previously-enqueued functions are complete.
+
+	On Apple platforms each queue is a serial dispatch queue. Elsewhere queues don't own threads;
+	all queues share a pool of worker threads, which take turns draining whichever queues have work.
+	Submission is via a lock-free ring per queue, with functions stored inline in the ring where
+	they fit, so enqueuing doesn't ordinarily allocate. If the ring is full then functions overflow
+	into a list, which does allocate, so that enqueuing never blocks.
 */
 class AsyncTaskQueue {
 	public:
@@ -36,10 +49,32 @@ class AsyncTaskQueue {
 			Adds @c function to the queue.
 
 			@discussion Functions will be performed serially and asynchronously. This method is safe to
-			call from multiple threads.
+			call from multiple threads, including from within a function performed by this or any other
+			queue, and never blocks. Other than on Apple platforms, up to 256 functions awaiting performance
+			are held without allocation; beyond that each costs an allocation until the backlog clears.
 			@parameter function The function to enqueue.
 		*/
-		void enqueue(std::function<void(void)> function);
+		template <typename FunctionT> void enqueue(FunctionT &&function) {
+#ifdef __APPLE__
+			const std::function<void(void)> task = std::forward<FunctionT>(function);
+			dispatch_async(serial_dispatch_queue_, ^{task();});
+#else
+			Slot *const slot = acquire_slot();
+			if(slot) {
+				slot->task.emplace(std::forward<FunctionT>(function));
+				publish_slot(*slot);
+				return;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(overflow_mutex_);
+				overflow_.emplace_back();
+				overflow_.back().emplace(std::forward<FunctionT>(function));
+				overflow_size_.fetch_add(1, std::memory_order_relaxed);
+			}
+			did_enqueue();
+#endif
+		}
 
 		/*!
 			Blocks the caller until all previously-enqueud functions have completed.
@@ -50,12 +85,83 @@ class AsyncTaskQueue {
 #ifdef __APPLE__
 		dispatch_queue_t serial_dispatch_queue_;
 #else
-		std::unique_ptr<std::thread> thread_;
+		/*!
+			A type-erased void(void) callable; anything up to @c InlineSize bytes is stored
+			in place, anything larger is moved to the heap.
+		*/
+		class Task {
+			public:
+				static constexpr size_t InlineSize = 64;
+
+				Task() = default;
+				Task(const Task &) = delete;
+				Task &operator =(const Task &) = delete;
+				~Task() {
+					reset();
+				}
+
+				template <typename FunctionT> void emplace(FunctionT &&function) {
+					using Function = typename std::decay<FunctionT>::type;
+
+					if constexpr (sizeof(Function) <= InlineSize && alignof(Function) <= alignof(std::max_align_t)) {
+						new (storage_) Function(std::forward<FunctionT>(function));
+						perform_ = [] (void *storage) { (*static_cast<Function *>(storage))(); };
+						destroy_ = [] (void *storage) { static_cast<Function *>(storage)->~Function(); };
+					} else {
+						*reinterpret_cast<Function **>(storage_) = new Function(std::forward<FunctionT>(function));
+						perform_ = [] (void *storage) { (**static_cast<Function **>(storage))(); };
+						destroy_ = [] (void *storage) { delete *static_cast<Function **>(storage); };
+					}
+				}
+
+				void operator()() {
+					perform_(storage_);
+				}
+
+				void reset() {
+					if(destroy_) {
+						destroy_(storage_);
+						destroy_ = nullptr;
+					}
+				}
+
+			private:
+				alignas(std::max_align_t) uint8_t storage_[InlineSize];
+				void (*perform_)(void *) = nullptr;
+				void (*destroy_)(void *) = nullptr;
+		};
 
-		std::mutex queue_mutex_;
-		std::list<std::function<void(void)>> pending_tasks_;
-		std::condition_variable processing_condition_;
-		std::atomic_bool should_destruct_;
+		/*!
+			A single entry in the submission ring. @c sequence is the position at which this slot may next
+			be claimed by a producer if equal to it, or consumed if equal to one more than it.
+		*/
+		struct Slot {
+			std::atomic<size_t> sequence;
+			Task task;
+		};
+		static constexpr size_t RingSize = 256;
+		std::unique_ptr<Slot[]> ring_;
+		std::atomic<size_t> enqueue_position_;
+		size_t dequeue_position_ = 0;
+
+		// The number of functions enqueued but not yet completed; whoever moves this from 0 to 1
+		// hands the queue to the pool, and whoever moves it from 1 to 0 takes it back.
+		std::atomic<size_t> pending_;
+
+		// Functions that arrived while the ring was full, in order. While anything is here, all further
+		// functions join it, so that nothing overtakes it via the ring.
+		std::mutex overflow_mutex_;
+		std::list<Task> overflow_;
+		std::atomic<size_t> overflow_size_;
+
+		/// @returns A slot in the ring, or @c nullptr if the ring is full or the overflow is in use.
+		Slot *acquire_slot();
+		void publish_slot(Slot &slot);
+		void did_enqueue();
+
+		/// Performs up to @c limit functions; @returns @c true if more remain.
+		bool perform_tasks(size_t limit);
+		friend class TaskPool;
 #endif
 };
 
@@ -66,6 +172,9 @@ class AsyncTaskQueue {
 
 	It therefore offers similar semantics to an asynchronous task queue, but allows for management of
 	synchronisation costs, since neither defer nor perform make any effort to be thread safe.
+
+	Deferred functions are stored by value, back to back, in a buffer that is handed over wholesale
+	by perform and recycled once performed; deferral therefore doesn't ordinarily allocate.
 */
 class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 	public:
@@ -76,7 +185,27 @@ class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 
 			This is not thread safe; it should be serialised with other calls to itself and to perform.
 		*/
-		void defer(std::function<void(void)> function);
+		template <typename FunctionT> void defer(FunctionT &&function) {
+			using Function = typename std::decay<FunctionT>::type;
+
+			if constexpr (
+				std::is_trivially_copyable<Function>::value &&
+				std::is_trivially_destructible<Function>::value &&
+				alignof(Function) <= alignof(Unit)
+			) {
+				void *const storage = allocate_record(sizeof(Function), [] (void *storage) {
+					(*static_cast<Function *>(storage))();
+				});
+				new (storage) Function(std::forward<FunctionT>(function));
+			} else {
+				// Anything that can't just be copied about as bytes is boxed.
+				Function *const boxed = new Function(std::forward<FunctionT>(function));
+				defer([boxed] {
+					(*boxed)();
+					delete boxed;
+				});
+			}
+		}
 
 		/*!
 			Enqueues a function that will perform all currently deferred functions, in the
@@ -87,9 +216,25 @@ class DeferringAsyncTaskQueue: public AsyncTaskQueue {
 		void perform();
 
 	private:
-		// TODO: this is a shared_ptr because of the issues capturing moveables in C++11;
-		// switch to a unique_ptr if/when adapting to C++14
-		std::shared_ptr<std::list<std::function<void(void)>>> deferred_tasks_;
+		using Unit = std::max_align_t;
+		using Buffer = std::vector<Unit>;
+
+		/// Precedes each deferred function in a buffer; @c length is the total size of both, in Units.
+		struct Record {
+			void (*perform)(void *);
+			size_t length;
+		};
+		static constexpr size_t RecordLength = (sizeof(Record) + sizeof(Unit) - 1) / sizeof(Unit);
+
+		std::unique_ptr<Buffer> deferred_;
+
+		// Buffers that have been performed, retained for reuse.
+		std::mutex spares_mutex_;
+		std::vector<std::unique_ptr<Buffer>> spares_;
+
+		void *allocate_record(size_t size, void (*perform)(void *));
+		std::unique_ptr<Buffer> take_spare();
+		void return_spare(std::unique_ptr<Buffer> buffer);
 };
 
 }
@@ -11,6 +11,7 @@
 #include "Keyboard.hpp"
 
 #include "../../Processors/Z80/Z80.hpp"
+#include "../../Processors/Z80/State/State.hpp"
 
 #include "../../Components/6845/CRTC6845.hpp"
 #include "../../Components/8255/i8255.hpp"
@@ -31,12 +32,16 @@
 
 #include "../../Analyser/Static/AmstradCPC/Target.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <iterator>
 #include <vector>
 
 namespace AmstradCPC {
 
+struct State;
+
 /*!
 	Models the CPC's interrupt timer. Inputs are vsync, hsync, interrupt acknowledge and reset, and its output
 	is simply yes or no on whether an interupt is currently requested. Internally it uses a counter with a period
@@ -106,6 +111,8 @@ class InterruptTimer {
 		bool interrupt_request_ = false;
 		bool last_interrupt_request_ = false;
 		int timer_ = 0;
+
+		friend struct State;
 };
 
 /*!
@@ -152,6 +159,11 @@ class AYDeferrer {
 			return ay_;
 		}
 
+		/// @returns the AY itself.
+		const GI::AY38910::AY38910<true> &ay() const {
+			return ay_;
+		}
+
 	private:
 		Concurrency::DeferringAsyncTaskQueue audio_queue_;
 		GI::AY38910::AY38910<true> ay_;
@@ -222,6 +234,7 @@ class CRTCBusHandler {
 						case OutputMode::Border:		output_border(cycles_);							break;
 						case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
 						case OutputMode::Pixels:
+							convert_collected_bytes();
 							crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
 							pixel_pointer_ = pixel_data_ = nullptr;
 						break;
@@ -239,6 +252,7 @@ class CRTCBusHandler {
 			if(previous_output_mode_ == OutputMode::Pixels) {
 				if(!pixel_data_) {
 					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
+					set_collection_limit();
 				}
 				if(pixel_pointer_) {
 					// the CPC shuffles output lines as:
@@ -251,40 +265,18 @@ class CRTCBusHandler {
 							((state.refresh_address & 0x3000) << 2)
 						);
 
-					// Fetch two bytes and translate into pixels. Guaranteed: the mode can change only at
-					// hsync, so there's no risk of pixel_pointer_ overrunning 320 output pixels without
-					// exactly reaching 320 output pixels.
-					switch(mode_) {
-						case 0:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode0_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode0_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-						case 1:
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[0] = mode1_output_[ram_[address]];
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[1] = mode1_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint32_t);
-						break;
-
-						case 2:
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[0] = mode2_output_[ram_[address]];
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[1] = mode2_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint64_t);
-						break;
-
-						case 3:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode3_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode3_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-					}
+					// Fetch two bytes now, as the CPU may modify RAM before the end of the line,
+					// but defer their translation into pixels until the buffer is full or the
+					// lookup tables are about to change.
+					collected_bytes_[collected_count_] = ram_[address];
+					collected_bytes_[collected_count_ + 1] = ram_[address + 1];
+					collected_count_ += 2;
 
 					// Flush the current buffer pixel if full; the CRTC allows many different display
 					// widths so it's not necessarily possible to predict the correct number in advance
 					// and using the upper bound could lead to inefficient behaviour.
-					if(pixel_pointer_ == pixel_data_ + 320) {
+					if(collected_count_ >= collection_limit_) {
+						convert_collected_bytes();
 						crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
 						pixel_pointer_ = pixel_data_ = nullptr;
 						cycles_ = 0;
@@ -309,14 +301,7 @@ class CRTCBusHandler {
 			// Check for a trailing CRTC hsync; if one occurred then that's the trigger potentially to change modes.
 			if(!was_hsync_ && state.hsync) {
 				if(mode_ != next_mode_) {
-					mode_ = next_mode_;
-					switch(mode_) {
-						default:
-						case 0:		pixel_divider_ = 4;	break;
-						case 1:		pixel_divider_ = 2;	break;
-						case 2:		pixel_divider_ = 1;	break;
-					}
-					build_mode_table();
+					set_mode(next_mode_);
 				}
 			}
 
@@ -374,12 +359,91 @@ class CRTCBusHandler {
 				}
 				border_ = mapped_palette_value(colour);
 			} else {
+				convert_collected_bytes();
 				palette_[pen_] = mapped_palette_value(colour);
 				patch_mode_table(size_t(pen_));
 			}
 		}
 
 	private:
+		/*!
+			Switches immediately to @c mode and rebuilds the lookup tables. Any pixel run in progress is
+			first completed in the old mode, so that every run is in a single mode and the collection
+			limit always fits the buffer.
+		*/
+		void set_mode(int mode) {
+			if(pixel_pointer_) {
+				convert_collected_bytes();
+				crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+				pixel_pointer_ = pixel_data_ = nullptr;
+				cycles_ = 0;
+			}
+
+			mode_ = mode;
+			switch(mode_) {
+				default:
+				case 0:		pixel_divider_ = 4;	break;
+				case 1:		pixel_divider_ = 2;	break;
+				case 2:		pixel_divider_ = 1;	break;
+			}
+			build_mode_table();
+		}
+
+		/// @returns The number of pixels produced by each byte of RAM in the current mode.
+		int pixels_per_byte() const {
+			switch(mode_) {
+				default:
+				case 0:	return 2;
+				case 1:	return 4;
+				case 2:	return 8;
+				case 3:	return 2;
+			}
+		}
+
+		/// Sets the number of bytes that can be collected before the current pixel buffer is full.
+		void set_collection_limit() {
+			if(!pixel_pointer_) return;
+			collection_limit_ = size_t(pixel_data_ + 320 - pixel_pointer_) / size_t(pixels_per_byte());
+		}
+
+		/*!
+			Translates all bytes collected since the last call into pixels, in a single pass per mode,
+			using the current lookup tables. This must be called before any change to those tables.
+		*/
+		void convert_collected_bytes() {
+			if(!collected_count_) return;
+
+			const size_t count = collected_count_;
+			switch(mode_) {
+				case 0: {
+					uint16_t *const target = reinterpret_cast<uint16_t *>(pixel_pointer_);
+					for(size_t c = 0; c < count; c++) target[c] = mode0_output_[collected_bytes_[c]];
+					pixel_pointer_ += count * sizeof(uint16_t);
+				} break;
+
+				case 1: {
+					uint32_t *const target = reinterpret_cast<uint32_t *>(pixel_pointer_);
+					for(size_t c = 0; c < count; c++) target[c] = mode1_output_[collected_bytes_[c]];
+					pixel_pointer_ += count * sizeof(uint32_t);
+				} break;
+
+				case 2: {
+					uint64_t *const target = reinterpret_cast<uint64_t *>(pixel_pointer_);
+					for(size_t c = 0; c < count; c++) target[c] = mode2_output_[collected_bytes_[c]];
+					pixel_pointer_ += count * sizeof(uint64_t);
+				} break;
+
+				case 3: {
+					uint16_t *const target = reinterpret_cast<uint16_t *>(pixel_pointer_);
+					for(size_t c = 0; c < count; c++) target[c] = mode3_output_[collected_bytes_[c]];
+					pixel_pointer_ += count * sizeof(uint16_t);
+				} break;
+			}
+
+			collected_count_ = 0;
+			set_collection_limit();
+		}
+
 		void output_border(int length) {
 			assert(length >= 0);
 
@@ -562,6 +626,11 @@ class CRTCBusHandler {
 		Outputs::CRT::CRT crt_;
 		uint8_t *pixel_data_ = nullptr, *pixel_pointer_ = nullptr;
 
+		// Bytes fetched for output but not yet translated into pixels; at most 320 pixels' worth, i.e.
+		// 160 bytes in modes 0 and 3.
+		uint8_t collected_bytes_[160];
+		size_t collected_count_ = 0, collection_limit_ = 0;
+
 		const uint8_t *const ram_ = nullptr;
 
 		int next_mode_ = 2, mode_ = 2;
@@ -581,6 +650,8 @@ class CRTCBusHandler {
 		uint8_t border_ = 0;
 
 		InterruptTimer &interrupt_timer_;
+
+		friend struct State;
 };
 
 /*!
@@ -775,6 +846,78 @@ class i8255PortHandler : public Intel::i8255::PortHandler {
 		Storage::Tape::BinaryTapePlayer &tape_player_;
 };
 
+template <bool has_fdc> class ConcreteMachine;
+
+/*!
+	Captures CPC CPU, chip, gate array, paging and RAM state; FDC and tape state
+	is not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	Motorola::CRTC::State crtc;
+	Intel::i8255::State ppi;
+	GI::AY38910::State ay;
+
+	std::vector<uint8_t> ram;
+
+	// Gate array.
+	int pen = 0;
+	uint8_t palette[16]{};
+	uint8_t border = 0;
+	int mode = 2;
+	int next_mode = 2;
+	bool was_hsync = false;
+	bool was_vsync = false;
+
+	// Interrupt timer.
+	int interrupt_reset_counter = 0;
+	bool interrupt_request = false;
+	bool last_interrupt_request = false;
+	int interrupt_timer = 0;
+
+	// Paging.
+	uint8_t ram_configuration = 0;
+	bool lower_rom_is_paged = true;
+	bool upper_rom_is_paged = true;
+	int upper_rom = 0;
+
+	int clock_offset = 0;
+	int crtc_counter = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(crtc);
+			DeclareField(ppi);
+			DeclareField(ay);
+			DeclareField(ram);
+			DeclareField(pen);
+			DeclareField(palette);
+			DeclareField(border);
+			DeclareField(mode);
+			DeclareField(next_mode);
+			DeclareField(was_hsync);
+			DeclareField(was_vsync);
+			DeclareField(interrupt_reset_counter);
+			DeclareField(interrupt_request);
+			DeclareField(last_interrupt_request);
+			DeclareField(interrupt_timer);
+			DeclareField(ram_configuration);
+			DeclareField(lower_rom_is_paged);
+			DeclareField(upper_rom_is_paged);
+			DeclareField(upper_rom);
+			DeclareField(clock_offset);
+			DeclareField(crtc_counter);
+		}
+	}
+
+	/// Instantiates a new State based on the machine @c src.
+	template <bool has_fdc> State(const ConcreteMachine<has_fdc> &src);
+
+	/// Applies this state to @c target.
+	template <bool has_fdc> void apply(ConcreteMachine<has_fdc> &target) const;
+};
+
 /*!
 	The actual Amstrad CPC implementation; tying the 8255, 6845 and AY to the Z80.
 */
@@ -790,7 +933,8 @@ template <bool has_fdc> class ConcreteMachine:
 	public ClockingHint::Observer,
 	public Configurable::Device,
 	public Machine,
-	public Activity::Source {
+	public Activity::Source,
+	public MachineTypes::StateProducer {
 	public:
 		ConcreteMachine(const Analyser::Static::AmstradCPC::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
 			z80_(*this),
@@ -1029,7 +1173,7 @@ template <bool has_fdc> class ConcreteMachine:
 		}
 
 		/// A CRTMachine function; sets the destination for video.
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			crtc_bus_handler_.set_scan_target(scan_target);
 		}
 
@@ -1133,6 +1277,21 @@ template <bool has_fdc> class ConcreteMachine:
 			return key_state_.get_joysticks();
 		}
 
+		// MARK: - MachineTypes::StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			flush();
+			return std::make_unique<State>(*this);
+		}
+
+		bool set_state(const Reflection::Struct &str) final {
+			const auto state = dynamic_cast<const State *>(&str);
+			if(!state) return false;
+
+			flush();
+			state->apply(*this);
+			return true;
+		}
+
 	private:
 		inline void write_to_gate_array(uint8_t value) {
 			switch(value >> 6) {
@@ -1154,6 +1313,7 @@ template <bool has_fdc> class ConcreteMachine:
 				case 3:
 					// Perform RAM paging, if 128kb is permitted.
 					if(has_128k_) {
+						ram_configuration_ = value & 7;
 						const bool adjust_low_read_pointer = read_pointers_[0] == write_pointers_[0];
 						const bool adjust_high_read_pointer = read_pointers_[3] == write_pointers_[3];
 #define RAM_BANK(x) &ram_[x * 16384]
@@ -1226,9 +1386,89 @@ template <bool has_fdc> class ConcreteMachine:
 		AmstradCPC::KeyboardMapper keyboard_mapper_;
 
 		bool has_run_ = false;
+		uint8_t ram_configuration_ = 0;
 		uint8_t ram_[128 * 1024];
+
+		friend struct State;
 };
 
+template <bool has_fdc> State::State(const ConcreteMachine<has_fdc> &src) : State() {
+	z80 = CPU::Z80::State(src.z80_);
+	crtc = Motorola::CRTC::State(src.crtc_);
+	ppi = Intel::i8255::State(src.i8255_);
+	ay = GI::AY38910::State(src.ay_.ay());
+
+	ram = std::vector<uint8_t>(std::begin(src.ram_), std::end(src.ram_));
+
+	const auto &gate_array = src.crtc_bus_handler_;
+	pen = gate_array.pen_;
+	std::copy(std::begin(gate_array.palette_), std::end(gate_array.palette_), std::begin(palette));
+	border = gate_array.border_;
+	mode = gate_array.mode_;
+	next_mode = gate_array.next_mode_;
+	was_hsync = gate_array.was_hsync_;
+	was_vsync = gate_array.was_vsync_;
+
+	interrupt_reset_counter = src.interrupt_timer_.reset_counter_;
+	interrupt_request = src.interrupt_timer_.interrupt_request_;
+	last_interrupt_request = src.interrupt_timer_.last_interrupt_request_;
+	interrupt_timer = src.interrupt_timer_.timer_;
+
+	ram_configuration = src.ram_configuration_;
+	lower_rom_is_paged = src.read_pointers_[0] != src.write_pointers_[0];
+	upper_rom_is_paged = src.upper_rom_is_paged_;
+	upper_rom = src.upper_rom_;
+
+	clock_offset = src.clock_offset_.template as<int>();
+	crtc_counter = src.crtc_counter_.template as<int>();
+}
+
+template <bool has_fdc> void State::apply(ConcreteMachine<has_fdc> &target) const {
+	z80.apply(target.z80_);
+	crtc.apply(target.crtc_);
+	ay.apply(target.ay_.ay());
+
+	std::copy(ram.begin(), ram.begin() + std::min(ram.size(), sizeof(target.ram_)), std::begin(target.ram_));
+
+	auto &gate_array = target.crtc_bus_handler_;
+	gate_array.pen_ = pen;
+	std::copy(std::begin(palette), std::end(palette), std::begin(gate_array.palette_));
+	gate_array.border_ = border;
+	gate_array.next_mode_ = next_mode;
+	gate_array.was_hsync_ = was_hsync;
+	gate_array.was_vsync_ = was_vsync;
+	gate_array.set_mode(mode);
+
+	target.interrupt_timer_.reset_counter_ = interrupt_reset_counter;
+	target.interrupt_timer_.interrupt_request_ = interrupt_request;
+	target.interrupt_timer_.last_interrupt_request_ = last_interrupt_request;
+	target.interrupt_timer_.timer_ = interrupt_timer;
+
+	// Repage via the gate array: RAM configuration first, then ROM enables; the
+	// latter also reposts the next mode, which has already been set.
+	if(upper_rom == ConcreteMachine<has_fdc>::ROMType::AMSDOS && has_fdc) {
+		target.upper_rom_ = ConcreteMachine<has_fdc>::ROMType::AMSDOS;
+	} else {
+		target.upper_rom_ = ConcreteMachine<has_fdc>::ROMType::BASIC;
+	}
+	target.read_pointers_[0] = target.write_pointers_[0];
+	target.read_pointers_[3] = target.write_pointers_[3];
+	target.write_to_gate_array(uint8_t(0xc0 | ram_configuration));
+	target.write_to_gate_array(uint8_t(
+		0x80 |
+		(lower_rom_is_paged ? 0x00 : 0x04) |
+		(upper_rom_is_paged ? 0x00 : 0x08) |
+		(next_mode & 3)
+	));
+
+	target.clock_offset_ = HalfCycles(clock_offset);
+	target.crtc_counter_ = HalfCycles(crtc_counter);
+
+	// Applying the 8255 state reposts its outputs, restoring the selected keyboard row,
+	// tape motor and AY control lines.
+	ppi.apply(target.i8255_);
+}
+
 }
 
 using namespace AmstradCPC;
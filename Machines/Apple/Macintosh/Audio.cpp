@@ -95,3 +95,10 @@ void Audio::get_samples(std::size_t number_of_samples, int16_t *target) {
 		number_of_samples -= cycles_left_in_sample;
 	}
 }
+
+void Audio::skip_samples(std::size_t number_of_samples) {
+	// Advance the sample pointer exactly as get_samples would.
+	subcycle_offset_ += number_of_samples;
+	sample_queue_.read_pointer = (sample_queue_.read_pointer + (subcycle_offset_ / sample_length)) % sample_queue_.buffer.size();
+	subcycle_offset_ %= sample_length;
+}
@@ -53,6 +53,7 @@ class Audio: public ::Outputs::Speaker::SampleSource {
 
 		// to satisfy ::Outputs::Speaker (included via ::Outputs::Filter.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		void skip_samples(std::size_t number_of_samples);
 		bool is_zero_level() const;
 		void set_sample_volume_range(std::int16_t range);
 		constexpr static bool get_is_stereo() { return false; }
@@ -165,7 +165,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			audio_.queue.flush();
 		}
 
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			video_.set_scan_target(scan_target);
 		}
 
@@ -181,6 +181,11 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			mc68000_.run_for(cycles);
 		}
 
+		void set_approximate_timing_enabled(bool enabled) final {
+			approximate_timing_ = enabled;
+			update_plain_memory();
+		}
+
 		using Microcycle = CPU::MC68000::Microcycle;
 
 		forceinline HalfCycles perform_bus_operation(const Microcycle &cycle, int is_supervisor) {
@@ -379,6 +384,14 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			return delay;
 		}
 
+		forceinline void advance_plain_time(HalfCycles duration) {
+			advance_time(duration);
+
+			// RAM is contended only while video is being output; reassess that at the end of every
+			// period of plain time, which will usually be no longer than a single instruction.
+			mc68000_.set_plain_memory(plain_read_pages_, plain_write_pages_, video_is_outputting() ? plain_contention_ : nullptr);
+		}
+
 		void flush() {
 			// Flush the video before the audio queue; in a Mac the
 			// video is responsible for providing part of the
@@ -439,6 +452,8 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 					});
 				break;
 			}
+
+			update_plain_memory();
 		}
 
 		bool video_is_outputting() {
@@ -758,7 +773,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				Inputs::QuadratureMouse &mouse_;
 		};
 
-		CPU::MC68000::Processor<ConcreteMachine, true> mc68000_;
+		CPU::MC68000::Processor<ConcreteMachine, true, false, true> mc68000_;
 
 		DriveSpeedAccumulator drive_speed_accumulator_;
 		IWMActor iwm_;
@@ -842,6 +857,47 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		uint32_t rom_mask_ = 0;
 		uint8_t rom_[128*1024];
 		std::vector<uint8_t> ram_;
+
+		// With approximate timing enabled, RAM and ROM are nominated to the 68000 as plain memory, with
+		// RAM being contended while video is output; all other devices continue to be handled above, as
+		// do writes to the page containing the video and audio buffers, so that video is updated first.
+		bool approximate_timing_ = false;
+		const uint8_t *plain_read_pages_[256];
+		uint8_t *plain_write_pages_[256];
+		uint16_t plain_contention_[256];
+		void update_plain_memory() {
+			if(!approximate_timing_) {
+				mc68000_.set_plain_memory(nullptr, nullptr, nullptr);
+				return;
+			}
+
+			for(size_t page = 0; page < 256; ++page) {
+				const uint32_t address = uint32_t(page << 16);
+				plain_read_pages_[page] = nullptr;
+				plain_write_pages_[page] = nullptr;
+				plain_contention_[page] = 0;
+
+				switch(memory_map_[page >> 1]) {
+					default: break;
+
+					case BusDevice::RAM:
+						plain_read_pages_[page] = &ram_[address & ram_mask_];
+						if((address & ram_mask_) < ((ram_mask_ - 0xd900) & ~0xffffu)) {
+							plain_write_pages_[page] = &ram_[address & ram_mask_];
+						}
+
+						// As per perform_bus_operation: only every other access slot is available
+						// to the CPU while video is being output.
+						plain_contention_[page] = 0xff00;
+					break;
+
+					case BusDevice::ROM:
+						plain_read_pages_[page] = &rom_[address & rom_mask_];
+					break;
+				}
+			}
+			mc68000_.set_plain_memory(plain_read_pages_, plain_write_pages_, video_is_outputting() ? plain_contention_ : nullptr);
+		}
 };
 
 }
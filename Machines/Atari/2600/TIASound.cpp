@@ -41,8 +41,18 @@ void Atari2600::TIASound::set_control(int channel, uint8_t control) {
 #define advance_poly9(c) poly9_counter_[channel] = (poly9_counter_[channel] >> 1) | (((poly9_counter_[channel] << 4) ^ (poly9_counter_[channel] << 8))&0x100)
 
 void Atari2600::TIASound::get_samples(std::size_t number_of_samples, int16_t *target) {
-	for(unsigned int c = 0; c < number_of_samples; c++) {
-		target[c] = 0;
+	apply_samples<true>(number_of_samples, target);
+}
+
+void Atari2600::TIASound::skip_samples(std::size_t number_of_samples) {
+	// The polynomial counters are advanced only conditionally upon the divider,
+	// so just step through as usual, discarding output.
+	apply_samples<false>(number_of_samples, nullptr);
+}
+
+template <bool output> void Atari2600::TIASound::apply_samples(std::size_t number_of_samples, int16_t *target) {
+	for(std::size_t c = 0; c < number_of_samples; c++) {
+		if constexpr (output) target[c] = 0;
 		for(int channel = 0; channel < 2; channel++) {
 			divider_counter_[channel] ++;
 			int divider_value = divider_counter_[channel] / (38 / CPUTicksPerAudioTick);
@@ -119,7 +129,7 @@ void Atari2600::TIASound::get_samples(std::size_t number_of_samples, int16_t *ta
 				break;
 			}
 
-			target[c] += (volume_[channel] * per_channel_volume_ * level) >> 4;
+			if constexpr (output) target[c] += (volume_[channel] * per_channel_volume_ * level) >> 4;
 		}
 	}
 }
@@ -28,6 +28,7 @@ class TIASound: public Outputs::Speaker::SampleSource {
 
 		// To satisfy ::SampleSource.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		void skip_samples(std::size_t number_of_samples);
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
 
@@ -45,6 +46,8 @@ class TIASound: public Outputs::Speaker::SampleSource {
 
 		int divider_counter_[2];
 		int16_t per_channel_volume_ = 0;
+
+		template <bool output> void apply_samples(std::size_t number_of_samples, int16_t *target);
 };
 
 }
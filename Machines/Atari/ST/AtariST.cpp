@@ -129,7 +129,7 @@ class ConcreteMachine:
 		}
 
 		// MARK: CRTMachine::Machine
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			video_->set_scan_target(scan_target);
 		}
 
@@ -158,6 +158,11 @@ class ConcreteMachine:
 			mc68000_.run_for(cycles);
 		}
 
+		void set_approximate_timing_enabled(bool enabled) final {
+			approximate_timing_ = enabled;
+			update_plain_memory();
+		}
+
 		// MARK: MC68000::BusHandler
 		using Microcycle = CPU::MC68000::Microcycle;
 		HalfCycles perform_bus_operation(const CPU::MC68000::Microcycle &cycle, int is_supervisor) {
@@ -422,6 +427,38 @@ class ConcreteMachine:
 			return HalfCycles(0);
 		}
 
+		HalfCycles perform_idle_cycles(const CPU::MC68000::Microcycle &cycle, HalfCycles limit, int) {
+			// Decline if anything needs to be clocked in real time, other than the MFP's timers.
+			if(
+				keyboard_needs_clock_ || !may_defer_acias_ ||
+				dma_clocking_preference_ == ClockingHint::Preference::RealTime
+			) {
+				return HalfCycles(0);
+			}
+
+			// Otherwise the interrupt inputs can change only at a video sequence point or upon expiry of an
+			// MFP timer; run up to whichever is sooner. The MFP's time is converted conservatively, allowing
+			// for any fractional time that is already pending.
+			HalfCycles duration = std::min(limit, cycles_until_video_event_ - HalfCycles(1));
+			if(mfp_is_realtime_) {
+				const auto mfp_time = mfp_->get_next_sequence_point();
+				if(mfp_time > HalfCycles(0)) {
+					duration = std::min(duration, HalfCycles((mfp_time.as_integral() - 1) * 2673749 / 819200));
+				}
+			}
+			duration -= duration % cycle.length;
+			if(duration <= HalfCycles(0)) return HalfCycles(0);
+
+			mc68000_.set_is_peripheral_address(false);
+			mc68000_.set_bus_error(false);
+			advance_time(duration);
+			return duration;
+		}
+
+		forceinline void advance_plain_time(HalfCycles duration) {
+			advance_time(duration);
+		}
+
 		void flush() {
 			dma_.flush();
 			mfp_.flush();
@@ -481,7 +518,7 @@ class ConcreteMachine:
 			speaker_.run_for(audio_queue_, cycles_since_audio_update_.divide_cycles(Cycles(4)));
 		}
 
-		CPU::MC68000::Processor<ConcreteMachine, true> mc68000_;
+		CPU::MC68000::Processor<ConcreteMachine, true, false, true> mc68000_;
 		HalfCycles bus_phase_;
 
 		JustInTimeActor<Video> video_;
@@ -524,6 +561,46 @@ class ConcreteMachine:
 		};
 		BusDevice memory_map_[256];
 
+		// With approximate timing enabled, RAM other than the first page — which contains both the supervisor-only
+		// area and the ROM mirror — and ROM are nominated to the 68000 as plain memory. RAM is subject to the same
+		// DTack rule as is applied in perform_bus_operation, and writes to any page that video might fetch from
+		// continue to go via perform_bus_operation so that video is flushed first.
+		bool approximate_timing_ = false;
+		const uint8_t *plain_read_pages_[256];
+		uint8_t *plain_write_pages_[256];
+		uint16_t plain_contention_[256];
+		void update_plain_memory() {
+			if(!approximate_timing_) {
+				mc68000_.set_plain_memory(nullptr, nullptr, nullptr);
+				return;
+			}
+
+			for(size_t page = 0; page < 256; ++page) {
+				const uint32_t address = uint32_t(page << 16);
+				const bool is_video_visible = address < video_range_.high_address && address + 0x10000 > video_range_.low_address;
+				plain_read_pages_[page] = nullptr;
+				plain_write_pages_[page] = nullptr;
+				plain_contention_[page] = 0;
+
+				switch(memory_map_[page]) {
+					default: break;
+
+					case BusDevice::RAM:
+						plain_read_pages_[page] = &ram_[address];
+						if(!is_video_visible) plain_write_pages_[page] = &ram_[address];
+
+						// The address strobe is extended until it ends in the second half of an eight-cycle window.
+						plain_contention_[page] = 0xf0f0;
+					break;
+
+					case BusDevice::ROM:
+						plain_read_pages_[page] = &rom_[address - rom_start_];
+					break;
+				}
+			}
+			mc68000_.set_plain_memory(plain_read_pages_, plain_write_pages_, plain_contention_, CPU::MC68000::ContentionPoint::AddressStrobe);
+		}
+
 		// MARK: - Clocking Management.
 		bool may_defer_acias_ = true;
 		bool keyboard_needs_clock_ = false;
@@ -671,6 +748,7 @@ class ConcreteMachine:
 		Video::Range video_range_;
 		void video_did_change_access_range(Video *video) final {
 			video_range_ = video->get_memory_access_range();
+			if(approximate_timing_) update_plain_memory();
 		}
 
 		// MARK: - Configuration options.
@@ -9,6 +9,7 @@
 #include "ColecoVision.hpp"
 
 #include "../../Processors/Z80/Z80.hpp"
+#include "../../Processors/Z80/State/State.hpp"
 
 #include "../../Components/9918/9918.hpp"
 #include "../../Components/AY38910/AY38910.hpp"	// For the Super Game Module.
@@ -105,6 +106,39 @@ class Joystick: public Inputs::ConcreteJoystick {
 		uint8_t keypad_ = 0x7f;
 };
 
+/*!
+	Captures complete ColecoVision state, other than that of the SN76489.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	TI::TMS::State vdp;
+	GI::AY38910::State ay;
+
+	std::vector<uint8_t> ram;
+	std::vector<uint8_t> super_game_module_ram;
+	bool super_game_module_replaces_bios = false;
+	bool super_game_module_replaces_ram = false;
+
+	uint32_t megacart_page = 0;
+	bool joysticks_in_keypad_mode = false;
+	int time_until_interrupt = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(vdp);
+			DeclareField(ay);
+			DeclareField(ram);
+			DeclareField(super_game_module_ram);
+			DeclareField(super_game_module_replaces_bios);
+			DeclareField(super_game_module_replaces_ram);
+			DeclareField(megacart_page);
+			DeclareField(joysticks_in_keypad_mode);
+			DeclareField(time_until_interrupt);
+		}
+	}
+};
+
 class ConcreteMachine:
 	public Machine,
 	public CPU::Z80::BusHandler,
@@ -112,7 +146,8 @@ class ConcreteMachine:
 	public MachineTypes::TimedMachine,
 	public MachineTypes::ScanProducer,
 	public MachineTypes::AudioProducer,
-	public MachineTypes::JoystickMachine {
+	public MachineTypes::JoystickMachine,
+	public MachineTypes::StateProducer {
 
 	public:
 		ConcreteMachine(const Analyser::Static::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
@@ -177,7 +212,7 @@ class ConcreteMachine:
 			return joysticks_;
 		}
 
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			vdp_->set_scan_target(scan_target);
 		}
 
@@ -379,6 +414,52 @@ class ConcreteMachine:
 			set_video_signal_configurable(options->output);
 		}
 
+		// MARK: - MachineTypes::StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			flush();
+
+			auto state = std::make_unique<State>();
+			state->z80 = CPU::Z80::State(z80_);
+			state->vdp = TI::TMS::State(*vdp_.last_valid());
+			state->ay = GI::AY38910::State(ay_);
+
+			state->ram = std::vector<uint8_t>(std::begin(ram_), std::end(ram_));
+			state->super_game_module_ram = std::vector<uint8_t>(std::begin(super_game_module_.ram), std::end(super_game_module_.ram));
+			state->super_game_module_replaces_bios = super_game_module_.replace_bios;
+			state->super_game_module_replaces_ram = super_game_module_.replace_ram;
+
+			state->megacart_page = is_megacart_ ? uint32_t(cartridge_pages_[1] - cartridge_.data()) : 0;
+			state->joysticks_in_keypad_mode = joysticks_in_keypad_mode_;
+			state->time_until_interrupt = time_until_interrupt_.as<int>();
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &str) final {
+			const auto state = dynamic_cast<const State *>(&str);
+			if(!state) return false;
+
+			flush();
+
+			state->z80.apply(z80_);
+			state->vdp.apply(*vdp_.last_valid());
+			state->ay.apply(ay_);
+
+			std::copy(state->ram.begin(), state->ram.begin() + std::min(state->ram.size(), sizeof(ram_)), std::begin(ram_));
+			std::copy(
+				state->super_game_module_ram.begin(),
+				state->super_game_module_ram.begin() + std::min(state->super_game_module_ram.size(), sizeof(super_game_module_.ram)),
+				std::begin(super_game_module_.ram));
+			super_game_module_.replace_bios = state->super_game_module_replaces_bios;
+			super_game_module_.replace_ram = state->super_game_module_replaces_ram;
+
+			if(is_megacart_ && state->megacart_page < cartridge_.size()) {
+				cartridge_pages_[1] = &cartridge_[state->megacart_page];
+			}
+			joysticks_in_keypad_mode_ = state->joysticks_in_keypad_mode;
+			time_until_interrupt_ = HalfCycles(state->time_until_interrupt);
+			return true;
+		}
+
 	private:
 		inline void page_megacart(uint16_t address) {
 			const std::size_t selected_start = (size_t(address&63) << 14) % cartridge_.size();
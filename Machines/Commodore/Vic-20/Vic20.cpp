@@ -14,6 +14,7 @@
 #include "../../MachineTypes.hpp"
 
 #include "../../../Processors/6502/6502.hpp"
+#include "../../../Processors/6502/State/State.hpp"
 #include "../../../Components/6560/6560.hpp"
 #include "../../../Components/6522/6522.hpp"
 
@@ -35,6 +36,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <iterator>
 
 namespace Commodore {
 namespace Vic20 {
@@ -270,6 +272,30 @@ class Joystick: public Inputs::ConcreteJoystick {
 		KeyboardVIA &keyboard_via_port_handler_;
 };
 
+/*!
+	Captures Vic-20 CPU, chip and RAM state; tape and C1540 state is not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::MOS6502::State m6502;
+	MOS::MOS6522::State user_port_via;
+	MOS::MOS6522::State keyboard_via;
+	MOS::MOS6560::State vic;
+
+	std::vector<uint8_t> ram;
+	std::vector<uint8_t> colour_ram;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(m6502);
+			DeclareField(user_port_via);
+			DeclareField(keyboard_via);
+			DeclareField(vic);
+			DeclareField(ram);
+			DeclareField(colour_ram);
+		}
+	}
+};
+
 class ConcreteMachine:
 	public MachineTypes::TimedMachine,
 	public MachineTypes::ScanProducer,
@@ -284,7 +310,8 @@ class ConcreteMachine:
 	public Storage::Tape::BinaryTapePlayer::Delegate,
 	public Machine,
 	public ClockingHint::Observer,
-	public Activity::Source {
+	public Activity::Source,
+	public MachineTypes::StateProducer {
 	public:
 		ConcreteMachine(const Analyser::Static::Commodore::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
 				m6502_(*this),
@@ -464,6 +491,7 @@ class ConcreteMachine:
 				rom_ = rom_image;
 				rom_.resize(0x2000);
 				write_to_map(processor_read_memory_map_, rom_.data(), rom_address_, rom_length_);
+				update_plain_memory();
 			}
 
 			set_use_fast_tape();
@@ -625,6 +653,14 @@ class ConcreteMachine:
 			return Cycles(1);
 		}
 
+		forceinline void advance_plain_cycles(Cycles cycles) {
+			cycles_since_mos6560_update_ += cycles;
+			user_port_via_.run_for(cycles);
+			keyboard_via_.run_for(cycles);
+			if(!tape_is_sleeping_ && !hold_tape_) tape_->run_for(cycles);
+			if(c1540_) c1540_->run_for(cycles);
+		}
+
 		void flush() {
 			update_video();
 			mos6560_.flush();
@@ -634,7 +670,12 @@ class ConcreteMachine:
 			m6502_.run_for(cycles);
 		}
 
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void set_approximate_timing_enabled(bool enabled) final {
+			approximate_timing_ = enabled;
+			update_plain_memory();
+		}
+
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			mos6560_.set_scan_target(scan_target);
 		}
 
@@ -701,11 +742,44 @@ class ConcreteMachine:
 			if(c1540_) c1540_->set_activity_observer(observer);
 		}
 
+		// MARK: - MachineTypes::StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			flush();
+
+			auto state = std::make_unique<State>();
+			state->m6502 = CPU::MOS6502::State(m6502_);
+			state->user_port_via = MOS::MOS6522::State(user_port_via_);
+			state->keyboard_via = MOS::MOS6522::State(keyboard_via_);
+			state->vic = MOS::MOS6560::State(mos6560_);
+
+			state->ram = std::vector<uint8_t>(std::begin(ram_), std::end(ram_));
+			state->colour_ram = std::vector<uint8_t>(std::begin(colour_ram_), std::end(colour_ram_));
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &str) final {
+			const auto state = dynamic_cast<const State *>(&str);
+			if(!state) return false;
+
+			flush();
+
+			state->m6502.apply(m6502_);
+			state->user_port_via.apply(user_port_via_);
+			state->keyboard_via.apply(keyboard_via_);
+			state->vic.apply(mos6560_);
+
+			std::copy(state->ram.begin(), state->ram.begin() + std::min(state->ram.size(), sizeof(ram_)), std::begin(ram_));
+			std::copy(state->colour_ram.begin(), state->colour_ram.begin() + std::min(state->colour_ram.size(), sizeof(colour_ram_)), std::begin(colour_ram_));
+
+			mos6522_did_change_interrupt_status(nullptr);
+			return true;
+		}
+
 	private:
 		void update_video() {
 			mos6560_.run_for(cycles_since_mos6560_update_.flush<Cycles>());
 		}
-		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false> m6502_;
+		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, ConcreteMachine, false, true> m6502_;
 
 		std::vector<uint8_t>  character_rom_;
 		std::vector<uint8_t>  basic_rom_;
@@ -728,6 +802,39 @@ class ConcreteMachine:
 			}
 		}
 
+		// With approximate timing enabled, all RAM and ROM other than the pages containing the typer and
+		// fast tape traps is nominated to the 6502 as plain memory; the I/O area and unmapped space are not.
+		// Writes to anything the 6560 can fetch continue to go via perform_bus_operation, so that video
+		// is brought up to date before they land.
+		bool approximate_timing_ = false;
+		const uint8_t *plain_read_pages_[256];
+		uint8_t *plain_write_pages_[256];
+		void update_plain_memory() {
+			if(!approximate_timing_) {
+				m6502_.set_plain_memory(nullptr, nullptr);
+				return;
+			}
+
+			const auto is_video_visible = [this] (const uint8_t *segment) {
+				if(segment == colour_ram_) return true;
+				for(const auto video_segment: mos6560_bus_handler_.video_memory_map) {
+					if(segment == video_segment) return true;
+				}
+				return false;
+			};
+
+			for(size_t page = 0; page < 256; ++page) {
+				const size_t offset = (page & 3) << 8;
+				const bool is_trapped = (page & 0xfc) == 0x90 || page == 0xeb || page == 0xf7 || page == 0xf9;
+				uint8_t *const read = processor_read_memory_map_[page >> 2];
+				uint8_t *const write = processor_write_memory_map_[page >> 2];
+
+				plain_read_pages_[page] = (read && !is_trapped) ? read + offset : nullptr;
+				plain_write_pages_[page] = (write && !is_trapped && !is_video_visible(write)) ? write + offset : nullptr;
+			}
+			m6502_.set_plain_memory(plain_read_pages_, plain_write_pages_);
+		}
+
 		Commodore::Vic20::KeyboardMapper keyboard_mapper_;
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 
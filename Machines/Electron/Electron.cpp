@@ -17,6 +17,7 @@
 #include "../../Configurable/StandardOptions.hpp"
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 #include "../../Processors/6502/6502.hpp"
+#include "../../Processors/6502/State/State.hpp"
 #include "../../Storage/Tape/Tape.hpp"
 
 #include "../Utility/Typer.hpp"
@@ -29,8 +30,49 @@
 #include "Tape.hpp"
 #include "Video.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace Electron {
 
+/*!
+	Captures Electron CPU, ULA and RAM state; tape, Plus 3 and sound generator state
+	is not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::MOS6502::State m6502;
+	VideoState video;
+
+	std::vector<uint8_t> ram;
+	int active_rom = 0;
+	bool keyboard_is_active = false;
+	bool basic_is_active = false;
+
+	uint8_t interrupt_status = 0;
+	uint8_t interrupt_control = 0;
+	int cycles_until_display_interrupt = 0;
+	uint8_t next_display_interrupt = 0;
+	bool speaker_is_enabled = false;
+	bool caps_led_state = false;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(m6502);
+			DeclareField(video);
+			DeclareField(ram);
+			DeclareField(active_rom);
+			DeclareField(keyboard_is_active);
+			DeclareField(basic_is_active);
+			DeclareField(interrupt_status);
+			DeclareField(interrupt_control);
+			DeclareField(cycles_until_display_interrupt);
+			DeclareField(next_display_interrupt);
+			DeclareField(speaker_is_enabled);
+			DeclareField(caps_led_state);
+		}
+	}
+};
+
 class ConcreteMachine:
 	public Machine,
 	public MachineTypes::TimedMachine,
@@ -42,7 +84,8 @@ class ConcreteMachine:
 	public CPU::MOS6502::BusHandler,
 	public Tape::Delegate,
 	public Utility::TypeRecipient<CharacterMapper>,
-	public Activity::Source {
+	public Activity::Source,
+	public MachineTypes::StateProducer {
 	public:
 		ConcreteMachine(const Analyser::Static::Acorn::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
 				m6502_(*this),
@@ -397,7 +440,7 @@ class ConcreteMachine:
 			audio_queue_.perform();
 		}
 
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			video_output_.set_scan_target(scan_target);
 		}
 
@@ -462,6 +505,60 @@ class ConcreteMachine:
 			set_use_fast_tape_hack();
 		}
 
+		// MARK: - MachineTypes::StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			flush();
+
+			auto state = std::make_unique<State>();
+			state->m6502 = CPU::MOS6502::State(m6502_);
+			state->video = VideoState(video_output_);
+
+			state->ram = std::vector<uint8_t>(std::begin(ram_), std::end(ram_));
+			state->active_rom = active_rom_;
+			state->keyboard_is_active = keyboard_is_active_;
+			state->basic_is_active = basic_is_active_;
+
+			state->interrupt_status = interrupt_status_;
+			state->interrupt_control = interrupt_control_;
+			state->cycles_until_display_interrupt = cycles_until_display_interrupt_;
+			state->next_display_interrupt = next_display_interrupt_;
+			state->speaker_is_enabled = speaker_is_enabled_;
+			state->caps_led_state = caps_led_state_;
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &str) final {
+			const auto state = dynamic_cast<const State *>(&str);
+			if(!state) return false;
+
+			flush();
+
+			state->m6502.apply(m6502_);
+			state->video.apply(video_output_);
+			video_access_range_ = video_output_.get_memory_access_range();
+
+			std::copy(state->ram.begin(), state->ram.begin() + std::min(state->ram.size(), sizeof(ram_)), std::begin(ram_));
+			active_rom_ = state->active_rom & 15;
+			keyboard_is_active_ = state->keyboard_is_active;
+			basic_is_active_ = state->basic_is_active;
+
+			interrupt_control_ = state->interrupt_control;
+			interrupt_status_ = state->interrupt_status;
+			evaluate_interrupts();
+			cycles_until_display_interrupt_ = state->cycles_until_display_interrupt;
+			next_display_interrupt_ = Interrupt(state->next_display_interrupt);
+
+			if(speaker_is_enabled_ != state->speaker_is_enabled) {
+				sound_generator_.set_is_enabled(state->speaker_is_enabled);
+				speaker_is_enabled_ = state->speaker_is_enabled;
+			}
+
+			caps_led_state_ = state->caps_led_state;
+			if(activity_observer_)
+				activity_observer_->set_led_status(caps_led, caps_led_state_);
+			return true;
+		}
+
 		// MARK: - Activity Source
 		void set_activity_observer(Activity::Observer *observer) final {
 			activity_observer_ = observer;
@@ -8,6 +8,7 @@
 
 #include "Video.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace Electron;
@@ -306,43 +307,46 @@ void VideoOutput::write(int address, uint8_t value) {
 				palette_[registers[index][1]]	= (palette_[registers[index][1]]&5)	| ((colour >> 1)&2);
 			}
 
-			// regenerate all palette tables for now
-			for(int byte = 0; byte < 256; byte++) {
-				uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-				target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
-				target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-				target[4] = palette_[(byte&0x08) >> 0];
-				target[5] = palette_[(byte&0x04) << 1];
-				target[6] = palette_[(byte&0x02) << 2];
-				target[7] = palette_[(byte&0x01) << 3];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
-			}
+			regenerate_palette_tables();
 		}
 		break;
 	}
 }
 
+void VideoOutput::regenerate_palette_tables() {
+	for(int byte = 0; byte < 256; byte++) {
+		uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
+		target[0] = palette_[(byte&0x80) >> 4];
+		target[1] = palette_[(byte&0x40) >> 3];
+		target[2] = palette_[(byte&0x20) >> 2];
+		target[3] = palette_[(byte&0x10) >> 1];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+		target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
+		target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
+		target[0] = palette_[(byte&0x80) >> 4];
+		target[1] = palette_[(byte&0x40) >> 3];
+		target[2] = palette_[(byte&0x20) >> 2];
+		target[3] = palette_[(byte&0x10) >> 1];
+		target[4] = palette_[(byte&0x08) >> 0];
+		target[5] = palette_[(byte&0x04) << 1];
+		target[6] = palette_[(byte&0x02) << 2];
+		target[7] = palette_[(byte&0x01) << 3];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
+	}
+}
+
 void VideoOutput::setup_base_address() {
 	switch(screen_mode_) {
 		case 0: case 1: case 2: screen_mode_base_address_ = 0x3000; break;
@@ -490,3 +494,69 @@ void VideoOutput::emplace_pixel_line() {
 	screen_map_.emplace_back(DrawAction::Pixels, 80);
 	screen_map_.emplace_back(DrawAction::Blank, 48 - first_graphics_cycle);
 }
+
+// MARK: - State
+
+VideoState::VideoState() {
+	if(needs_declare()) {
+		DeclareField(output_position);
+		DeclareField(unused_cycles);
+		DeclareField(palette);
+		DeclareField(screen_mode);
+		DeclareField(start_screen_address);
+		DeclareField(start_line_address);
+		DeclareField(current_screen_address);
+		DeclareField(current_pixel_line);
+		DeclareField(current_pixel_column);
+		DeclareField(current_character_row);
+		DeclareField(last_pixel_byte);
+		DeclareField(is_blank_line);
+		DeclareField(current_output_divider);
+		DeclareField(screen_map_pointer);
+		DeclareField(cycles_into_draw_action);
+	}
+}
+
+VideoState::VideoState(const VideoOutput &src) : VideoState() {
+	output_position = src.output_position_;
+	unused_cycles = src.unused_cycles_;
+
+	memcpy(palette, src.palette_, sizeof(palette));
+	screen_mode = src.screen_mode_;
+	start_screen_address = src.start_screen_address_;
+
+	start_line_address = src.start_line_address_;
+	current_screen_address = src.current_screen_address_;
+	current_pixel_line = src.current_pixel_line_;
+	current_pixel_column = src.current_pixel_column_;
+	current_character_row = src.current_character_row_;
+	last_pixel_byte = src.last_pixel_byte_;
+	is_blank_line = src.is_blank_line_;
+
+	current_output_divider = src.current_output_divider_;
+	screen_map_pointer = uint32_t(src.screen_map_pointer_);
+	cycles_into_draw_action = src.cycles_into_draw_action_;
+}
+
+void VideoState::apply(VideoOutput &target) const {
+	target.output_position_ = output_position;
+	target.unused_cycles_ = unused_cycles;
+
+	memcpy(target.palette_, palette, sizeof(palette));
+	target.regenerate_palette_tables();
+	target.screen_mode_ = screen_mode;
+	target.setup_base_address();
+	target.start_screen_address_ = start_screen_address;
+
+	target.start_line_address_ = start_line_address;
+	target.current_screen_address_ = current_screen_address;
+	target.current_pixel_line_ = current_pixel_line;
+	target.current_pixel_column_ = current_pixel_column;
+	target.current_character_row_ = current_character_row;
+	target.last_pixel_byte_ = last_pixel_byte;
+	target.is_blank_line_ = is_blank_line;
+
+	target.current_output_divider_ = current_output_divider;
+	target.screen_map_pointer_ = std::min(size_t(screen_map_pointer), target.screen_map_.size() - 1);
+	target.cycles_into_draw_action_ = cycles_into_draw_action;
+}
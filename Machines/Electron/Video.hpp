@@ -11,12 +11,15 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 #include "Interrupts.hpp"
 
 #include <vector>
 
 namespace Electron {
 
+struct VideoState;
+
 /*!
 	Implements the Electron's video subsystem plus appropriate signalling.
 
@@ -91,6 +94,7 @@ class VideoOutput {
 		inline void end_pixel_line();
 		inline void output_pixels(int number_of_cycles);
 		inline void setup_base_address();
+		void regenerate_palette_tables();
 
 		int output_position_ = 0;
 		int unused_cycles_ = 0;
@@ -137,6 +141,41 @@ class VideoOutput {
 		void emplace_pixel_line();
 		std::size_t screen_map_pointer_ = 0;
 		int cycles_into_draw_action_ = 0;
+
+		friend struct VideoState;
+};
+
+/*!
+	Provides a means for capturing or restoring complete VideoOutput state, other
+	than that of the CRT.
+*/
+struct VideoState: public Reflection::StructImpl<VideoState> {
+	int output_position = 0;
+	int unused_cycles = 0;
+
+	uint8_t palette[16]{};
+	uint8_t screen_mode = 6;
+	uint16_t start_screen_address = 0;
+
+	uint16_t start_line_address = 0;
+	uint16_t current_screen_address = 0;
+	int current_pixel_line = -1;
+	int current_pixel_column = 0;
+	int current_character_row = 0;
+	uint8_t last_pixel_byte = 0;
+	bool is_blank_line = false;
+
+	int current_output_divider = 1;
+	uint32_t screen_map_pointer = 0;
+	int cycles_into_draw_action = 0;
+
+	VideoState();
+
+	/// Instantiates a new VideoState based on the VideoOutput @c src.
+	VideoState(const VideoOutput &src);
+
+	/// Applies this state to @c target.
+	void apply(VideoOutput &target) const;
 };
 
 }
@@ -21,6 +21,7 @@
 #include "Cartridges/KonamiWithSCC.hpp"
 
 #include "../../Processors/Z80/Z80.hpp"
+#include "../../Processors/Z80/State/State.hpp"
 
 #include "../../Components/1770/1770.hpp"
 #include "../../Components/9918/9918.hpp"
@@ -128,6 +129,33 @@ class AYPortHandler: public GI::AY38910::PortHandler {
 		};
 };
 
+/*!
+	Captures MSX CPU, chip and RAM state; cartridge mapper, SCC and disk controller
+	state is not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	TI::TMS::State vdp;
+	Intel::i8255::State ppi;
+	GI::AY38910::State ay;
+
+	std::vector<uint8_t> ram;
+	int time_until_interrupt = 0;
+	int time_since_ay_update = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(vdp);
+			DeclareField(ppi);
+			DeclareField(ay);
+			DeclareField(ram);
+			DeclareField(time_until_interrupt);
+			DeclareField(time_since_ay_update);
+		}
+	}
+};
+
 class ConcreteMachine:
 	public Machine,
 	public CPU::Z80::BusHandler,
@@ -140,7 +168,8 @@ class ConcreteMachine:
 	public Configurable::Device,
 	public MemoryMap,
 	public ClockingHint::Observer,
-	public Activity::Source {
+	public Activity::Source,
+	public MachineTypes::StateProducer {
 	public:
 		using Target = Analyser::Static::MSX::Target;
 
@@ -272,7 +301,7 @@ class ConcreteMachine:
 			audio_queue_.flush();
 		}
 
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			vdp_->set_scan_target(scan_target);
 		}
 
@@ -617,6 +646,54 @@ class ConcreteMachine:
 			return addition;
 		}
 
+		HalfCycles perform_halted_cycles(const CPU::Z80::PartialMachineCycle &cycle, int &repetitions) {
+			// Decline if fetching from this address might have side effects.
+			const uint16_t address = *cycle.address;
+			if(!read_pointers_[address >> 13] || (use_fast_tape_ && (address == 0x1a63 || address == 0x1abc))) {
+				repetitions = 0;
+				return HalfCycles(0);
+			}
+
+			// Each repetition is extended by the usual opcode-fetch wait state; fit as many as the Z80 has
+			// time for, stopping short of the next VDP interrupt.
+			const HalfCycles addition(2);
+			const HalfCycles::IntType repetition_length = (cycle.length + addition).as_integral();
+			HalfCycles::IntType count = (cycle.length.as_integral() * repetitions) / repetition_length;
+			if(time_until_interrupt_ > HalfCycles(0)) {
+				count = std::min(count, (time_until_interrupt_.as_integral() - 1) / repetition_length);
+			}
+			repetitions = int(count);
+			if(repetitions <= 0) {
+				repetitions = 0;
+				return HalfCycles(0);
+			}
+
+			const HalfCycles total_length(repetition_length * count);
+			vdp_ += total_length;
+			time_since_ay_update_ += total_length;
+			memory_slots_[0].cycles_since_update += total_length;
+			memory_slots_[1].cycles_since_update += total_length;
+			memory_slots_[2].cycles_since_update += total_length;
+			memory_slots_[3].cycles_since_update += total_length;
+			if(time_until_interrupt_ > HalfCycles(0)) {
+				time_until_interrupt_ -= total_length;
+			}
+			if(!tape_player_is_sleeping_)
+				tape_player_.run_for(int(cycle.length.as_integral() * count));
+
+			// Apply the same side effects as any other opcode fetch.
+			if(!address) {
+				pc_zero_accesses_ += repetitions;
+			}
+			if(read_pointers_[address >> 13] == unpopulated_) {
+				performed_unmapped_access_ = true;
+			}
+			pc_address_ = address;
+			*cycle.value = read_pointers_[address >> 13][address & 8191];
+
+			return HalfCycles(addition.as_integral() * count);
+		}
+
 		void flush() {
 			vdp_.flush();
 			update_audio();
@@ -661,6 +738,43 @@ class ConcreteMachine:
 			set_use_fast_tape();
 		}
 
+		// MARK: - MachineTypes::StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			flush();
+
+			auto state = std::make_unique<State>();
+			state->z80 = CPU::Z80::State(z80_);
+			state->vdp = TI::TMS::State(*vdp_.last_valid());
+			state->ppi = Intel::i8255::State(i8255_);
+			state->ay = GI::AY38910::State(ay_);
+
+			state->ram = std::vector<uint8_t>(std::begin(ram_), std::end(ram_));
+			state->time_until_interrupt = time_until_interrupt_.as<int>();
+			state->time_since_ay_update = time_since_ay_update_.as<int>();
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &str) final {
+			const auto state = dynamic_cast<const State *>(&str);
+			if(!state) return false;
+
+			flush();
+
+			state->z80.apply(z80_);
+			state->vdp.apply(*vdp_.last_valid());
+			state->ay.apply(ay_);
+
+			std::copy(state->ram.begin(), state->ram.begin() + std::min(state->ram.size(), sizeof(ram_)), std::begin(ram_));
+			time_until_interrupt_ = HalfCycles(state->time_until_interrupt);
+			time_since_ay_update_ = HalfCycles(state->time_since_ay_update);
+
+			// Applying the 8255 state reposts its outputs, restoring paging, the selected
+			// keyboard line and the tape motor.
+			state->ppi.apply(i8255_);
+			set_use_fast_tape();
+			return true;
+		}
+
 		// MARK: - Sleeper
 		void set_component_prefers_clocking(ClockingHint::Source *component, ClockingHint::Preference clocking) final {
 			tape_player_is_sleeping_ = tape_player_.preferred_clocking() == ClockingHint::Preference::None;
@@ -9,6 +9,7 @@
 #include "MasterSystem.hpp"
 
 #include "../../Processors/Z80/Z80.hpp"
+#include "../../Processors/Z80/State/State.hpp"
 
 #include "../../Components/9918/9918.hpp"
 #include "../../Components/SN76489/SN76489.hpp"
@@ -77,6 +78,38 @@ class Joystick: public Inputs::ConcreteJoystick {
 		uint8_t state_ = 0xff;
 };
 
+/*!
+	Captures Master System and SG1000 CPU, VDP, RAM and paging state; SN76489 and OPLL
+	state is not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	TI::TMS::State vdp;
+
+	std::vector<uint8_t> ram;
+	uint8_t paging_registers[3] = {0, 1, 2};
+	uint8_t memory_control = 0;
+	uint8_t io_port_control = 0x0f;
+	uint8_t opll_detection_word = 0xff;
+
+	int time_until_interrupt = 0;
+	int time_until_debounce = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(vdp);
+			DeclareField(ram);
+			DeclareField(paging_registers);
+			DeclareField(memory_control);
+			DeclareField(io_port_control);
+			DeclareField(opll_detection_word);
+			DeclareField(time_until_interrupt);
+			DeclareField(time_until_debounce);
+		}
+	}
+};
+
 class ConcreteMachine:
 	public Machine,
 	public CPU::Z80::BusHandler,
@@ -86,7 +119,8 @@ class ConcreteMachine:
 	public MachineTypes::KeyboardMachine,
 	public MachineTypes::JoystickMachine,
 	public Configurable::Device,
-	public Inputs::Keyboard::Delegate {
+	public Inputs::Keyboard::Delegate,
+	public MachineTypes::StateProducer {
 
 	public:
 		ConcreteMachine(const Analyser::Static::Sega::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
@@ -184,7 +218,7 @@ class ConcreteMachine:
 			audio_queue_.flush();
 		}
 
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			vdp_->set_tv_standard(
 				(region_ == Target::Region::Europe) ?
 					TI::TMS::TVStandard::PAL : TI::TMS::TVStandard::NTSC);
@@ -436,6 +470,47 @@ class ConcreteMachine:
 			set_video_signal_configurable(options->output);
 		}
 
+		// MARK: - MachineTypes::StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			flush();
+
+			auto state = std::make_unique<State>();
+			state->z80 = CPU::Z80::State(z80_);
+			state->vdp = TI::TMS::State(*vdp_.last_valid());
+
+			state->ram = std::vector<uint8_t>(std::begin(ram_), std::end(ram_));
+			std::copy(std::begin(paging_registers_), std::end(paging_registers_), std::begin(state->paging_registers));
+			state->memory_control = memory_control_;
+			state->io_port_control = io_port_control_;
+			state->opll_detection_word = opll_detection_word_;
+
+			state->time_until_interrupt = time_until_interrupt_.as<int>();
+			state->time_until_debounce = time_until_debounce_.as<int>();
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &str) final {
+			const auto state = dynamic_cast<const State *>(&str);
+			if(!state) return false;
+
+			flush();
+
+			state->z80.apply(z80_);
+			state->vdp.apply(*vdp_.last_valid());
+
+			std::copy(state->ram.begin(), state->ram.begin() + std::min(state->ram.size(), sizeof(ram_)), std::begin(ram_));
+			std::copy(std::begin(state->paging_registers), std::end(state->paging_registers), std::begin(paging_registers_));
+			memory_control_ = state->memory_control;
+			io_port_control_ = state->io_port_control;
+			opll_detection_word_ = state->opll_detection_word;
+			page_cartridge();
+			set_mixer_levels(opll_detection_word_);
+
+			time_until_interrupt_ = HalfCycles(state->time_until_interrupt);
+			time_until_debounce_ = HalfCycles(state->time_until_debounce);
+			return true;
+		}
+
 	private:
 		static TI::TMS::Personality tms_personality_for_model(Analyser::Static::Sega::Target::Model model) {
 			switch(model) {
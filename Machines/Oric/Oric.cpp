@@ -21,6 +21,7 @@
 #include "../Utility/StringSerialiser.hpp"
 
 #include "../../Processors/6502/6502.hpp"
+#include "../../Processors/6502/State/State.hpp"
 #include "../../Components/6522/6522.hpp"
 #include "../../Components/AY38910/AY38910.hpp"
 #include "../../Components/DiskII/DiskII.hpp"
@@ -34,7 +35,9 @@
 
 #include "../../Analyser/Static/Oric/Target.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -205,6 +208,35 @@ class VIAPortHandler: public MOS::MOS6522::IRQDelegatePortHandler {
 		Keyboard &keyboard_;
 };
 
+/*!
+	Captures Oric CPU, chip, video, paging and RAM state; disk interface and tape state
+	is not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::MOS6502::State m6502;
+	MOS::MOS6522::State via;
+	GI::AY38910::State ay;
+	VideoState video;
+
+	std::vector<uint8_t> ram;
+	uint16_t ram_top = 0xbfff;
+	bool disk_rom_is_paged = false;
+	int pravetz_rom_base_pointer = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(m6502);
+			DeclareField(via);
+			DeclareField(ay);
+			DeclareField(video);
+			DeclareField(ram);
+			DeclareField(ram_top);
+			DeclareField(disk_rom_is_paged);
+			DeclareField(pravetz_rom_base_pointer);
+		}
+	}
+};
+
 template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class ConcreteMachine:
 	public MachineTypes::TimedMachine,
 	public MachineTypes::ScanProducer,
@@ -219,7 +251,8 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 	public ClockingHint::Observer,
 	public Activity::Source,
 	public Machine,
-	public Keyboard::SpecialKeyHandler {
+	public Keyboard::SpecialKeyHandler,
+	public MachineTypes::StateProducer {
 
 	public:
 		ConcreteMachine(const Analyser::Static::Oric::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
@@ -543,7 +576,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 		}
 
 		// to satisfy CRTMachine::Machine
-		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
+		void apply_scan_target(Outputs::Display::ScanTarget *scan_target) final {
 			video_output_.set_scan_target(scan_target);
 		}
 
@@ -652,6 +685,48 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface> class Co
 			diskii_clocking_preference_ = diskii_.preferred_clocking();
 		}
 
+		// MARK: - MachineTypes::StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			flush();
+
+			auto state = std::make_unique<State>();
+			state->m6502 = CPU::MOS6502::State(m6502_);
+			state->via = MOS::MOS6522::State(via_);
+			state->ay = GI::AY38910::State(ay8910_);
+			state->video = VideoState(video_output_);
+
+			state->ram = std::vector<uint8_t>(std::begin(ram_), std::end(ram_));
+			state->ram_top = ram_top_;
+			state->disk_rom_is_paged = !disk_rom_.empty() && paged_rom_ == disk_rom_.data();
+			state->pravetz_rom_base_pointer = int(pravetz_rom_base_pointer_);
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &str) final {
+			const auto state = dynamic_cast<const State *>(&str);
+			if(!state) return false;
+
+			flush();
+
+			state->m6502.apply(m6502_);
+			state->ay.apply(ay8910_);
+			state->via.apply(via_);
+			state->video.apply(video_output_);
+
+			std::copy(state->ram.begin(), state->ram.begin() + std::min(state->ram.size(), sizeof(ram_)), std::begin(ram_));
+			if(state->disk_rom_is_paged && !disk_rom_.empty()) {
+				ram_top_ = uint16_t(0xffff - disk_rom_.size());
+				paged_rom_ = disk_rom_.data();
+			} else {
+				ram_top_ = (state->ram_top == basic_invisible_ram_top_) ? basic_invisible_ram_top_ : basic_visible_ram_top_;
+				paged_rom_ = rom_.data();
+			}
+			pravetz_rom_base_pointer_ = state->pravetz_rom_base_pointer ? 0x100 : 0x000;
+
+			set_interrupt_line();
+			return true;
+		}
+
 	private:
 		const uint16_t basic_invisible_ram_top_ = 0xffff;
 		const uint16_t basic_visible_ram_top_ = 0xbfff;
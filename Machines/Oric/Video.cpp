@@ -280,3 +280,53 @@ void VideoOutput::set_character_set_base_address() {
 	if(is_graphics_mode_) character_set_base_address_ = use_alternative_character_set_ ? 0x9c00 : 0x9800;
 	else character_set_base_address_ = use_alternative_character_set_ ? 0xb800 : 0xb400;
 }
+
+// MARK: - State
+
+VideoState::VideoState() {
+	if(needs_declare()) {
+		DeclareField(counter);
+		DeclareField(frame_counter);
+		DeclareField(counter_period);
+		DeclareField(ink);
+		DeclareField(paper);
+		DeclareField(is_graphics_mode);
+		DeclareField(next_frame_is_sixty_hertz);
+		DeclareField(use_alternative_character_set);
+		DeclareField(use_double_height_characters);
+		DeclareField(blink_text);
+	}
+}
+
+VideoState::VideoState(const VideoOutput &src) : VideoState() {
+	counter = src.counter_;
+	frame_counter = src.frame_counter_;
+	counter_period = src.counter_period_;
+
+	ink = src.ink_;
+	paper = src.paper_;
+	is_graphics_mode = src.is_graphics_mode_;
+	next_frame_is_sixty_hertz = src.next_frame_is_sixty_hertz_;
+	use_alternative_character_set = src.use_alternative_character_set_;
+	use_double_height_characters = src.use_double_height_characters_;
+	blink_text = src.blink_text_;
+}
+
+void VideoState::apply(VideoOutput &target) const {
+	// Accept only the two sets of frame timing that the Oric can produce.
+	const bool is_sixty_hertz = counter_period == int(PAL60Period);
+	target.v_sync_start_position_ = is_sixty_hertz ? PAL60VSyncStartPosition : PAL50VSyncStartPosition;
+	target.v_sync_end_position_ = is_sixty_hertz ? PAL60VSyncEndPosition : PAL50VSyncEndPosition;
+	target.counter_period_ = is_sixty_hertz ? PAL60Period : PAL50Period;
+	target.counter_ = counter % target.counter_period_;
+	target.frame_counter_ = frame_counter;
+
+	target.ink_ = ink;
+	target.paper_ = paper;
+	target.is_graphics_mode_ = is_graphics_mode;
+	target.next_frame_is_sixty_hertz_ = next_frame_is_sixty_hertz;
+	target.use_alternative_character_set_ = use_alternative_character_set;
+	target.use_double_height_characters_ = use_double_height_characters;
+	target.blink_text_ = blink_text;
+	target.set_character_set_base_address();
+}
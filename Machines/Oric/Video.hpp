@@ -11,6 +11,7 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -18,6 +19,8 @@
 
 namespace Oric {
 
+struct VideoState;
+
 class VideoOutput {
 	public:
 		VideoOutput(uint8_t *memory);
@@ -61,6 +64,32 @@ class VideoOutput {
 		bool use_alternative_character_set_;
 		bool use_double_height_characters_;
 		bool blink_text_;
+
+		friend struct VideoState;
+};
+
+/*!
+	Provides a means for capturing or restoring complete VideoOutput state, other
+	than that of the CRT.
+*/
+struct VideoState: public Reflection::StructImpl<VideoState> {
+	int counter = 0, frame_counter = 0;
+	int counter_period = 0;
+
+	uint8_t ink = 0, paper = 0;
+	bool is_graphics_mode = false;
+	bool next_frame_is_sixty_hertz = false;
+	bool use_alternative_character_set = false;
+	bool use_double_height_characters = false;
+	bool blink_text = false;
+
+	VideoState();
+
+	/// Instantiates a new VideoState based on the VideoOutput @c src.
+	VideoState(const VideoOutput &src);
+
+	/// Applies this state to @c target.
+	void apply(VideoOutput &target) const;
 };
 
 }
@@ -28,7 +28,29 @@ class ScanProducer {
 			The @c scan_target will receive all video output; the caller guarantees
 			that it is non-null.
 		*/
-		virtual void set_scan_target(Outputs::Display::ScanTarget *scan_target) = 0;
+		void set_scan_target(Outputs::Display::ScanTarget *scan_target) {
+			scan_target_ = scan_target;
+			apply_scan_target(scan_output_enabled_ ? scan_target_ : &Outputs::Display::NullScanTarget::singleton);
+		}
+
+		/*!
+			Enables or disables video output. While output is disabled the machine continues to
+			keep video timing but is attached to a null scan target, so generates no pixels and
+			posts no scans; the scan target most recently supplied via @c set_scan_target
+			is reattached when output is reenabled.
+		*/
+		void set_scan_output_enabled(bool enabled) {
+			if(scan_output_enabled_ == enabled) return;
+			scan_output_enabled_ = enabled;
+			set_scan_target(scan_target_);
+		}
+
+		/*!
+			@returns @c true if video output is enabled; @c false otherwise.
+		*/
+		bool get_scan_output_enabled() const {
+			return scan_output_enabled_;
+		}
 
 		/*!
 			@returns The current scan status.
@@ -41,6 +63,12 @@ class ScanProducer {
 		}
 
 	protected:
+		/*!
+			Directs all video output to @c scan_target, performing any other display and speaker
+			setup as per @c set_scan_target.
+		*/
+		virtual void apply_scan_target(Outputs::Display::ScanTarget *scan_target) = 0;
+
 		virtual Outputs::Display::ScanStatus get_scaled_scan_status() const {
 			// This deliberately sets up an infinite loop if the user hasn't
 			// overridden at least one of this or get_scan_status.
@@ -97,6 +125,10 @@ class ScanProducer {
 			Gets the display type.
 		*/
 		virtual Outputs::Display::DisplayType get_display_type() const { return Outputs::Display::DisplayType::RGB; }
+
+	private:
+		Outputs::Display::ScanTarget *scan_target_ = nullptr;
+		bool scan_output_enabled_ = true;
 };
 
 }
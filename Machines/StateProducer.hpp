@@ -0,0 +1,44 @@
+//
+//  StateProducer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef StateProducer_h
+#define StateProducer_h
+
+#include "../Reflection/Struct.hpp"
+
+#include <memory>
+
+namespace MachineTypes {
+
+/*!
+	A StateProducer is any machine that can capture a snapshot of its complete state, and
+	can later be returned to that state.
+
+	Snapshots are reflective structs, so may be serialised. To restore from a serialisation,
+	obtain a struct of the proper type via @c get_state, deserialise into it and pass it to
+	@c set_state.
+
+	Snapshots are intended to be applied to a machine constructed from the same target and ROMs
+	as that which produced them; media contents are not included.
+*/
+class StateProducer {
+	public:
+		/// @returns A snapshot of the machine's current state.
+		virtual std::unique_ptr<Reflection::Struct> get_state() = 0;
+
+		/*!
+			Returns the machine to @c state.
+
+			@returns @c true if the state was applied; @c false if it was not of a type this machine understands.
+		*/
+		virtual bool set_state(const Reflection::Struct &state) = 0;
+};
+
+}
+
+#endif /* StateProducer_h */
@@ -0,0 +1,31 @@
+//
+//  TimedMachine.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+// ScanProducer.hpp uses TimedMachine, so includes TimedMachine.hpp itself and must come first.
+#include "AudioProducer.hpp"
+#include "ScanProducer.hpp"
+#include "TimedMachine.hpp"
+
+using namespace MachineTypes;
+
+void TimedMachine::set_output_enabled(bool enabled) {
+	output_enabled_ = enabled;
+
+	auto scan_producer = dynamic_cast<ScanProducer *>(this);
+	if(scan_producer) {
+		scan_producer->set_scan_output_enabled(enabled);
+	}
+
+	auto audio_producer = dynamic_cast<AudioProducer *>(this);
+	if(!audio_producer) return;
+
+	auto speaker = audio_producer->get_speaker();
+	if(speaker) {
+		speaker->set_output_enabled(enabled);
+	}
+}
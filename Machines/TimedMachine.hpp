@@ -57,6 +57,34 @@ class TimedMachine {
 			return speed_multiplier_;
 		}
 
+		/*!
+			Enables or disables all audio and video output. With output disabled the machine runs
+			exactly as it otherwise would, but its display and speaker merely consume time rather
+			than generating pixels or filtering audio. This is intended for skipping through
+			boot sequences and seeking, either of which can be combined with a speed multiplier.
+		*/
+		virtual void set_output_enabled(bool enabled);
+
+		/*!
+			@returns @c true if output is enabled; @c false otherwise.
+		*/
+		bool get_output_enabled() const {
+			return output_enabled_;
+		}
+
+		/*!
+			Permits or prohibits this machine from trading timing precision for speed, e.g. by executing
+			instructions that touch only ordinary memory without updating the rest of the machine until
+			each has finished. Software that depends on exact timing may then misbehave. Machines that
+			offer no such trade ignore this; all machines begin with exact timing.
+		*/
+		virtual void set_approximate_timing_enabled(bool) {}
+
+		/// @returns This machine's clock rate, i.e. the number of @c Cycles it runs per emulated second.
+		double get_clock_rate() const {
+			return clock_rate_;
+		}
+
 		/// @returns The confidence that this machine is running content it understands.
 		virtual float get_confidence() { return 0.5f; }
 		virtual std::string debug_type() { return ""; }
@@ -70,18 +98,11 @@ class TimedMachine {
 			clock_rate_ = clock_rate;
 		}
 
-		/// Gets this machine's clock rate.
-		double get_clock_rate() const {
-			return clock_rate_;
-		}
-
 	private:
-		// Give the ScanProducer access to this machine's clock rate.
-		friend class ScanProducer;
-
 		double clock_rate_ = 1.0;
 		double clock_conversion_error_ = 0.0;
 		double speed_multiplier_ = 1.0;
+		bool output_enabled_ = true;
 };
 
 }
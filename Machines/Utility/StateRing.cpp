@@ -0,0 +1,241 @@
+//
+//  StateRing.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "StateRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace Machine;
+
+namespace {
+
+/// Describes the data of a BSON binary field, and the dotted path of its name.
+struct Binary {
+	size_t start, length;
+	std::string path;
+};
+
+uint32_t read_int32(const std::vector<uint8_t> &bson, size_t offset) {
+	return
+		uint32_t(bson[offset]) |
+		(uint32_t(bson[offset + 1]) << 8) |
+		(uint32_t(bson[offset + 2]) << 16) |
+		(uint32_t(bson[offset + 3]) << 24);
+}
+
+/*!
+	Appends to @c binaries all binary fields of the BSON document that begins at @c offset
+	within @c bson, recursing into subdocuments and arrays.
+
+	@returns @c true if the document was well-formed; @c false otherwise.
+*/
+bool find_binaries(const std::vector<uint8_t> &bson, size_t offset, const std::string &path, std::vector<Binary> &binaries) {
+	if(offset + 5 > bson.size()) return false;
+	const size_t end = offset + read_int32(bson, offset);
+	if(end > bson.size() || end < offset + 5) return false;
+	offset += 4;
+
+	while(true) {
+		if(offset >= end) return false;
+		const uint8_t type = bson[offset++];
+		if(!type) return offset == end;
+
+		const auto name_end = std::find(bson.begin() + long(offset), bson.begin() + long(end), 0);
+		if(name_end == bson.begin() + long(end)) return false;
+		const std::string name = path + std::string(bson.begin() + long(offset), name_end) + ".";
+		offset = size_t(name_end - bson.begin()) + 1;
+
+		size_t length;
+		switch(type) {
+			default: return false;
+
+			case 0x01:	length = 8;	break;		// Double.
+			case 0x08:	length = 1;	break;		// Boolean.
+			case 0x10:	length = 4;	break;		// Int32.
+			case 0x12:	length = 8;	break;		// Int64.
+
+			case 0x02:							// String.
+				if(offset + 4 > end) return false;
+				length = 4 + read_int32(bson, offset);
+			break;
+
+			case 0x03:							// Subdocument.
+			case 0x04:							// Array.
+				if(!find_binaries(bson, offset, name, binaries)) return false;
+				length = read_int32(bson, offset);
+			break;
+
+			case 0x05:							// Binary: length, subtype, data.
+				if(offset + 5 > end) return false;
+				length = 5 + read_int32(bson, offset);
+				if(offset + length > end) return false;
+				binaries.push_back(Binary{offset + 5, length - 5, name});
+			break;
+		}
+
+		offset += length;
+	}
+}
+
+}
+
+StateRing::StateRing(DynamicMachine &machine, size_t capacity) : machine_(machine), capacity_(std::max(capacity, size_t(1))) {}
+
+bool StateRing::is_supported() const {
+	return machine_.state_producer() && machine_.timed_machine();
+}
+
+Time::Seconds StateRing::frame_duration() const {
+	// Use the CRT's current estimate of field duration if there is one; otherwise
+	// assume a 50Hz display.
+	const auto scan_producer = machine_.scan_producer();
+	if(scan_producer) {
+		const auto duration = scan_producer->get_scan_status().field_duration;
+		if(duration > 0.0) return duration;
+	}
+	return 1.0 / 50.0;
+}
+
+void StateRing::run_for(Time::Seconds duration) {
+	const auto timed_machine = machine_.timed_machine();
+	if(!timed_machine) return;
+
+	if(!is_supported()) {
+		timed_machine->run_for(duration);
+		return;
+	}
+
+	while(duration > 0.0) {
+		const Time::Seconds step = std::min(duration, time_until_capture_);
+		if(step > 0.0) {
+			timed_machine->run_for(step);
+			duration -= step;
+			time_until_capture_ -= step;
+		}
+
+		if(time_until_capture_ <= 0.0) {
+			capture();
+			time_until_capture_ += frame_duration();
+		}
+	}
+}
+
+void StateRing::capture() {
+	const auto state_producer = machine_.state_producer();
+	if(!state_producer) return;
+
+	const auto state = state_producer->get_state();
+	if(!state) return;
+	const auto bson = state->serialise();
+
+	// Locate all binary fields; if the serialisation can't be followed then it is all paged
+	// as if it were a single undifferentiated run.
+	std::vector<Binary> binaries;
+	if(!find_binaries(bson, 0, "", binaries)) {
+		binaries.clear();
+	}
+
+	// Recycle the oldest snapshot's storage if the ring is full.
+	Snapshot snapshot;
+	if(snapshots_.size() == capacity_) {
+		snapshot = std::move(snapshots_.front());
+		snapshots_.pop_front();
+	}
+	snapshot.pages.clear();
+	snapshot.keys.clear();
+	snapshot.size = bson.size();
+
+	std::unordered_map<std::string, std::shared_ptr<const Page>> previous;
+	if(!snapshots_.empty()) {
+		const Snapshot &last = snapshots_.back();
+		for(size_t page = 0; page < last.pages.size(); ++page) {
+			previous.emplace(last.keys[page], last.pages[page]);
+		}
+	}
+
+	// Pages the range [start, end) of the BSON, each page's key being @c prefix plus its index.
+	const auto add_pages = [&] (size_t start, size_t end, const std::string &prefix) {
+		for(size_t index = 0; start < end; ++index) {
+			const size_t length = std::min(PageSize, end - start);
+			const uint8_t *const source = &bson[start];
+			std::string key = prefix + std::to_string(index);
+
+			// Share with the previous snapshot if nothing has changed.
+			const auto candidate = previous.find(key);
+			if(
+				candidate != previous.end() &&
+				candidate->second->size() == length &&
+				!std::memcmp(candidate->second->data(), source, length)
+			) {
+				snapshot.pages.push_back(candidate->second);
+			} else {
+				snapshot.pages.push_back(std::make_shared<const Page>(source, source + length));
+			}
+			snapshot.keys.push_back(std::move(key));
+
+			start += length;
+		}
+	};
+
+	size_t cursor = 0, run = 0;
+	for(const auto &binary: binaries) {
+		add_pages(cursor, binary.start, "#" + std::to_string(run++) + ":");
+		add_pages(binary.start, binary.start + binary.length, binary.path);
+		cursor = binary.start + binary.length;
+	}
+	add_pages(cursor, bson.size(), "#" + std::to_string(run) + ":");
+
+	snapshots_.push_back(std::move(snapshot));
+}
+
+bool StateRing::restore(size_t snapshots_back) {
+	const auto state_producer = machine_.state_producer();
+	if(!state_producer || snapshots_back >= snapshots_.size()) return false;
+
+	snapshots_.resize(snapshots_.size() - snapshots_back);
+	const Snapshot &snapshot = snapshots_.back();
+
+	scratch_.clear();
+	scratch_.reserve(snapshot.size);
+	for(const auto &page: snapshot.pages) {
+		scratch_.insert(scratch_.end(), page->begin(), page->end());
+	}
+
+	auto state = state_producer->get_state();
+	if(!state || !state->deserialise(scratch_) || !state_producer->set_state(*state)) {
+		return false;
+	}
+
+	time_until_capture_ = frame_duration();
+	return true;
+}
+
+size_t StateRing::size() const {
+	return snapshots_.size();
+}
+
+void StateRing::clear() {
+	snapshots_.clear();
+	time_until_capture_ = 0.0;
+}
+
+size_t StateRing::memory_usage() const {
+	size_t total = 0;
+	std::unordered_set<const Page *> counted;
+	for(const auto &snapshot: snapshots_) {
+		for(const auto &page: snapshot.pages) {
+			if(counted.insert(page.get()).second) {
+				total += page->size();
+			}
+		}
+	}
+	return total;
+}
@@ -0,0 +1,102 @@
+//
+//  StateRing.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef StateRing_hpp
+#define StateRing_hpp
+
+#include "../DynamicMachine.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Maintains a bounded ring of machine snapshots, captured once per emulated frame, to
+	support rewind and rollback-style input correction.
+
+	Each snapshot is stored as its BSON serialisation, divided into pages. Each binary field —
+	i.e. each RAM or similar buffer — is paged from its own start, and each page is identified by
+	the field's name and its offset within that field, so that it remains comparable regardless of
+	any change in length elsewhere in the serialisation; everything else is paged in between. Any
+	page that is byte-identical to the page of the same identity in the previous snapshot is shared
+	with it rather than copied, so the marginal cost of a snapshot is only those pages that changed
+	during the frame — typically a small fraction of RAM.
+
+	Restoring is a single reassembly, deserialisation and @c set_state, with no emulation
+	involved, so completes well within a frame.
+*/
+class StateRing {
+	public:
+		/// The maximum size of the unit of sharing between adjacent snapshots.
+		static constexpr size_t PageSize = 1024;
+
+		/*!
+			Creates a ring that will hold at most @c capacity snapshots of @c machine, which
+			must outlive it.
+		*/
+		StateRing(DynamicMachine &machine, size_t capacity);
+
+		/// @returns @c true if @c machine is able to produce state; if not then this ring will remain empty.
+		bool is_supported() const;
+
+		/*!
+			Runs the machine for @c duration, capturing a snapshot at each frame boundary
+			encountered. Frame boundaries are predicted from the machine's current field duration.
+		*/
+		void run_for(Time::Seconds duration);
+
+		/*!
+			Captures a snapshot of the machine's current state now, discarding the
+			oldest if the ring is full.
+		*/
+		void capture();
+
+		/*!
+			Returns the machine to the snapshot @c snapshots_back before the most recent,
+			i.e. 0 restores the most recent snapshot. All newer snapshots are discarded, so
+			that emulation may proceed from that point.
+
+			@returns @c true if the state was restored; @c false otherwise.
+		*/
+		bool restore(size_t snapshots_back = 0);
+
+		/// @returns The number of snapshots currently held.
+		size_t size() const;
+
+		/// Discards all snapshots.
+		void clear();
+
+		/// @returns The total number of bytes of page storage currently held, counting shared pages once.
+		size_t memory_usage() const;
+
+	private:
+		DynamicMachine &machine_;
+		const size_t capacity_;
+
+		using Page = std::vector<uint8_t>;
+		struct Snapshot {
+			std::vector<std::shared_ptr<const Page>> pages;
+			std::vector<std::string> keys;	// The identity of each page, for comparison with the next snapshot.
+			size_t size = 0;
+		};
+		std::deque<Snapshot> snapshots_;
+
+		Time::Seconds time_until_capture_ = 0.0;
+		std::vector<uint8_t> scratch_;
+
+		Time::Seconds frame_duration() const;
+};
+
+}
+
+#endif /* StateRing_hpp */
@@ -481,4 +481,14 @@ class CPU::MC68000::ProcessorStorageTests {
 //	XCTAssert(!falseInvalids.count, "%@ opcodes should be valid but aren't: %@", @(falseInvalids.count), falseInvalids.hexDump);
 }
 
+- (void)testConstructionPerformance {
+	// Decode tables are generated once per process and then shared, so constructing
+	// a processor should cost little more than a copy of its bus steps.
+	[self measureBlock:^{
+		for(int c = 0; c < 100; ++c) {
+			const auto machine = std::make_unique<RAM68000>();
+		}
+	}];
+}
+
 @end
@@ -0,0 +1,68 @@
+//
+//  LowpassSpeakerTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/SampleSource.hpp"
+
+#include <vector>
+
+namespace {
+
+/// Produces a constant level, so that every filtered output should be close to that level.
+struct ConstantSource: public Outputs::Speaker::SampleSource {
+	static constexpr int16_t Level = 10000;
+
+	void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+		std::fill(target, target + number_of_samples, Level);
+	}
+};
+
+struct Collector: public Outputs::Speaker::Speaker::Delegate {
+	std::vector<int16_t> samples;
+
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+		samples.insert(samples.end(), buffer.begin(), buffer.end());
+	}
+};
+
+}
+
+@interface LowpassSpeakerTests : XCTestCase
+@end
+
+@implementation LowpassSpeakerTests
+
+/// Alternates the output rate mid-stream, so that the filter window changes size while partway along
+/// the input buffer, and checks that output continues at the input level throughout.
+- (void)testOutputRateChange {
+	ConstantSource source;
+	Outputs::Speaker::LowpassSpeaker<ConstantSource> speaker(source);
+	Concurrency::DeferringAsyncTaskQueue queue;
+	Collector collector;
+
+	speaker.set_input_rate(1000000.0f);
+	speaker.set_delegate(&collector);
+
+	for(int c = 0; c < 16; c++) {
+		speaker.set_output_rate((c & 1) ? 48000.0f : 11025.0f, 256, false);
+		for(int r = 0; r < 20; r++) {
+			speaker.run_for(queue, Cycles(997));
+		}
+		queue.perform();
+		queue.flush();
+	}
+
+	XCTAssertGreaterThan(collector.samples.size(), 512);
+	for(const auto sample: collector.samples) {
+		XCTAssertEqualWithAccuracy(sample, ConstantSource::Level, ConstantSource::Level / 20);
+	}
+}
+
+@end
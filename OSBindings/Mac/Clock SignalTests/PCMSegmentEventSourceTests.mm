@@ -99,4 +99,27 @@
 	XCTAssertTrue(next_event.type == Storage::Disk::Track::Event::IndexHole, @"End should have been reached");
 }
 
+
+- (void)testGapsAcrossWords {
+	// Place transitions either side of several 64-bit word boundaries, then rotate them.
+	Storage::Disk::PCMSegment segment;
+	segment.length_of_a_bit = Storage::Time(1, 10);
+	segment.data.resize(200);
+	segment.data[0] = segment.data[63] = segment.data[64] = segment.data[190] = true;
+	segment.rotate_right(5);
+
+	Storage::Disk::PCMSegmentEventSource source(segment);
+	const unsigned int expected_lengths[] = {11, 126, 2, 252};
+	for(const auto expected_length: expected_lengths) {
+		Storage::Disk::Track::Event event = source.get_next_event();
+		event.length.simplify();
+
+		Storage::Time expected(expected_length, 20u);
+		expected.simplify();
+		XCTAssertTrue(event.length == expected, @"Event should be %u/20ths long; was %u/%u", expected_length, event.length.length, event.length.clock_rate);
+	}
+
+	XCTAssertTrue(source.get_next_event().type == Storage::Disk::Track::Event::IndexHole, @"End should have been reached");
+}
+
 @end
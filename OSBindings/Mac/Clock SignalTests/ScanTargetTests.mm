@@ -0,0 +1,214 @@
+//
+//  ScanTargetTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <OpenGL/OpenGL.h>
+
+#include "../../../Outputs/OpenGL/ScanTarget.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using ScanTarget = Outputs::Display::ScanTarget;
+
+constexpr int OutputWidth = 320;
+constexpr int OutputHeight = 240;
+
+constexpr int LinesPerFrame = 64;
+constexpr int ScansPerLine = 16;
+constexpr int SamplesPerScan = 16;
+
+ScanTarget::Modals test_modals() {
+	ScanTarget::Modals modals;
+	modals.input_data_type = Outputs::Display::InputDataType::Red8Green8Blue8;
+	modals.display_type = Outputs::Display::DisplayType::RGB;
+	modals.composite_colour_space = Outputs::Display::ColourSpace::YIQ;
+	modals.cycles_per_line = ScansPerLine * SamplesPerScan;
+	modals.clocks_per_pixel_greatest_common_divisor = 1;
+	modals.colour_cycle_numerator = 1;
+	modals.colour_cycle_denominator = 1;
+	modals.expected_vertical_lines = LinesPerFrame;
+	modals.output_scale.x = modals.output_scale.y = 1024;
+	return modals;
+}
+
+/*!
+	Provides @c frames frames of output to @c target in the manner of a CRT, sleeping for @c frame_delay
+	before each. Every line is a run of scans of a single colour: red and green are derived from the
+	frame number and blue from the line number. Anything the target declines to allocate is skipped.
+*/
+void produce(ScanTarget &target, int first_frame, int frames, std::chrono::microseconds frame_delay) {
+	for(int frame = first_frame; frame < first_frame + frames; ++frame) {
+		std::this_thread::sleep_for(frame_delay);
+
+		const ScanTarget::Scan::EndPoint origin{0, 0, 0, 0, 0};
+		target.announce(ScanTarget::Event::BeginVerticalRetrace, false, origin, 0);
+		target.announce(ScanTarget::Event::EndVerticalRetrace, false, origin, 0);
+
+		for(int line = 0; line < LinesPerFrame; ++line) {
+			const uint16_t y = uint16_t(line * 16 + 8);
+			target.announce(ScanTarget::Event::EndHorizontalRetrace, true, ScanTarget::Scan::EndPoint{0, y, 0, 0, 0}, 0);
+
+			for(int scan_index = 0; scan_index < ScansPerLine; ++scan_index) {
+				uint8_t *const data = target.begin_data(SamplesPerScan, 1);
+				if(data) {
+					for(int sample = 0; sample < SamplesPerScan; ++sample) {
+						data[sample*4 + 0] = uint8_t(frame);
+						data[sample*4 + 1] = uint8_t(255 - frame);
+						data[sample*4 + 2] = uint8_t(line * 4);
+						data[sample*4 + 3] = 0xff;
+					}
+					target.end_data(SamplesPerScan);
+				}
+
+				ScanTarget::Scan *const scan = target.begin_scan();
+				if(scan) {
+					scan->end_points[0] = ScanTarget::Scan::EndPoint{
+						uint16_t(scan_index * 1024 / ScansPerLine), y,
+						0, 0,
+						uint16_t(scan_index * SamplesPerScan)};
+					scan->end_points[1] = ScanTarget::Scan::EndPoint{
+						uint16_t((scan_index + 1) * 1024 / ScansPerLine), y,
+						SamplesPerScan, 0,
+						uint16_t((scan_index + 1) * SamplesPerScan)};
+					scan->composite_amplitude = 0;
+					target.end_scan();
+				}
+			}
+
+			target.announce(
+				ScanTarget::Event::BeginHorizontalRetrace, false,
+				ScanTarget::Scan::EndPoint{1024, y, 0, 0, uint16_t(ScansPerLine * SamplesPerScan)}, 0);
+		}
+	}
+}
+
+/// @returns The number of rows of @c pixels in which the centre 80% isn't a single colour.
+int nonuniform_rows(const std::vector<uint8_t> &pixels) {
+	int result = 0;
+	for(int y = 0; y < OutputHeight; ++y) {
+		const uint8_t *const row = &pixels[size_t(y * OutputWidth * 4)];
+		const uint8_t *const centre = &row[(OutputWidth / 2) * 4];
+		for(int x = OutputWidth / 10; x < OutputWidth - OutputWidth / 10; ++x) {
+			if(
+				abs(row[x*4 + 0] - centre[0]) > 2 ||
+				abs(row[x*4 + 1] - centre[1]) > 2 ||
+				abs(row[x*4 + 2] - centre[2]) > 2
+			) {
+				++result;
+				break;
+			}
+		}
+	}
+	return result;
+}
+
+}
+
+@interface ScanTargetTests : XCTestCase
+@end
+
+@implementation ScanTargetTests {
+	NSOpenGLContext *_openGLContext;
+	GLuint _texture, _framebuffer;
+}
+
+- (void)setUp {
+	[super setUp];
+
+	// Create a valid OpenGL context, and a framebuffer for the scan target to draw to.
+	NSOpenGLPixelFormatAttribute attributes[] = {
+		NSOpenGLPFAOpenGLProfile,	NSOpenGLProfileVersion3_2Core,
+		0
+	};
+
+	NSOpenGLPixelFormat *pixelFormat = [[NSOpenGLPixelFormat alloc] initWithAttributes:attributes];
+	_openGLContext = [[NSOpenGLContext alloc] initWithFormat:pixelFormat shareContext:nil];
+	[_openGLContext makeCurrentContext];
+
+	glGenTextures(1, &_texture);
+	glBindTexture(GL_TEXTURE_2D, _texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, OutputWidth, OutputHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+	glGenFramebuffers(1, &_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture, 0);
+}
+
+- (void)tearDown {
+	glDeleteFramebuffers(1, &_framebuffer);
+	glDeleteTextures(1, &_texture);
+	_openGLContext = nil;
+
+	[super tearDown];
+}
+
+- (std::vector<uint8_t>)pixels {
+	std::vector<uint8_t> pixels(size_t(OutputWidth * OutputHeight * 4));
+	glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+	glReadPixels(0, 0, OutputWidth, OutputHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	return pixels;
+}
+
+/// Runs a CRT-style producer on one thread against update() and draw() on this one. If a scan
+/// were published before its data, or data were overwritten before being consumed, some line
+/// would end up composed from more than one colour.
+- (void)testConcurrentHandoff {
+	Outputs::Display::OpenGL::ScanTarget target(_framebuffer);
+	static_cast<ScanTarget &>(target).set_modals(test_modals());
+
+	std::atomic<bool> producer_is_finished(false);
+	std::thread producer([&target, &producer_is_finished] {
+		// Alternate between bursts that outrun the consumer, so that allocation
+		// fails and is rolled back, and a steadier pace.
+		for(int burst = 0; burst < 10; ++burst) {
+			produce(target, burst * 200, 100, std::chrono::microseconds(0));
+			produce(target, burst * 200 + 100, 100, std::chrono::microseconds(500));
+		}
+		producer_is_finished = true;
+	});
+
+	int updates = 0;
+	while(!producer_is_finished) {
+		target.update(OutputWidth, OutputHeight);
+		target.draw(OutputWidth, OutputHeight);
+		++updates;
+
+		XCTAssertEqual(nonuniform_rows([self pixels]), 0, @"Output was inconsistent after %d updates", updates);
+	}
+	producer.join();
+	XCTAssertGreaterThan(updates, 1, @"Producer and consumer didn't overlap");
+
+	// Finish with a few frames of a known colour, drawn in lockstep so that the output
+	// settles upon it: red and green constant, blue descending towards the bottom of the
+	// framebuffer, which is the top of the display.
+	for(int frame = 0; frame < 8; ++frame) {
+		produce(target, 0, 1, std::chrono::microseconds(0));
+		target.update(OutputWidth, OutputHeight);
+		target.draw(OutputWidth, OutputHeight);
+	}
+
+	const auto pixels = [self pixels];
+	XCTAssertEqual(nonuniform_rows(pixels), 0);
+
+	int previous_blue = 256;
+	for(int y = 0; y < OutputHeight; ++y) {
+		const uint8_t *const centre = &pixels[size_t((y * OutputWidth + OutputWidth / 2) * 4)];
+		XCTAssertLessThan(centre[0], 10, @"Red was %d in row %d", centre[0], y);
+		XCTAssertGreaterThan(centre[1], 245, @"Green was %d in row %d", centre[1], y);
+		XCTAssertLessThanOrEqual(centre[2], previous_blue, @"Blue increased to %d in row %d", centre[2], y);
+		previous_blue = centre[2];
+	}
+}
+
+@end
@@ -0,0 +1,111 @@
+//
+//  StateRingTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Utility/StateRing.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+/// A state with a field of varying length ahead of a large buffer, as per a typical machine.
+struct TestState: public Reflection::StructImpl<TestState> {
+	std::string phase;
+	std::vector<uint8_t> ram;
+
+	TestState() {
+		if(needs_declare()) {
+			DeclareField(phase);
+			DeclareField(ram);
+		}
+	}
+};
+
+/// A machine that consists only of state.
+class TestMachine: public Machine::DynamicMachine, public MachineTypes::StateProducer {
+	public:
+		std::string phase;
+		std::vector<uint8_t> ram = std::vector<uint8_t>(64 * 1024);
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<TestState>();
+			state->phase = phase;
+			state->ram = ram;
+			return state;
+		}
+
+		bool set_state(const Reflection::Struct &state) final {
+			const auto test_state = dynamic_cast<const TestState *>(&state);
+			if(!test_state) return false;
+			phase = test_state->phase;
+			ram = test_state->ram;
+			return true;
+		}
+
+		Activity::Source *activity_source() final				{ return nullptr; }
+		Configurable::Device *configurable_device() final		{ return nullptr; }
+		MachineTypes::TimedMachine *timed_machine() final		{ return nullptr; }
+		MachineTypes::ScanProducer *scan_producer() final		{ return nullptr; }
+		MachineTypes::AudioProducer *audio_producer() final		{ return nullptr; }
+		MachineTypes::JoystickMachine *joystick_machine() final	{ return nullptr; }
+		MachineTypes::KeyboardMachine *keyboard_machine() final	{ return nullptr; }
+		MachineTypes::MouseMachine *mouse_machine() final		{ return nullptr; }
+		MachineTypes::MediaTarget *media_target() final			{ return nullptr; }
+		MachineTypes::StateProducer *state_producer() final		{ return this; }
+		void *raw_pointer() final								{ return this; }
+};
+
+}
+
+@interface StateRingTests : XCTestCase
+@end
+
+@implementation StateRingTests
+
+/// Captures twice with unchanged RAM but a change in length of the field ahead of it; all of RAM should be shared.
+- (void)testUnchangedRAMIsShared {
+	TestMachine machine;
+	for(size_t c = 0; c < machine.ram.size(); ++c) machine.ram[c] = uint8_t(c * 7 + (c >> 8));
+
+	Machine::StateRing ring(machine, 8);
+	machine.phase = "Operation";
+	ring.capture();
+	const size_t first_usage = ring.memory_usage();
+	XCTAssertGreaterThan(first_usage, machine.ram.size());
+
+	machine.phase = "FetchDecode";
+	ring.capture();
+	XCTAssertEqual(ring.size(), 2);
+	XCTAssertLessThan(ring.memory_usage(), first_usage + Machine::StateRing::PageSize);
+
+	// A single modified byte should cost no more than a page.
+	machine.ram[40000] ^= 0xff;
+	const size_t second_usage = ring.memory_usage();
+	ring.capture();
+	XCTAssertLessThanOrEqual(ring.memory_usage(), second_usage + 2 * Machine::StateRing::PageSize);
+
+	// Each snapshot should nevertheless restore exactly.
+	const auto modified_ram = machine.ram;
+	machine.ram.assign(machine.ram.size(), 0);
+	XCTAssert(ring.restore(0));
+	XCTAssert(machine.ram == modified_ram);
+	XCTAssertEqual(machine.phase, "FetchDecode");
+
+	XCTAssert(ring.restore(1));
+	machine.ram[40000] ^= 0xff;
+	XCTAssert(machine.ram == modified_ram);
+	XCTAssertEqual(machine.phase, "FetchDecode");
+
+	XCTAssert(ring.restore(1));
+	XCTAssertEqual(machine.phase, "Operation");
+	XCTAssertEqual(ring.size(), 1);
+}
+
+@end
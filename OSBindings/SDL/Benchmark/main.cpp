@@ -0,0 +1,490 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+
+#include "../../../Machines/Utility/MachineForTarget.hpp"
+
+#include "../../../ClockReceiver/TimeTypes.hpp"
+
+#include "../../../Machines/MachineTypes.hpp"
+
+#include "../../../Outputs/ScanTarget.hpp"
+
+#include "../../../Processors/6502/AllRAM/6502AllRAM.hpp"
+#include "../../../Processors/Z80/AllRAM/Z80AllRAM.hpp"
+#include "../../../Processors/68000/68000.hpp"
+
+/*
+	Measures emulation throughput, writing the results to stdout as a single JSON object.
+
+	Each machine that doesn't require media is constructed from its default target, attached
+	to a null scan target and run for a fixed emulated period; the 6502, Z80 and 68000 cores
+	are each run separately against flat RAM on a fixed synthetic workload. Every measurement
+	is repeated and the median kept, so that results are stable enough to gate on.
+*/
+
+namespace {
+
+struct ParsedArguments {
+	std::map<std::string, std::string> selections;	// The empty string will be inserted for arguments without an = suffix.
+
+	/// @returns The value of the selection @c name parsed as a positive double, or @c default_value if absent or malformed.
+	double positive_double(const std::string &name, double default_value) const {
+		const auto argument = selections.find(name);
+		if(argument == selections.end()) return default_value;
+
+		const char *string = argument->second.c_str();
+		char *end;
+		const double value = strtod(string, &end);
+		if(size_t(end - string) != strlen(string) || value <= 0.0) {
+			std::cerr << "Unable to parse " << name << ": " << string << "; using " << default_value << std::endl;
+			return default_value;
+		}
+		return value;
+	}
+
+	bool has(const std::string &name) const {
+		return selections.find(name) != selections.end();
+	}
+};
+
+ParsedArguments parse_arguments(int argc, char *argv[]) {
+	ParsedArguments arguments;
+
+	for(int index = 1; index < argc; ++index) {
+		char *arg = argv[index];
+		while(*arg == '-') arg++;
+
+		std::string argument = arg;
+		std::size_t split_index = argument.find("=");
+
+		if(split_index == std::string::npos) {
+			arguments.selections[argument];
+		} else {
+			arguments.selections[argument.substr(0, split_index)] = argument.substr(split_index+1, std::string::npos);
+		}
+	}
+
+	return arguments;
+}
+
+/// Escapes @c string for inclusion within a JSON string literal.
+std::string json_string(const std::string &string) {
+	std::string result = "\"";
+	for(const char c: string) {
+		switch(c) {
+			case '"':	result += "\\\"";	break;
+			case '\\':	result += "\\\\";	break;
+			default:	result += c;		break;
+		}
+	}
+	return result + "\"";
+}
+
+/*!
+	Times @c repeats calls to @c run, each of which is preceded by a call to @c prepare,
+	and returns the median number of seconds taken.
+*/
+double median_seconds(int repeats, const std::function<void(void)> &prepare, const std::function<void(void)> &run) {
+	std::vector<double> durations;
+	for(int c = 0; c < repeats; ++c) {
+		prepare();
+		const auto start_time = Time::nanos_now();
+		run();
+		const auto end_time = Time::nanos_now();
+		durations.push_back(double(end_time - start_time) / 1e9);
+	}
+
+	std::sort(durations.begin(), durations.end());
+	return durations[durations.size() / 2];
+}
+
+/// Provides a result for output as a JSON object.
+struct Result {
+	std::string id, name, status;
+	double clock_rate = 0.0;
+	double emulated_seconds = 0.0;
+	double host_seconds = 0.0;
+	bool synthetic_roms = false;
+
+	std::string json(bool include_roms) const {
+		std::ostringstream stream;
+		stream << std::setprecision(6);
+		stream << "{\"id\": " << json_string(id) << ", \"name\": " << json_string(name) << ", \"status\": " << json_string(status);
+		if(include_roms) {
+			stream << ", \"synthetic_roms\": " << (synthetic_roms ? "true" : "false");
+		}
+		if(status == "ok") {
+			const double cycles = clock_rate * emulated_seconds;
+			stream
+				<< ", \"clock_rate\": " << clock_rate
+				<< ", \"emulated_seconds\": " << emulated_seconds
+				<< ", \"host_seconds\": " << host_seconds;
+
+			// JSON has no representation of infinity or NaN, so ratios without a meaningful
+			// denominator are given as null.
+			const auto ratio = [&stream](const char *name, double numerator, double denominator) {
+				stream << ", \"" << name << "\": ";
+				if(denominator > 0.0) stream << numerator / denominator;
+				else stream << "null";
+			};
+			ratio("speed", emulated_seconds, host_seconds);
+			ratio("emulated_mhz", cycles, host_seconds * 1e6);
+			ratio("ns_per_cycle", host_seconds * 1e9, cycles);
+		}
+		stream << "}";
+		return stream.str();
+	}
+};
+
+// MARK: - Machines.
+
+Result benchmark_machine(const std::string &id, const std::string &name, const ParsedArguments &arguments, double duration, int repeats) {
+	Result result;
+	result.id = id;
+	result.name = name;
+
+	// Look for ROMs in the same places as the SDL binding does; if permitted, substitute
+	// repeatable pseudo-random content for any that are missing.
+	const bool allow_synthetic_roms = arguments.has("synthetic-roms");
+	ROMMachine::ROMFetcher rom_fetcher = [&arguments, &result, allow_synthetic_roms]
+		(const std::vector<ROMMachine::ROM> &roms) -> std::vector<std::unique_ptr<std::vector<uint8_t>>> {
+			std::vector<std::string> paths = {
+				"/usr/local/share/CLK/",
+				"/usr/share/CLK/"
+			};
+
+			const auto rompath = arguments.selections.find("rompath");
+			if(rompath != arguments.selections.end() && !rompath->second.empty()) {
+				paths.push_back(rompath->second.back() != '/' ? rompath->second + "/" : rompath->second);
+			}
+
+			std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
+			std::minstd_rand generator;
+			for(const auto &rom: roms) {
+				FILE *file = nullptr;
+				for(const auto &path: paths) {
+					file = std::fopen((path + rom.machine_name + "/" + rom.file_name).c_str(), "rb");
+					if(file) break;
+				}
+
+				if(!file) {
+					if(!allow_synthetic_roms) {
+						results.emplace_back(nullptr);
+						continue;
+					}
+
+					auto data = std::make_unique<std::vector<uint8_t>>(rom.size ? rom.size : 16384);
+					for(auto &byte: *data) byte = uint8_t(generator());
+					result.synthetic_roms = true;
+					results.push_back(std::move(data));
+					continue;
+				}
+
+				auto data = std::make_unique<std::vector<uint8_t>>();
+				std::fseek(file, 0, SEEK_END);
+				data->resize(size_t(std::ftell(file)));
+				std::fseek(file, 0, SEEK_SET);
+				const std::size_t read = std::fread(data->data(), 1, data->size(), file);
+				std::fclose(file);
+
+				results.emplace_back(read == data->size() ? std::move(data) : nullptr);
+			}
+
+			return results;
+		};
+
+	std::unique_ptr<::Machine::DynamicMachine> machine;
+	const auto prepare = [&] {
+		auto targets = ::Machine::TargetsByMachineName(true);
+		Analyser::Static::TargetList target_list;
+		target_list.push_back(std::move(targets[name]));
+
+		::Machine::Error error;
+		machine.reset(::Machine::MachineForTargets(target_list, rom_fetcher, error));
+		if(!machine) return;
+
+		machine->scan_producer()->set_scan_target(&Outputs::Display::NullScanTarget::singleton);
+		if(arguments.has("no-output")) machine->timed_machine()->set_output_enabled(false);
+		if(arguments.has("approximate-timing")) machine->timed_machine()->set_approximate_timing_enabled(true);
+	};
+
+	// Check up front that the machine can be built.
+	prepare();
+	if(!machine) {
+		result.status = "missing-roms";
+		return result;
+	}
+	result.clock_rate = machine->timed_machine()->get_clock_rate();
+	result.emulated_seconds = duration;
+
+	// Run in slices small enough that per-call cycle counts can't overflow.
+	result.host_seconds = median_seconds(repeats, prepare, [&] {
+		constexpr Time::Seconds slice = 0.1;
+		const auto timed_machine = machine->timed_machine();
+		for(Time::Seconds remaining = duration; remaining > 0.0; remaining -= slice) {
+			timed_machine->run_for(std::min(remaining, slice));
+		}
+	});
+
+	// Include destruction, so that any queued work is complete before the next machine.
+	machine.reset();
+
+	result.status = "ok";
+	return result;
+}
+
+// MARK: - Processors.
+
+/*
+	Each processor repeatedly runs a short loop of memory copies, arithmetic, shifts, branches
+	and subroutine calls from flat RAM.
+*/
+
+constexpr uint8_t mos6502_program[] = {
+	0xa2, 0x00,				// 0200: LDX #$00
+	0xbd, 0x00, 0x10,		// 0202: LDA $1000, X
+	0x69, 0x37,				// 0205: ADC #$37
+	0x9d, 0x00, 0x20,		// 0207: STA $2000, X
+	0x45, 0x30,				// 020a: EOR $30
+	0x85, 0x30,				// 020c: STA $30
+	0x2a,					// 020e: ROL A
+	0x26, 0x31,				// 020f: ROL $31
+	0xe8,					// 0211: INX
+	0xd0, 0xee,				// 0212: BNE $0202
+	0x20, 0x1a, 0x02,		// 0214: JSR $021a
+	0x4c, 0x00, 0x02,		// 0217: JMP $0200
+	0xc8,					// 021a: INY
+	0x60,					// 021b: RTS
+};
+
+constexpr uint8_t z80_program[] = {
+	0x31, 0x00, 0xf0,		// 0000: LD SP, $f000
+	0x21, 0x00, 0x10,		// 0003: LD HL, $1000
+	0x11, 0x00, 0x20,		// 0006: LD DE, $2000
+	0x01, 0x00, 0x01,		// 0009: LD BC, $0100
+	0xed, 0xb0,				// 000c: LDIR
+	0x06, 0x00,				// 000e: LD B, 0
+	0x21, 0x00, 0x20,		// 0010: LD HL, $2000
+	0x7e,					// 0013: LD A, (HL)
+	0x87,					// 0014: ADD A, A
+	0xce, 0x37,				// 0015: ADC A, $37
+	0x77,					// 0017: LD (HL), A
+	0xcb, 0x16,				// 0018: RL (HL)
+	0x23,					// 001a: INC HL
+	0xdd, 0x23,				// 001b: INC IX
+	0x10, 0xf4,				// 001d: DJNZ $0013
+	0xcd, 0x25, 0x00,		// 001f: CALL $0025
+	0xc3, 0x03, 0x00,		// 0022: JP $0003
+	0xe5,					// 0025: PUSH HL
+	0xe1,					// 0026: POP HL
+	0xc9,					// 0027: RET
+};
+
+constexpr uint16_t mc68000_program[] = {
+	0x41f9, 0x0000, 0x2000,	// 1000: LEA $2000, A0
+	0x43f9, 0x0000, 0x4000,	// 1006: LEA $4000, A1
+	0x303c, 0x00ff,			// 100c: MOVE.W #$ff, D0
+	0x2218,					// 1010: MOVE.L (A0)+, D1
+	0xd281,					// 1012: ADD.L D1, D1
+	0xe389,					// 1014: LSL.L #1, D1
+	0x22c1,					// 1016: MOVE.L D1, (A1)+
+	0xc4c1,					// 1018: MULU D1, D2
+	0x51c8, 0xfff4,			// 101a: DBF D0, $1010
+	0x4eb9, 0x0000, 0x102a,	// 101e: JSR $102a
+	0x60da,					// 1024: BRA $1000
+	0x4e71,					// 1026: NOP
+	0x4e71,					// 1028: NOP
+	0x4e75,					// 102a: RTS
+};
+
+/*!
+	Provides a 68000 with 512kb of RAM, a supervisor stack at 0x800 and execution
+	beginning at 0x1000.
+*/
+class RAM68000: public CPU::MC68000::BusHandler {
+	public:
+		RAM68000() : m68000_(*this) {
+			ram_[1] = 0x0800;
+			ram_[3] = 0x1000;
+			std::copy(std::begin(mc68000_program), std::end(mc68000_program), &ram_[0x1000 >> 1]);
+		}
+
+		void run_for(HalfCycles cycles) {
+			m68000_.run_for(cycles);
+		}
+
+		HalfCycles perform_bus_operation(const CPU::MC68000::Microcycle &cycle, int) {
+			using Microcycle = CPU::MC68000::Microcycle;
+			if(!cycle.data_select_active()) return HalfCycles(0);
+
+			const uint32_t word_address = cycle.word_address() % ram_.size();
+			if(cycle.operation & Microcycle::InterruptAcknowledge) {
+				cycle.value->halves.low = 10;
+				return HalfCycles(0);
+			}
+
+			switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
+				default: break;
+
+				case Microcycle::SelectWord | Microcycle::Read:
+					cycle.value->full = ram_[word_address];
+				break;
+				case Microcycle::SelectByte | Microcycle::Read:
+					cycle.value->halves.low = uint8_t(ram_[word_address] >> cycle.byte_shift());
+				break;
+				case Microcycle::SelectWord:
+					ram_[word_address] = cycle.value->full;
+				break;
+				case Microcycle::SelectByte:
+					ram_[word_address] = uint16_t(
+						(cycle.value->halves.low << cycle.byte_shift()) |
+						(ram_[word_address] & cycle.untouched_byte_mask())
+					);
+				break;
+			}
+
+			return HalfCycles(0);
+		}
+
+	private:
+		CPU::MC68000::Processor<RAM68000, true> m68000_;
+		std::array<uint16_t, 256*1024> ram_{};
+};
+
+Result benchmark_processor(const std::string &id, double clock_rate, double duration, int repeats) {
+	Result result;
+	result.id = result.name = id;
+	result.clock_rate = clock_rate;
+	result.emulated_seconds = duration;
+
+	// Run in slices of a tenth of an emulated second, then a final partial slice for whatever remains.
+	const int slice = int(clock_rate / 10.0);
+	const auto total_cycles = int64_t(duration * clock_rate);
+	const int slices = int(total_cycles / slice);
+	const int remainder = int(total_cycles % slice);
+
+	if(id == "6502") {
+		std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor;
+		result.host_seconds = median_seconds(repeats, [&] {
+			processor.reset(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502::Personality::P6502));
+			processor->set_data_at_address(0x200, sizeof(mos6502_program), mos6502_program);
+			processor->set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x200);
+		}, [&] {
+			for(int c = 0; c < slices; ++c) processor->run_for(Cycles(slice));
+			if(remainder) processor->run_for(Cycles(remainder));
+		});
+	} else if(id == "z80") {
+		std::unique_ptr<CPU::Z80::AllRAMProcessor> processor;
+		result.host_seconds = median_seconds(repeats, [&] {
+			processor.reset(CPU::Z80::AllRAMProcessor::Processor());
+			processor->set_data_at_address(0x0000, sizeof(z80_program), z80_program);
+		}, [&] {
+			for(int c = 0; c < slices; ++c) processor->run_for(Cycles(slice));
+			if(remainder) processor->run_for(Cycles(remainder));
+		});
+	} else if(id == "68000") {
+		std::unique_ptr<RAM68000> processor;
+		result.host_seconds = median_seconds(repeats, [&] {
+			processor = std::make_unique<RAM68000>();
+		}, [&] {
+			for(int c = 0; c < slices; ++c) processor->run_for(HalfCycles(slice * 2));
+			if(remainder) processor->run_for(HalfCycles(remainder * 2));
+		});
+	}
+
+	result.emulated_seconds = double(total_cycles) / clock_rate;
+	result.status = "ok";
+	return result;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	const ParsedArguments arguments = parse_arguments(argc, argv);
+
+	if(arguments.has("help")) {
+		std::cout << "Usage: clksignal-benchmark [--duration={emulated seconds}] [--repeats={count}] [--only={comma-separated machine or processor ids}] [--rompath={path to ROMs}] [--synthetic-roms] [--no-output] [--approximate-timing]" << std::endl;
+		std::cout << "Machine ids are as per clksignal --new; processor ids are 6502, z80 and 68000." << std::endl;
+		std::cout << "Results are written to stdout as JSON; per-machine clock rates are those of each machine's master clock." << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	const double duration = arguments.positive_double("duration", 10.0);
+	// Any fractional count of less than one still means a single run.
+	const int repeats = std::max(1, int(arguments.positive_double("repeats", 3.0)));
+
+	// Build the list of things to run, if restricted.
+	std::set<std::string> only;
+	const auto only_argument = arguments.selections.find("only");
+	if(only_argument != arguments.selections.end()) {
+		std::istringstream stream(only_argument->second);
+		std::string id;
+		while(std::getline(stream, id, ',')) {
+			std::transform(id.begin(), id.end(), id.begin(), [](char c) { return char(tolower(c)); });
+			only.insert(id);
+		}
+	}
+	const auto should_run = [&only] (std::string id) {
+		std::transform(id.begin(), id.end(), id.begin(), [](char c) { return char(tolower(c)); });
+		return only.empty() || only.find(id) != only.end();
+	};
+
+	std::vector<Result> machines;
+	const auto short_names = ::Machine::AllMachines(::Machine::Type::DoesntRequireMedia, false);
+	const auto long_names = ::Machine::AllMachines(::Machine::Type::DoesntRequireMedia, true);
+	for(size_t index = 0; index < short_names.size(); ++index) {
+		if(!should_run(short_names[index])) continue;
+		std::cerr << "Running " << long_names[index] << "…" << std::endl;
+		machines.push_back(benchmark_machine(short_names[index], long_names[index], arguments, duration, repeats));
+	}
+
+	// Processors are run at nominal clock rates, which determine only the number of cycles performed.
+	std::vector<Result> processors;
+	const std::pair<const char *, double> processor_clocks[] = {
+		{"6502", 1'000'000.0},
+		{"z80", 4'000'000.0},
+		{"68000", 8'000'000.0},
+	};
+	for(const auto &processor: processor_clocks) {
+		if(!should_run(processor.first)) continue;
+		std::cerr << "Running " << processor.first << "…" << std::endl;
+		processors.push_back(benchmark_processor(processor.first, processor.second, duration, repeats));
+	}
+
+	std::cout << "{" << std::endl;
+	std::cout << "\t\"duration\": " << duration << "," << std::endl;
+	std::cout << "\t\"repeats\": " << repeats << "," << std::endl;
+	std::cout << "\t\"machines\": [";
+	for(size_t index = 0; index < machines.size(); ++index) {
+		std::cout << (index ? "," : "") << std::endl << "\t\t" << machines[index].json(true);
+	}
+	std::cout << std::endl << "\t]," << std::endl;
+	std::cout << "\t\"processors\": [";
+	for(size_t index = 0; index < processors.size(); ++index) {
+		std::cout << (index ? "," : "") << std::endl << "\t\t" << processors[index].json(false);
+	}
+	std::cout << std::endl << "\t]" << std::endl;
+	std::cout << "}" << std::endl;
+
+	return EXIT_SUCCESS;
+}
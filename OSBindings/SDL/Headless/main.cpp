@@ -0,0 +1,390 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+
+#include "../../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../../Machines/Utility/MachineForTarget.hpp"
+#include "../../../Machines/Utility/StateRing.hpp"
+
+#include "../../../ClockReceiver/TimeTypes.hpp"
+
+#include "../../../Machines/MachineTypes.hpp"
+
+#include "../../../Outputs/Capture/Recorder.hpp"
+#include "../../../Outputs/ScanTarget.hpp"
+#include "../../../Outputs/Software/ScanTarget.hpp"
+
+#include "../../../Reflection/Struct.hpp"
+
+/*
+	A render-free, audio-device-free runner: constructs the machine for the supplied
+	media or --new={machine}, attaches either a null scan target or a software one
+	if a screenshot or video capture is requested, and either no speaker delegate or
+	a recorder that captures audio to a file, then runs the machine for the requested
+	emulated duration as quickly as the host allows.
+
+	Multiple instances can be run side-by-side without any window, GL context or
+	audio device.
+*/
+
+namespace {
+
+struct ParsedArguments {
+	std::vector<std::string> file_names;
+	std::map<std::string, std::string> selections;	// The empty string will be inserted for arguments without an = suffix.
+
+	void apply(Reflection::Struct *reflectable) const {
+		for(const auto &argument: selections) {
+			// Replace any dashes with underscores in the argument name.
+			std::string property;
+			std::transform(argument.first.begin(), argument.first.end(), std::back_inserter(property), [](char c) { return c == '-' ? '_' : c; });
+
+			// Only apply properties the reflectable actually has; the remaining
+			// selections are instructions to the runner itself.
+			if(!reflectable->type_of(property)) continue;
+
+			if(argument.second.empty()) {
+				Reflection::set<bool>(*reflectable, property, true);
+			} else {
+				Reflection::fuzzy_set(*reflectable, property, argument.second);
+			}
+		}
+	}
+
+	/// @returns The value of the selection @c name parsed as a positive double, or @c default_value if absent or malformed.
+	double positive_double(const std::string &name, double default_value) const {
+		const auto argument = selections.find(name);
+		if(argument == selections.end()) return default_value;
+
+		const char *string = argument->second.c_str();
+		char *end;
+		const double value = strtod(string, &end);
+		if(size_t(end - string) != strlen(string) || value <= 0.0) {
+			std::cerr << "Unable to parse " << name << ": " << string << "; using " << default_value << std::endl;
+			return default_value;
+		}
+		return value;
+	}
+};
+
+/*! Parses an argc/argv pair to discern program arguments, in the same form as the SDL binding. */
+ParsedArguments parse_arguments(int argc, char *argv[]) {
+	ParsedArguments arguments;
+
+	for(int index = 1; index < argc; ++index) {
+		char *arg = argv[index];
+
+		if(arg[0] == '-') {
+			while(*arg == '-') arg++;
+
+			std::string argument = arg;
+			std::size_t split_index = argument.find("=");
+
+			if(split_index == std::string::npos) {
+				arguments.selections[argument];
+			} else {
+				arguments.selections[argument.substr(0, split_index)] = argument.substr(split_index+1, std::string::npos);
+			}
+		} else {
+			arguments.file_names.push_back(arg);
+		}
+	}
+
+	return arguments;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	const ParsedArguments arguments = parse_arguments(argc, argv);
+
+	if(argc < 2 || arguments.selections.find("help") != arguments.selections.end()) {
+		std::cout << "Usage: clksignal-headless [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--duration={emulated seconds}] [--audio={WAV or raw PCM output file}] [--audio-rate={Hz}] [--video={Y4M or raw RGBA output file}] [--frame-rate={Hz}] [--rewind={seconds of snapshots to retain}] [--skip={emulated seconds to run without output}] [--screenshot={PPM output file}] [--analysis-cache={directory}] [--approximate-timing]" << std::endl;
+		std::cout << "Machine options are as per clksignal; use clksignal --help to list them." << std::endl;
+		return argc < 2 ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	// Determine the machine for the supplied file, if any, or from --new.
+	Analyser::Static::TargetList targets;
+	const auto new_argument = arguments.selections.find("new");
+	if(new_argument != arguments.selections.end() && !new_argument->second.empty()) {
+		const auto short_names = ::Machine::AllMachines(::Machine::Type::DoesntRequireMedia, false);
+		const auto long_names = ::Machine::AllMachines(::Machine::Type::DoesntRequireMedia, true);
+		for(size_t index = 0; index < short_names.size(); ++index) {
+			if(std::equal(
+				short_names[index].begin(), short_names[index].end(),
+				new_argument->second.begin(), new_argument->second.end(),
+				[](char a, char b) { return tolower(b) == tolower(a); })) {
+				auto targets_by_machine = ::Machine::TargetsByMachineName(false);
+				targets.push_back(std::move(targets_by_machine[long_names[index]]));
+				break;
+			}
+		}
+	} else {
+		// Batch runs tend to revisit the same files, so can optionally keep the results of analysis.
+		const auto cache_argument = arguments.selections.find("analysis-cache");
+		const std::string cache_directory = cache_argument != arguments.selections.end() ? cache_argument->second : "";
+
+		for(const auto &file_name: arguments.file_names) {
+			targets = Analyser::Static::GetTargets(file_name, 0.0, cache_directory);
+			if(!targets.empty()) break;
+		}
+	}
+
+	if(targets.empty()) {
+		std::cerr << "No target machine found" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Look for ROMs in the same places as the SDL binding does.
+	ROMMachine::ROMFetcher rom_fetcher = [&arguments]
+		(const std::vector<ROMMachine::ROM> &roms) -> std::vector<std::unique_ptr<std::vector<uint8_t>>> {
+			std::vector<std::string> paths = {
+				"/usr/local/share/CLK/",
+				"/usr/share/CLK/"
+			};
+
+			const auto rompath = arguments.selections.find("rompath");
+			if(rompath != arguments.selections.end() && !rompath->second.empty()) {
+				paths.push_back(rompath->second.back() != '/' ? rompath->second + "/" : rompath->second);
+			}
+
+			std::vector<std::unique_ptr<std::vector<uint8_t>>> results;
+			for(const auto &rom: roms) {
+				FILE *file = nullptr;
+				for(const auto &path: paths) {
+					file = std::fopen((path + rom.machine_name + "/" + rom.file_name).c_str(), "rb");
+					if(file) break;
+				}
+
+				if(!file) {
+					std::cerr << "Could not find " << rom.machine_name << '/' << rom.file_name << std::endl;
+					results.emplace_back(nullptr);
+					continue;
+				}
+
+				auto data = std::make_unique<std::vector<uint8_t>>();
+				std::fseek(file, 0, SEEK_END);
+				data->resize(size_t(std::ftell(file)));
+				std::fseek(file, 0, SEEK_SET);
+				const std::size_t read = std::fread(data->data(), 1, data->size(), file);
+				std::fclose(file);
+
+				results.emplace_back(read == data->size() ? std::move(data) : nullptr);
+			}
+
+			return results;
+		};
+
+	for(auto &target: targets) {
+		auto reflectable_target = dynamic_cast<Reflection::Struct *>(target.get());
+		if(reflectable_target) arguments.apply(reflectable_target);
+	}
+
+	::Machine::Error error;
+	std::unique_ptr<::Machine::DynamicMachine> machine(::Machine::MachineForTargets(targets, rom_fetcher, error));
+	if(!machine) {
+		std::cerr << "Could not create machine" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	auto configurable = machine->configurable_device();
+	if(configurable) {
+		const auto options = configurable->get_options();
+		arguments.apply(options.get());
+		configurable->set_options(options);
+	}
+
+	auto media_target = machine->media_target();
+	if(media_target) {
+		Analyser::Static::Media media;
+		for(const auto &file_name: arguments.file_names) {
+			media += Analyser::Static::GetMedia(file_name);
+		}
+		media_target->insert_media(media);
+	}
+
+	// Video goes nowhere unless a screenshot or capture was requested, in which case it is rendered in software.
+	std::unique_ptr<Outputs::Display::Software::ScanTarget> scan_target;
+	const auto screenshot_argument = arguments.selections.find("screenshot");
+	const auto video_argument = arguments.selections.find("video");
+	const bool wants_screenshot = screenshot_argument != arguments.selections.end() && !screenshot_argument->second.empty();
+	const bool wants_video = video_argument != arguments.selections.end() && !video_argument->second.empty();
+	if(wants_screenshot || wants_video) {
+		scan_target = std::make_unique<Outputs::Display::Software::ScanTarget>(640, 480);
+	}
+
+	// Audio goes nowhere unless a capture file was specified; if there's no delegate
+	// then the speaker will skip filtering entirely.
+	const auto audio_argument = arguments.selections.find("audio");
+	auto speaker = machine->audio_producer() ? machine->audio_producer()->get_speaker() : nullptr;
+	const bool wants_audio = speaker && audio_argument != arguments.selections.end() && !audio_argument->second.empty();
+
+	// Captures go via a recorder, which sits between the machine and the software scan target
+	// and acts as speaker delegate. Formats are selected by file extension.
+	const auto has_extension = [] (const std::string &name, const std::string &extension) {
+		if(name.size() < extension.size()) return false;
+		return std::equal(
+			extension.begin(), extension.end(), name.end() - ptrdiff_t(extension.size()),
+			[](char a, char b) { return tolower(b) == tolower(a); });
+	};
+	std::unique_ptr<Outputs::Capture::Recorder> recorder;
+	if(wants_video || wants_audio) {
+		recorder = std::make_unique<Outputs::Capture::Recorder>(wants_video ? scan_target.get() : nullptr);
+	}
+
+	if(wants_video) {
+		// Absent an explicit rate, use the CRT's current estimate of field duration.
+		const auto field_duration = machine->scan_producer()->get_scan_status().field_duration;
+		const double frame_rate = arguments.positive_double("frame-rate", field_duration > 0.0 ? 1.0 / field_duration : 50.0);
+
+		const auto format = has_extension(video_argument->second, ".y4m") ?
+			Outputs::Capture::Recorder::VideoFormat::Y4M : Outputs::Capture::Recorder::VideoFormat::RGBA;
+		if(!recorder->set_video_output(video_argument->second, format, frame_rate)) {
+			std::cerr << "Could not record video to " << video_argument->second << "; either it could not be opened or frames are too large to buffer" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if(wants_audio) {
+		const int audio_rate = int(arguments.positive_double("audio-rate", 44100.0));
+		const bool is_stereo = speaker->get_is_stereo();
+
+		const auto format = has_extension(audio_argument->second, ".wav") ?
+			Outputs::Capture::Recorder::AudioFormat::WAV : Outputs::Capture::Recorder::AudioFormat::PCM;
+		if(!recorder->set_audio_output(audio_argument->second, format, audio_rate, is_stereo)) {
+			std::cerr << "Could not open " << audio_argument->second << " for writing" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		speaker->set_output_rate(float(audio_rate), 1024, is_stereo);
+		speaker->set_delegate(recorder.get());
+	}
+
+	if(wants_video) {
+		machine->scan_producer()->set_scan_target(recorder.get());
+	} else if(scan_target) {
+		machine->scan_producer()->set_scan_target(scan_target.get());
+	} else {
+		machine->scan_producer()->set_scan_target(&Outputs::Display::NullScanTarget::singleton);
+	}
+
+	// If a rewind window was requested, keep a snapshot per frame for that long, allowing
+	// for displays of up to 60Hz.
+	std::unique_ptr<::Machine::StateRing> state_ring;
+	if(arguments.selections.find("rewind") != arguments.selections.end()) {
+		if(!machine->state_producer()) {
+			std::cerr << "This machine does not support snapshots; ignoring --rewind" << std::endl;
+		} else {
+			const double rewind = arguments.positive_double("rewind", 60.0);
+			state_ring = std::make_unique<::Machine::StateRing>(*machine, size_t(rewind * 60.0));
+		}
+	}
+
+	// Run for the requested period, in small enough slices that per-call
+	// cycle counts can't overflow.
+	const Time::Seconds duration = arguments.positive_double("duration", 10.0);
+	constexpr Time::Seconds slice = 0.1;
+	const auto timed_machine = machine->timed_machine();
+	if(arguments.selections.find("approximate-timing") != arguments.selections.end()) {
+		timed_machine->set_approximate_timing_enabled(true);
+	}
+
+	// If requested, run the first part of that period without any audio or video output.
+	Time::Seconds skip = 0.0;
+	if(arguments.selections.find("skip") != arguments.selections.end()) {
+		skip = arguments.positive_double("skip", 0.0);
+		timed_machine->set_output_enabled(false);
+	}
+
+	const auto start_time = Time::nanos_now();
+	Time::Seconds remaining = duration;
+	while(remaining > 0.0) {
+		const Time::Seconds step = std::min(remaining, slice);
+		const bool output_was_enabled = timed_machine->get_output_enabled();
+		if(state_ring) {
+			state_ring->run_for(step);
+		} else {
+			timed_machine->run_for(step);
+		}
+		remaining -= step;
+
+		if(recorder && output_was_enabled) recorder->advance(step);
+		if(scan_target && !wants_video) scan_target->update();
+
+		if(!timed_machine->get_output_enabled() && duration - remaining >= skip) {
+			timed_machine->set_output_enabled(true);
+		}
+	}
+	const auto end_time = Time::nanos_now();
+
+	if(state_ring) {
+		const size_t snapshots = state_ring->size();
+		const auto restore_start = Time::nanos_now();
+		const bool restored = state_ring->restore();
+		const auto restore_end = Time::nanos_now();
+
+		std::cout << "snapshots: " << snapshots << "; storage: " << state_ring->memory_usage() << " bytes; restore: ";
+		if(restored) {
+			std::cout << double(restore_end - restore_start) / 1e6 << "ms" << std::endl;
+		} else {
+			std::cout << "failed" << std::endl;
+		}
+	}
+
+	if(wants_screenshot) {
+		scan_target->update();
+
+		std::unique_ptr<FILE, decltype((fclose))> screenshot_file(std::fopen(screenshot_argument->second.c_str(), "wb"), fclose);
+		if(!screenshot_file) {
+			std::cerr << "Could not open " << screenshot_argument->second << " for writing" << std::endl;
+		} else {
+			// Write as a binary PPM, dropping the alpha channel.
+			const int width = scan_target->get_width(), height = scan_target->get_height();
+			std::fprintf(screenshot_file.get(), "P6\n%d %d\n255\n", width, height);
+
+			const uint8_t *pixels = scan_target->get_pixels();
+			for(int pixel = 0; pixel < width * height; ++pixel) {
+				std::fwrite(&pixels[pixel * 4], 1, 3, screenshot_file.get());
+			}
+		}
+	}
+
+	// Destroy the machine before closing any capture file, so that pending audio is flushed;
+	// it also needs to cease using the scan target before that is destroyed.
+	machine.reset();
+
+	if(recorder) {
+		recorder->finish();
+
+		const auto statistics = recorder->get_statistics();
+		if(wants_video) {
+			std::cout << "video: " << statistics.frames << " frames; " << statistics.repeated_frames << " repeated; " << statistics.skipped_frames << " skipped" << std::endl;
+		}
+		if(wants_audio) {
+			std::cout << "audio: " << statistics.audio_samples << " samples; " << statistics.silenced_samples << " silenced" << std::endl;
+		}
+		if(statistics.has_failed) {
+			std::cerr << "Not all captured output could be written" << std::endl;
+		}
+	}
+
+	const double host_seconds = double(end_time - start_time) / 1e9;
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "emulated: " << duration << "s; host: " << host_seconds << "s; speed: " << (duration / host_seconds) << "x" << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,334 @@
+//
+//  Recorder.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Recorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace Outputs::Capture;
+
+namespace {
+
+// The amount of memory each stream may occupy while waiting for the disk: at 640x480,
+// a little over 100 frames of video; several minutes of audio.
+constexpr size_t VideoCapacity = 128 * 1024 * 1024;
+constexpr size_t AudioCapacity = 16 * 1024 * 1024;
+
+// Each Y4M frame is preceded by this header.
+constexpr char Y4MFrameHeader[] = "FRAME\n";
+constexpr size_t Y4MFrameHeaderLength = sizeof(Y4MFrameHeader) - 1;
+
+void append_le(std::vector<uint8_t> &buffer, uint32_t value, int bytes) {
+	for(int c = 0; c < bytes; ++c) {
+		buffer.push_back(uint8_t(value >> (c * 8)));
+	}
+}
+
+}
+
+Recorder::Recorder(Outputs::Display::Software::ScanTarget *scan_target) :
+	scan_target_(scan_target),
+	forward_(scan_target ? static_cast<Outputs::Display::ScanTarget &>(*scan_target) : Outputs::Display::NullScanTarget::singleton) {}
+
+Recorder::~Recorder() {
+	finish();
+}
+
+// MARK: - Setup.
+
+bool Recorder::set_video_output(const std::string &file_name, VideoFormat format, double frame_rate) {
+	if(!scan_target_) return false;
+
+	// All frames are of the size in effect now; decline if a single one couldn't be buffered,
+	// as there'd then be no way to write even the first.
+	video_format_ = format;
+	video_width_ = scan_target_->get_width();
+	video_height_ = scan_target_->get_height();
+	if(frame_length() > VideoCapacity) {
+		return false;
+	}
+
+	video_ = std::make_unique<Writer>(file_name, VideoCapacity);
+	if(!video_->is_open()) {
+		video_.reset();
+		return false;
+	}
+
+	frame_rate_ = frame_rate;
+	elapsed_ = 0.0;
+	has_frame_ = false;
+
+	if(format == VideoFormat::Y4M) {
+		// Express the frame rate to a thousandth of a frame per second.
+		char header[128];
+		const int length = std::snprintf(header, sizeof(header),
+			"YUV4MPEG2 W%d H%d F%d:1000 Ip A1:1 C444\n",
+			video_width_, video_height_, int(std::round(frame_rate * 1000.0)));
+		video_->write(std::vector<uint8_t>(header, header + length));
+	}
+	return true;
+}
+
+bool Recorder::set_audio_output(const std::string &file_name, AudioFormat format, int sample_rate, bool is_stereo) {
+	audio_ = std::make_unique<Writer>(file_name, AudioCapacity);
+	if(!audio_->is_open()) {
+		audio_.reset();
+		return false;
+	}
+
+	audio_format_ = format;
+	sample_rate_ = sample_rate;
+	is_stereo_ = is_stereo;
+
+	// Write a placeholder header; the lengths within it are completed by finish().
+	if(format == AudioFormat::WAV) {
+		audio_->write(wav_header(0));
+	}
+	return true;
+}
+
+// MARK: - Timing.
+
+void Recorder::advance(Time::Seconds duration) {
+	if(!video_) return;
+	elapsed_ += duration;
+
+	// Allow a frame of slack in either direction, as the caller's notion of time is unlikely
+	// to be aligned with frame boundaries.
+	const double expected = elapsed_ * frame_rate_;
+	const double written = double(video_statistics_.frames);
+	if(written < expected - 1.5) {
+		while(double(video_statistics_.frames) < expected - 0.5) {
+			repeat_frame();
+		}
+	} else if(written > expected + 1.5) {
+		frames_to_skip_ = size_t(std::round(written - expected));
+	}
+}
+
+void Recorder::finish() {
+	if(video_) {
+		const double expected = std::round(elapsed_ * frame_rate_);
+		while(double(video_statistics_.frames) < expected) {
+			repeat_frame();
+		}
+
+		video_->flush();
+		video_statistics_.has_failed |= video_->has_failed();
+		video_.reset();
+	}
+
+	if(audio_) {
+		if(audio_format_ == AudioFormat::WAV) {
+			audio_->overwrite(0, wav_header(audio_samples_ * sizeof(int16_t)));
+		}
+
+		audio_->flush();
+		video_statistics_.has_failed |= audio_->has_failed();
+		audio_.reset();
+	}
+}
+
+Recorder::Statistics Recorder::get_statistics() const {
+	Statistics statistics = video_statistics_;
+	statistics.audio_samples = audio_samples_;
+	statistics.silenced_samples = silenced_samples_;
+	if(video_) statistics.has_failed |= video_->has_failed();
+	if(audio_) statistics.has_failed |= audio_->has_failed();
+	return statistics;
+}
+
+// MARK: - Video.
+
+void Recorder::capture_frame() {
+	if(!scan_target_) return;
+	scan_target_->update();
+	if(!video_) return;
+
+	if(frames_to_skip_) {
+		--frames_to_skip_;
+		++video_statistics_.skipped_frames;
+		return;
+	}
+
+	// If the framebuffer has been resized then the new size can't be represented in the
+	// output stream, so keep repeating the final frame of the old size.
+	if(scan_target_->get_width() != video_width_ || scan_target_->get_height() != video_height_) {
+		repeat_frame();
+		return;
+	}
+
+	if(video_->write(encode_frame())) {
+		has_frame_ = true;
+		++video_statistics_.frames;
+	} else {
+		repeat_frame();
+	}
+}
+
+void Recorder::repeat_frame() {
+	if(!has_frame_) {
+		// There's nothing to repeat yet, so use whatever is currently in the framebuffer;
+		// if that can't be buffered either then there's no option but to wait. A frame is
+		// never larger than the whole buffer, per set_video_output, so the wait is finite.
+		std::vector<uint8_t> frame = encode_frame();
+		while(!video_->write(std::move(frame))) {
+			video_->flush();
+			frame = encode_frame();
+		}
+		has_frame_ = true;
+	} else {
+		video_->repeat();
+	}
+
+	++video_statistics_.frames;
+	++video_statistics_.repeated_frames;
+}
+
+size_t Recorder::frame_length() const {
+	const size_t pixels = size_t(video_width_) * size_t(video_height_);
+	switch(video_format_) {
+		case VideoFormat::RGBA:	return pixels * 4;
+		case VideoFormat::Y4M:	return Y4MFrameHeaderLength + pixels * 3;
+	}
+	return 0;
+}
+
+std::vector<uint8_t> Recorder::encode_frame() const {
+	const size_t pixels = size_t(video_width_ * video_height_);
+	const uint8_t *const source = scan_target_->get_pixels();
+
+	// A blank frame is supplied if the framebuffer has since changed size.
+	const bool is_valid = scan_target_->get_width() == video_width_ && scan_target_->get_height() == video_height_;
+
+	switch(video_format_) {
+		case VideoFormat::RGBA:
+			if(!is_valid) return std::vector<uint8_t>(pixels * 4);
+		return std::vector<uint8_t>(source, source + pixels * 4);
+
+		case VideoFormat::Y4M: {
+			std::vector<uint8_t> frame(Y4MFrameHeaderLength + pixels * 3);
+			std::memcpy(frame.data(), Y4MFrameHeader, Y4MFrameHeaderLength);
+
+			uint8_t *const y = &frame[Y4MFrameHeaderLength];
+			uint8_t *const cb = y + pixels;
+			uint8_t *const cr = cb + pixels;
+			if(!is_valid) {
+				std::fill(y, cb, 16);
+				std::fill(cb, cr + pixels, 128);
+				return frame;
+			}
+
+			// BT.601, limited range.
+			for(size_t c = 0; c < pixels; ++c) {
+				const int red = source[c*4 + 0], green = source[c*4 + 1], blue = source[c*4 + 2];
+				y[c] = uint8_t(((66*red + 129*green + 25*blue + 128) >> 8) + 16);
+				cb[c] = uint8_t(((-38*red - 74*green + 112*blue + 128) >> 8) + 128);
+				cr[c] = uint8_t(((112*red - 94*green - 18*blue + 128) >> 8) + 128);
+			}
+			return frame;
+		}
+	}
+
+	return {};
+}
+
+// MARK: - Audio.
+
+void Recorder::speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) {
+	if(!audio_) return;
+
+	const size_t length = buffer.size() * sizeof(int16_t);
+	std::vector<uint8_t> data;
+	if(audio_format_ == AudioFormat::WAV) {
+		// WAVE data is always little endian.
+		data.reserve(length);
+		for(const auto sample: buffer) {
+			append_le(data, uint16_t(sample), 2);
+		}
+	} else {
+		data.resize(length);
+		std::memcpy(data.data(), buffer.data(), length);
+	}
+
+	if(!audio_->write(std::move(data))) {
+		audio_->write_zeroes(length);
+		silenced_samples_ += buffer.size();
+	}
+	audio_samples_ += buffer.size();
+}
+
+std::vector<uint8_t> Recorder::wav_header(size_t data_length) const {
+	const uint32_t length = uint32_t(std::min(data_length, size_t(0xffff'ffff - 36)));
+	const int channels = is_stereo_ ? 2 : 1;
+
+	std::vector<uint8_t> header;
+	const auto append_tag = [&header] (const char *tag) {
+		header.insert(header.end(), tag, tag + 4);
+	};
+
+	append_tag("RIFF");
+	append_le(header, 36 + length, 4);
+	append_tag("WAVE");
+
+	append_tag("fmt ");
+	append_le(header, 16, 4);											// Length of the format chunk.
+	append_le(header, 1, 2);											// PCM.
+	append_le(header, uint32_t(channels), 2);
+	append_le(header, uint32_t(sample_rate_), 4);
+	append_le(header, uint32_t(sample_rate_ * channels * 2), 4);		// Bytes per second.
+	append_le(header, uint32_t(channels * 2), 2);						// Bytes per sample frame.
+	append_le(header, 16, 2);											// Bits per sample.
+
+	append_tag("data");
+	append_le(header, length, 4);
+
+	return header;
+}
+
+// MARK: - ScanTarget forwarding.
+
+void Recorder::set_modals(Modals modals) {
+	forward_.set_modals(modals);
+}
+
+Outputs::Display::ScanTarget::Scan *Recorder::begin_scan() {
+	return forward_.begin_scan();
+}
+
+void Recorder::end_scan() {
+	forward_.end_scan();
+}
+
+uint8_t *Recorder::begin_data(size_t required_length, size_t required_alignment) {
+	return forward_.begin_data(required_length, required_alignment);
+}
+
+void Recorder::end_data(size_t actual_length) {
+	forward_.end_data(actual_length);
+}
+
+void Recorder::will_change_owner() {
+	forward_.will_change_owner();
+}
+
+void Recorder::submit() {
+	forward_.submit();
+}
+
+void Recorder::announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) {
+	forward_.announce(event, is_visible, location, composite_amplitude);
+
+	// Each completed frame is captured as the CRT begins the next.
+	if(event == Event::EndVerticalRetrace) {
+		capture_frame();
+	}
+}
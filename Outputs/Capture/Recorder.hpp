@@ -0,0 +1,163 @@
+//
+//  Recorder.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Capture_Recorder_hpp
+#define Capture_Recorder_hpp
+
+#include "Writer.hpp"
+
+#include "../ScanTarget.hpp"
+#include "../Software/ScanTarget.hpp"
+#include "../Speaker/Speaker.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Outputs {
+namespace Capture {
+
+/*!
+	Records a machine's video and audio output to disk as raw streams.
+
+	The Recorder sits between the machine and a software scan target, forwarding all video to the
+	latter. Whenever the CRT announces the end of a vertical retrace, the scan target is updated and
+	its framebuffer is captured as the next video frame, either as raw RGBA or as Y4M. The Recorder
+	is also a speaker delegate, writing all audio it receives as either raw native-endian 16-bit
+	PCM or as WAV.
+
+	Video frames are nominally one per CRT frame, and are given a fixed rate. So that the two streams
+	remain in sync regardless, the owner should report the emulated time that elapses while output
+	is enabled via @c advance; at those points the number of frames written is compared with that
+	expected and, if the two have diverged by more than a frame — e.g. because the machine stopped
+	providing vertical sync or runs at a rate other than that declared — frames are repeated or
+	skipped to close the gap. Audio samples already have a fixed relationship to emulated time.
+
+	Writing is performed asynchronously and in bounded memory. If the disk can't keep up then a
+	frame that can't be buffered is replaced by a repeat of the previous one, and a buffer of audio
+	by silence, so that emulation never waits and the streams never drift.
+*/
+class Recorder: public Outputs::Display::ScanTarget, public Outputs::Speaker::Speaker::Delegate {
+	public:
+		enum class VideoFormat {
+			/// Frames of 8-bit RGBA, in raster order and without any header.
+			RGBA,
+			/// YUV4MPEG2, with 4:4:4 BT.601 limited-range samples.
+			Y4M,
+		};
+
+		enum class AudioFormat {
+			/// Signed 16-bit samples in host byte order and without any header; stereo is interleaved.
+			PCM,
+			/// A 16-bit PCM WAVE file.
+			WAV,
+		};
+
+		/*!
+			Constructs a Recorder that will forward all video to @c scan_target and capture frames from it.
+			@c scan_target may be @c nullptr if only audio is to be captured.
+		*/
+		Recorder(Outputs::Display::Software::ScanTarget *scan_target);
+
+		/// Performs a @c finish.
+		~Recorder();
+
+		/*!
+			Begins capturing video to @c file_name at @c frame_rate frames per second.
+
+			@returns @c true if the file was opened; @c false otherwise, if there is no scan target or if
+				a single frame at the current framebuffer size would exceed the memory permitted to
+				await the disk.
+		*/
+		bool set_video_output(const std::string &file_name, VideoFormat format, double frame_rate);
+
+		/*!
+			Begins capturing audio to @c file_name. The speaker should be configured to provide
+			samples at @c sample_rate and in stereo if @c is_stereo is @c true.
+
+			@returns @c true if the file was opened; @c false otherwise.
+		*/
+		bool set_audio_output(const std::string &file_name, AudioFormat format, int sample_rate, bool is_stereo);
+
+		/*!
+			Notes that @c duration of emulated time has passed with output enabled. This should be called
+			from the thread that runs the machine.
+		*/
+		void advance(Time::Seconds duration);
+
+		/*!
+			Pads the video to the total emulated duration, completes any file headers and waits for all
+			outstanding writes. Audio should be complete before this is called, i.e. the machine should
+			already have been destroyed or detached from this delegate.
+		*/
+		void finish();
+
+		struct Statistics {
+			/// The total number of frames written, including any repeats.
+			size_t frames = 0;
+			/// Frames that were written as a repeat of the previous, to cover a lack of vertical sync or a full buffer.
+			size_t repeated_frames = 0;
+			/// Frames that were not written because video was running ahead.
+			size_t skipped_frames = 0;
+			/// The total number of audio samples written, including silence; for stereo this counts left and right separately.
+			size_t audio_samples = 0;
+			/// Samples that were written as silence because of a full buffer.
+			size_t silenced_samples = 0;
+			/// @c true if any file write failed.
+			bool has_failed = false;
+		};
+		/// @returns Statistics on everything captured so far.
+		Statistics get_statistics() const;
+
+	private:
+		// Outputs::Display::ScanTarget overrides; all of these forward to the software scan target.
+		void set_modals(Modals) final;
+		Scan *begin_scan() final;
+		void end_scan() final;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
+		void end_data(size_t actual_length) final;
+		void will_change_owner() final;
+		void submit() final;
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) final;
+
+		// Outputs::Speaker::Speaker::Delegate.
+		void speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) final;
+
+		Outputs::Display::Software::ScanTarget *const scan_target_;
+		Outputs::Display::ScanTarget &forward_;	// scan_target_ via its public interface, or the null scan target.
+
+		// Video.
+		std::unique_ptr<Writer> video_;
+		VideoFormat video_format_ = VideoFormat::RGBA;
+		double frame_rate_ = 50.0;
+		int video_width_ = 0, video_height_ = 0;
+		Time::Seconds elapsed_ = 0.0;
+		size_t frames_to_skip_ = 0;
+		bool has_frame_ = false;
+		void capture_frame();
+		void repeat_frame();
+		size_t frame_length() const;
+		std::vector<uint8_t> encode_frame() const;
+
+		// Audio; the delegate may be called from any thread.
+		std::unique_ptr<Writer> audio_;
+		AudioFormat audio_format_ = AudioFormat::PCM;
+		int sample_rate_ = 0;
+		bool is_stereo_ = false;
+		std::vector<uint8_t> wav_header(size_t data_length) const;
+
+		std::atomic<size_t> audio_samples_{0}, silenced_samples_{0};
+		Statistics video_statistics_;
+};
+
+}
+}
+
+#endif /* Capture_Recorder_hpp */
@@ -0,0 +1,165 @@
+//
+//  Writer.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Writer.hpp"
+
+#include <algorithm>
+
+using namespace Outputs::Capture;
+
+Writer::Writer(const std::string &file_name, size_t capacity) :
+	file_(std::fopen(file_name.c_str(), "wb")),
+	capacity_(capacity) {
+	if(file_) {
+		thread_ = std::thread([this] { run(); });
+	}
+}
+
+Writer::~Writer() {
+	if(!file_) return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		is_finishing_ = true;
+	}
+	command_condition_.notify_one();
+	thread_.join();
+
+	std::fclose(file_);
+}
+
+bool Writer::is_open() const {
+	return file_;
+}
+
+bool Writer::has_failed() const {
+	return has_failed_;
+}
+
+bool Writer::write(std::vector<uint8_t> &&data) {
+	if(!file_) return false;
+
+	Command command;
+	command.type = Command::Type::Write;
+	command.length = data.size();
+	command.is_counted = true;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if(pending_bytes_ + data.size() > capacity_) return false;
+		pending_bytes_ += data.size();
+
+		last_write_ = command.data = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+		commands_.push_back(std::move(command));
+	}
+	command_condition_.notify_one();
+	return true;
+}
+
+void Writer::repeat() {
+	if(!file_) return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if(!last_write_) return;
+
+		Command command;
+		command.type = Command::Type::Write;
+		command.data = last_write_;
+		command.length = last_write_->size();
+		commands_.push_back(std::move(command));
+	}
+	command_condition_.notify_one();
+}
+
+void Writer::write_zeroes(size_t length) {
+	Command command;
+	command.type = Command::Type::Zeroes;
+	command.length = length;
+	enqueue(std::move(command));
+}
+
+void Writer::overwrite(long offset, std::vector<uint8_t> &&data) {
+	Command command;
+	command.type = Command::Type::Overwrite;
+	command.length = data.size();
+	command.offset = offset;
+	command.data = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+	enqueue(std::move(command));
+}
+
+void Writer::enqueue(Command &&command) {
+	if(!file_) return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		commands_.push_back(std::move(command));
+	}
+	command_condition_.notify_one();
+}
+
+void Writer::flush() {
+	if(!file_) return;
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	idle_condition_.wait(lock, [this] { return commands_.empty() && !is_busy_; });
+	std::fflush(file_);
+}
+
+void Writer::run() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while(true) {
+		command_condition_.wait(lock, [this] { return !commands_.empty() || is_finishing_; });
+		if(commands_.empty()) return;
+
+		// Take the next command and perform it without holding the lock; the data
+		// it refers to is shared so remains valid even if repeated meanwhile.
+		const Command command = std::move(commands_.front());
+		commands_.pop_front();
+		is_busy_ = true;
+		lock.unlock();
+
+		if(!perform(command)) {
+			has_failed_ = true;
+		}
+
+		lock.lock();
+		is_busy_ = false;
+		if(command.is_counted) {
+			pending_bytes_ -= command.length;
+		}
+		if(commands_.empty()) {
+			idle_condition_.notify_all();
+		}
+	}
+}
+
+bool Writer::perform(const Command &command) {
+	switch(command.type) {
+		case Command::Type::Write:
+		return std::fwrite(command.data->data(), 1, command.length, file_) == command.length;
+
+		case Command::Type::Zeroes: {
+			static constexpr uint8_t zeroes[4096] = {};
+			size_t remaining = command.length;
+			while(remaining) {
+				const size_t length = std::min(remaining, sizeof(zeroes));
+				if(std::fwrite(zeroes, 1, length, file_) != length) return false;
+				remaining -= length;
+			}
+		} return true;
+
+		case Command::Type::Overwrite: {
+			const long end = std::ftell(file_);
+			if(end < 0 || std::fseek(file_, command.offset, SEEK_SET)) return false;
+			const bool wrote = std::fwrite(command.data->data(), 1, command.length, file_) == command.length;
+			return !std::fseek(file_, end, SEEK_SET) && wrote;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,111 @@
+//
+//  Writer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Capture_Writer_hpp
+#define Capture_Writer_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Outputs {
+namespace Capture {
+
+/*!
+	Writes to a file on a thread of its own, so that callers never wait for the disk.
+
+	The amount of data that may be held in memory awaiting the disk is capped; a call to @c write
+	that would exceed that cap is declined rather than blocking. Callers can then substitute
+	either a repeat of the previous block or a run of zeroes, neither of which holds any further
+	memory, so that the file retains the proper length.
+
+	All methods are safe to call from multiple threads, though commands from separate threads
+	will be performed in whatever order they happen to arrive.
+*/
+class Writer {
+	public:
+		/*!
+			Opens @c file_name for writing, replacing any existing file.
+
+			@param capacity The maximum number of bytes that may await the disk.
+		*/
+		Writer(const std::string &file_name, size_t capacity);
+
+		/// Writes everything outstanding, then closes the file.
+		~Writer();
+
+		/// @returns @c true if the file was opened successfully; @c false otherwise.
+		bool is_open() const;
+
+		/// @returns @c true if any write has so far failed; @c false otherwise.
+		bool has_failed() const;
+
+		/*!
+			Enqueues @c data to be appended to the file.
+
+			@returns @c true if @c data was accepted; @c false if it was discarded because it
+				would have exceeded the capacity.
+		*/
+		bool write(std::vector<uint8_t> &&data);
+
+		/// Enqueues another copy of the most recent data accepted by @c write, if any.
+		void repeat();
+
+		/// Enqueues @c length zero bytes.
+		void write_zeroes(size_t length);
+
+		/*!
+			Enqueues a replacement of the bytes at @c offset with @c data; subsequent writes continue
+			from the end of the file. This is exempt from the capacity, being intended for the small
+			fix-ups that some file headers require once the total length is known.
+		*/
+		void overwrite(long offset, std::vector<uint8_t> &&data);
+
+		/// Blocks until everything enqueued so far has been written.
+		void flush();
+
+	private:
+		struct Command {
+			enum class Type {
+				Write, Zeroes, Overwrite
+			} type;
+			std::shared_ptr<const std::vector<uint8_t>> data;
+			size_t length = 0;
+			long offset = 0;
+			bool is_counted = false;	// i.e. contributes to pending_bytes_.
+		};
+
+		FILE *file_ = nullptr;
+		const size_t capacity_;
+
+		std::mutex mutex_;
+		std::condition_variable command_condition_, idle_condition_;
+		std::deque<Command> commands_;
+		std::shared_ptr<const std::vector<uint8_t>> last_write_;
+		size_t pending_bytes_ = 0;
+		bool is_busy_ = false;
+		bool is_finishing_ = false;
+		std::atomic<bool> has_failed_{false};
+
+		std::thread thread_;
+		void enqueue(Command &&command);
+		void run();
+		bool perform(const Command &command);
+};
+
+}
+}
+
+#endif /* Capture_Writer_hpp */
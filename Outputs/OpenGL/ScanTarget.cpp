@@ -11,6 +11,7 @@
 #include "OpenGL.hpp"
 #include "Primitives/Rectangle.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <limits>
@@ -67,15 +68,80 @@ const GLenum formatForDepth(std::size_t depth) {
 
 }
 
-template <typename T> void ScanTarget::allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name) {
-	const auto buffer_size = array.size() * sizeof(array[0]);
+uint8_t *ScanTarget::allocate_buffer(GLenum target, size_t size, GLuint &buffer_name) {
 	test_gl(glGenBuffers, 1, &buffer_name);
-	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
-	test_gl(glBufferData, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), NULL, GL_STREAM_DRAW);
+	test_gl(glBindBuffer, target, buffer_name);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+	if(uses_persistent_buffers_) {
+		// Scans and write-area bookends are read back on the CPU, so ask for readable storage.
+		constexpr GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		test_gl(glBufferStorage, target, GLsizeiptr(size), nullptr, flags);
+		const auto mapping = static_cast<uint8_t *>(glMapBufferRange(target, 0, GLsizeiptr(size), flags));
+		test_gl_error();
+		return mapping;
+	}
+#endif
 
-	test_gl(glGenVertexArrays, 1, &vertex_array_name);
-	test_gl(glBindVertexArray, vertex_array_name);
-	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
+	test_gl(glBufferData, target, GLsizeiptr(size), NULL, GL_STREAM_DRAW);
+	return nullptr;
+}
+
+void ScanTarget::allocate_buffers() {
+#ifdef GL_MAP_PERSISTENT_BIT
+	// Persistent mapping requires glBufferStorage, and drawing directly from the ring
+	// buffers requires glDrawArraysInstancedBaseInstance; both are core in OpenGL 4.4.
+	GLint major_version = 0, minor_version = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major_version);
+	glGetIntegerv(GL_MINOR_VERSION, &minor_version);
+	uses_persistent_buffers_ = major_version > 4 || (major_version == 4 && minor_version >= 4);
+#endif
+
+	if(uses_persistent_buffers_) {
+		scan_buffer_ = reinterpret_cast<Scan *>(allocate_buffer(GL_ARRAY_BUFFER, ScanBufferSize * sizeof(Scan), scan_buffer_name_));
+		line_buffer_ = reinterpret_cast<Line *>(allocate_buffer(GL_ARRAY_BUFFER, LineBufferHeight * sizeof(Line), line_buffer_name_));
+
+		// The write area is sized for the largest possible data type, so that it needn't be reallocated.
+		write_area_texture_ = allocate_buffer(GL_PIXEL_UNPACK_BUFFER, WriteAreaWidth * WriteAreaHeight * 4, write_area_buffer_name_);
+		test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if(scan_buffer_ && line_buffer_ && write_area_texture_) {
+			return;
+		}
+
+		// If any mapping failed, discard all three buffers and use the copying path.
+		LOG("Couldn't persistently map buffers; falling back on copying");
+		const GLuint buffers[] = {scan_buffer_name_, line_buffer_name_, write_area_buffer_name_};
+		test_gl(glDeleteBuffers, 3, buffers);
+		write_area_buffer_name_ = 0;
+		write_area_texture_ = nullptr;
+		uses_persistent_buffers_ = false;
+	}
+
+	scan_buffer_storage_.resize(ScanBufferSize);
+	line_buffer_storage_.resize(LineBufferHeight);
+	scan_buffer_ = scan_buffer_storage_.data();
+	line_buffer_ = line_buffer_storage_.data();
+
+	allocate_buffer(GL_ARRAY_BUFFER, ScanBufferSize * sizeof(Scan), scan_buffer_name_);
+	allocate_buffer(GL_ARRAY_BUFFER, LineBufferHeight * sizeof(Line), line_buffer_name_);
+}
+
+void ScanTarget::draw_instances(size_t start, size_t count, size_t buffer_size) {
+#ifdef GL_MAP_PERSISTENT_BIT
+	if(uses_persistent_buffers_) {
+		// Draw directly from the ring buffer, in two parts if the range wraps around.
+		const size_t first_portion = std::min(count, buffer_size - start);
+		test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(first_portion), GLuint(start));
+		if(first_portion < count) {
+			test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(count - first_portion), 0);
+		}
+		return;
+	}
+#endif
+
+	// Otherwise the instances will have been copied to the start of the buffer.
+	test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(count));
 }
 
 ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
@@ -88,13 +154,10 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 	read_pointers_.store(write_pointers_);
 	submit_pointers_.store(write_pointers_);
 
-	// Allocate space for the scans and lines.
-	allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_);
-	allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_);
-
-	// TODO: if this is OpenGL 4.4 or newer, use glBufferStorage rather than glBufferData
-	// and specify GL_MAP_PERSISTENT_BIT. Then map the buffer now, and let the client
-	// write straight into it.
+	// Allocate space for the scans, lines and write area.
+	allocate_buffers();
+	test_gl(glGenVertexArrays, 1, &scan_vertex_array_);
+	test_gl(glGenVertexArrays, 1, &line_vertex_array_);
 
 	test_gl(glGenTextures, 1, &write_area_texture_name_);
 
@@ -109,8 +172,11 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 ScanTarget::~ScanTarget() {
 	while(is_updating_.test_and_set());
 	glDeleteBuffers(1, &scan_buffer_name_);
+	glDeleteBuffers(1, &line_buffer_name_);
+	if(write_area_buffer_name_) glDeleteBuffers(1, &write_area_buffer_name_);
 	glDeleteTextures(1, &write_area_texture_name_);
 	glDeleteVertexArrays(1, &scan_vertex_array_);
+	glDeleteVertexArrays(1, &line_vertex_array_);
 }
 
 void ScanTarget::set_target_framebuffer(GLuint target_framebuffer) {
@@ -125,19 +191,52 @@ void ScanTarget::set_modals(Modals modals) {
 	while(is_updating_.test_and_set());
 	modals_ = modals;
 	modals_are_dirty_ = true;
+
+	// Modals are set by the producer, so this is also the place to adjust the write area
+	// and write_pointers_; update() is excluded for the duration, so everything it would
+	// otherwise read can safely be reset too.
+	const auto data_type_size = Outputs::Display::size_for_data_type(modals_.input_data_type);
+	if(data_type_size != data_type_size_) {
+		data_type_size_ = data_type_size;
+		if(!uses_persistent_buffers_) {
+			write_area_texture_storage_.resize(WriteAreaWidth*WriteAreaHeight*data_type_size_);
+			write_area_texture_ = write_area_texture_storage_.data();
+		}
+		texture_exists_ = false;
+
+		// Anything already buffered was in the old format, so discard it.
+		write_pointers_ = PointerSet();
+		draw_pointers_ = write_pointers_;
+		submit_pointers_.store(write_pointers_);
+		active_line_ = nullptr;
+		provided_scans_ = 0;
+
+		if(uses_persistent_buffers_ && fence_ != nullptr) {
+			// The GPU may still be reading from the buffers in place, and only update() can
+			// wait on the fence. So place the read pointers one step ahead of the write pointers,
+			// leaving no space at all, until update() retires the fence and frees everything
+			// by copying in the reset draw_pointers_.
+			PointerSet blocked = write_pointers_;
+			blocked.write_area = write_pointers_.write_area + 1;
+			blocked.scan_buffer = uint16_t((write_pointers_.scan_buffer + 1) % ScanBufferSize);
+			blocked.line = uint16_t((write_pointers_.line + 1) % LineBufferHeight);
+			read_pointers_.store(blocked);
+		} else {
+			read_pointers_.store(write_pointers_);
+		}
+	}
+
 	is_updating_.clear();
 }
 
 Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
 	if(allocation_has_failed_) return nullptr;
 
-	std::lock_guard<std::mutex> lock_guard(write_pointers_mutex_);
-
 	const auto result = &scan_buffer_[write_pointers_.scan_buffer];
 	const auto read_pointers = read_pointers_.load();
 
 	// Advance the pointer.
-	const auto next_write_pointer = decltype(write_pointers_.scan_buffer)((write_pointers_.scan_buffer + 1) % scan_buffer_.size());
+	const auto next_write_pointer = decltype(write_pointers_.scan_buffer)((write_pointers_.scan_buffer + 1) % ScanBufferSize);
 
 	// Check whether that's too many.
 	if(next_write_pointer == read_pointers.scan_buffer) {
@@ -156,7 +255,6 @@ Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
 
 void ScanTarget::end_scan() {
 	if(vended_scan_) {
-		std::lock_guard<std::mutex> lock_guard(write_pointers_mutex_);
 		vended_scan_->data_y = TextureAddressGetY(vended_write_area_pointer_);
 		vended_scan_->line = write_pointers_.line;
 		vended_scan_->scan.end_points[0].data_offset += TextureAddressGetX(vended_write_area_pointer_);
@@ -181,8 +279,7 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 
 	if(allocation_has_failed_) return nullptr;
 
-	std::lock_guard<std::mutex> lock_guard(write_pointers_mutex_);
-	if(write_area_texture_.empty()) {
+	if(!data_type_size_) {
 		allocation_has_failed_ = true;
 		return nullptr;
 	}
@@ -219,7 +316,7 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 	data_is_allocated_ = true;
 	vended_write_area_pointer_ = write_pointers_.write_area = TextureAddress(aligned_start_x, output_y);
 
-	assert(write_pointers_.write_area >= 1 && ((size_t(write_pointers_.write_area) + required_length + 1) * data_type_size_) <= write_area_texture_.size());
+	assert(write_pointers_.write_area >= 1 && ((size_t(write_pointers_.write_area) + required_length + 1) * data_type_size_) <= WriteAreaWidth*WriteAreaHeight*data_type_size_);
 	return &write_area_texture_[size_t(write_pointers_.write_area) * data_type_size_];
 
 	// Note state at exit:
@@ -229,8 +326,6 @@ uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignmen
 void ScanTarget::end_data(size_t actual_length) {
 	if(allocation_has_failed_ || !data_is_allocated_) return;
 
-	std::lock_guard<std::mutex> lock_guard(write_pointers_mutex_);
-
 	// Bookend the start of the new data, to safeguard for precision errors in sampling.
 	memcpy(
 		&write_area_texture_[size_t(write_pointers_.write_area - 1) * data_type_size_],
@@ -249,7 +344,7 @@ void ScanTarget::end_data(size_t actual_length) {
 	// The write area was allocated in the knowledge that there's sufficient
 	// distance left on the current line, but there's a risk of exactly filling
 	// the final line, in which case this should wrap back to 0.
-	write_pointers_.write_area %= (write_area_texture_.size() / data_type_size_);
+	write_pointers_.write_area %= WriteAreaWidth*WriteAreaHeight;
 
 	// Record that no further end_data calls are expected.
 	data_is_allocated_ = false;
@@ -277,7 +372,6 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 	if(output_is_visible_ == is_visible) return;
 	if(is_visible) {
 		const auto read_pointers = read_pointers_.load();
-		std::lock_guard<std::mutex> lock_guard(write_pointers_mutex_);
 
 		// Commit the most recent line only if any scans fell on it.
 		// Otherwise there's no point outputting it, it'll contribute nothing.
@@ -345,23 +439,6 @@ void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::
 }
 
 void ScanTarget::setup_pipeline() {
-	const auto data_type_size = Outputs::Display::size_for_data_type(modals_.input_data_type);
-
-	// Ensure the lock guard here has a restricted scope; this is the only time that a thread
-	// other than the main owner of write_pointers_ may adjust it.
-	{
-		std::lock_guard<std::mutex> lock_guard(write_pointers_mutex_);
-		if(data_type_size != data_type_size_) {
-			// TODO: flush output.
-
-			data_type_size_ = data_type_size;
-			write_area_texture_.resize(WriteAreaWidth*WriteAreaHeight*data_type_size_);
-
-			write_pointers_.scan_buffer = 0;
-			write_pointers_.write_area = 0;
-		}
-	}
-
 	// Prepare to bind line shaders.
 	test_gl(glBindVertexArray, line_vertex_array_);
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, line_buffer_name_);
@@ -409,6 +486,12 @@ bool ScanTarget::is_soft_display_type() {
 }
 
 void ScanTarget::update(int output_width, int output_height) {
+	// Spin until the is-drawing flag is reset; the wait sync below will deal
+	// with instances where waiting is inappropriate. The fence and the pointers
+	// it guards are also subject to reset by set_modals, so are inspected only
+	// while holding the flag.
+	while(is_updating_.test_and_set());
+
 	if(fence_ != nullptr) {
 		// if the GPU is still busy, don't wait; we'll catch it next time
 		if(glClientWaitSync(fence_, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
@@ -416,19 +499,22 @@ void ScanTarget::update(int output_width, int output_height) {
 				lines_submitted_,
 				std::chrono::high_resolution_clock::now() - line_submission_begin_time_,
 				false);
+			is_updating_.clear();
 			return;
 		}
 		fence_ = nullptr;
+
+		// If buffers are drawn from in place, only now is it safe to let the
+		// producer reuse whatever was consumed by the previous update.
+		if(uses_persistent_buffers_) {
+			read_pointers_.store(draw_pointers_);
+		}
 	}
 	display_metrics_.announce_draw_status(
 		lines_submitted_,
 		std::chrono::high_resolution_clock::now() - line_submission_begin_time_,
 		true);
 
-	// Spin until the is-drawing flag is reset; the wait sync above will deal
-	// with instances where waiting is inappropriate.
-	while(is_updating_.test_and_set());
-
 	// Establish the pipeline if necessary.
 	const bool did_setup_pipeline = modals_are_dirty_;
 	if(modals_are_dirty_) {
@@ -441,14 +527,14 @@ void ScanTarget::update(int output_width, int output_height) {
 
 	// Grab the current read and submit pointers.
 	const auto submit_pointers = submit_pointers_.load();
-	const auto read_pointers = read_pointers_.load();
+	const auto read_pointers = draw_pointers_;
 
 	// Determine how many lines are about to be submitted.
-	lines_submitted_ = (read_pointers.line + line_buffer_.size() - submit_pointers.line) % line_buffer_.size();
+	lines_submitted_ = (read_pointers.line + LineBufferHeight - submit_pointers.line) % LineBufferHeight;
 
-	// Submit scans; only the new ones need to be communicated.
-	size_t new_scans = (submit_pointers.scan_buffer + scan_buffer_.size() - read_pointers.scan_buffer) % scan_buffer_.size();
-	if(new_scans) {
+	// Submit scans; only the new ones need to be communicated, and only if they aren't already in place.
+	size_t new_scans = (submit_pointers.scan_buffer + ScanBufferSize - read_pointers.scan_buffer) % ScanBufferSize;
+	if(new_scans && !uses_persistent_buffers_) {
 		test_gl(glBindBuffer, GL_ARRAY_BUFFER, scan_buffer_name_);
 
 		// Map only the required portion of the buffer.
@@ -461,7 +547,7 @@ void ScanTarget::update(int output_width, int output_height) {
 		if(read_pointers.scan_buffer < submit_pointers.scan_buffer) {
 			memcpy(destination, &scan_buffer_[read_pointers.scan_buffer], new_scans_size);
 		} else {
-			const size_t first_portion_length = (scan_buffer_.size() - read_pointers.scan_buffer) * sizeof(Scan);
+			const size_t first_portion_length = (ScanBufferSize - read_pointers.scan_buffer) * sizeof(Scan);
 			memcpy(destination, &scan_buffer_[read_pointers.scan_buffer], first_portion_length);
 			memcpy(&destination[first_portion_length], &scan_buffer_[0], new_scans_size - first_portion_length);
 		}
@@ -496,6 +582,15 @@ void ScanTarget::update(int output_width, int output_height) {
 			texture_exists_ = true;
 		}
 
+		// If the write area is persistently mapped, copy from it on the GPU by sourcing
+		// texture data from the pixel unpack buffer; source addresses are then offsets.
+		if(uses_persistent_buffers_) {
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, write_area_buffer_name_);
+		}
+		const auto source = [this] (size_t offset) -> const GLvoid * {
+			return uses_persistent_buffers_ ? reinterpret_cast<const GLvoid *>(offset) : &write_area_texture_[offset];
+		};
+
 		const auto start_y = TextureAddressGetY(read_pointers.write_area);
 		const auto end_y = TextureAddressGetY(submit_pointers.write_area);
 		if(end_y >= start_y) {
@@ -507,7 +602,7 @@ void ScanTarget::update(int output_width, int output_height) {
 				1 + end_y - start_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[size_t(TextureAddress(0, start_y)) * data_type_size_]);
+				source(size_t(TextureAddress(0, start_y)) * data_type_size_));
 		} else {
 			// The circular buffer wrapped around; submit the data from the read pointer to the end of
 			// the buffer and from the start of the buffer to the submit pointer.
@@ -518,7 +613,7 @@ void ScanTarget::update(int output_width, int output_height) {
 				1 + end_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[0]);
+				source(0));
 			test_gl(glTexSubImage2D,
 				GL_TEXTURE_2D, 0,
 				0, start_y,
@@ -526,7 +621,11 @@ void ScanTarget::update(int output_width, int output_height) {
 				WriteAreaHeight - start_y,
 				formatForDepth(data_type_size_),
 				GL_UNSIGNED_BYTE,
-				&write_area_texture_[size_t(TextureAddress(0, start_y)) * data_type_size_]);
+				source(size_t(TextureAddress(0, start_y)) * data_type_size_));
+		}
+
+		if(uses_persistent_buffers_) {
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
 		}
 	}
 
@@ -535,7 +634,7 @@ void ScanTarget::update(int output_width, int output_height) {
 		unprocessed_line_texture_.bind_framebuffer();
 
 		// Clear newly-touched lines; that is everything from (read+1) to submit.
-		const uint16_t first_line_to_clear = (read_pointers.line+1)%line_buffer_.size();
+		const uint16_t first_line_to_clear = (read_pointers.line+1)%LineBufferHeight;
 		const uint16_t final_line_to_clear = submit_pointers.line;
 		if(first_line_to_clear != final_line_to_clear) {
 			test_gl(glEnable, GL_SCISSOR_TEST);
@@ -565,7 +664,7 @@ void ScanTarget::update(int output_width, int output_height) {
 		// Apply new spans. They definitely always go to the first buffer.
 		test_gl(glBindVertexArray, scan_vertex_array_);
 		input_shader_->bind();
-		test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(new_scans));
+		draw_instances(read_pointers.scan_buffer, new_scans, ScanBufferSize);
 	}
 
 	// Logic for reducing resolution: start doing so if the metrics object reports that
@@ -672,24 +771,26 @@ void ScanTarget::update(int output_width, int output_height) {
 				}
 			}
 
-			// Upload.
-			const auto buffer_size = lines * sizeof(Line);
-			if(!end_line || end_line > start_line) {
-				test_gl(glBufferSubData, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), &line_buffer_[start_line]);
-			} else {
-				uint8_t *destination = static_cast<uint8_t *>(
-					glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT)
-				);
-				assert(destination);
-				test_gl_error();
-
-				const size_t buffer_length = line_buffer_.size() * sizeof(Line);
-				const size_t start_position = start_line * sizeof(Line);
-				memcpy(&destination[0], &line_buffer_[start_line], buffer_length - start_position);
-				memcpy(&destination[buffer_length - start_position], &line_buffer_[0], end_line * sizeof(Line));
-
-				test_gl(glFlushMappedBufferRange, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size));
-				test_gl(glUnmapBuffer, GL_ARRAY_BUFFER);
+			// Upload, if lines aren't already in place.
+			if(!uses_persistent_buffers_) {
+				const auto buffer_size = lines * sizeof(Line);
+				if(!end_line || end_line > start_line) {
+					test_gl(glBufferSubData, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), &line_buffer_[start_line]);
+				} else {
+					uint8_t *destination = static_cast<uint8_t *>(
+						glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT)
+					);
+					assert(destination);
+					test_gl_error();
+
+					const size_t buffer_length = LineBufferHeight * sizeof(Line);
+					const size_t start_position = start_line * sizeof(Line);
+					memcpy(&destination[0], &line_buffer_[start_line], buffer_length - start_position);
+					memcpy(&destination[buffer_length - start_position], &line_buffer_[0], end_line * sizeof(Line));
+
+					test_gl(glFlushMappedBufferRange, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size));
+					test_gl(glUnmapBuffer, GL_ARRAY_BUFFER);
+				}
 			}
 
 			// Produce colour information, if required.
@@ -701,7 +802,7 @@ void ScanTarget::update(int output_width, int output_height) {
 
 				test_gl(glDisable, GL_BLEND);
 				test_gl(glDisable, GL_STENCIL_TEST);
-				test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+				draw_instances(start_line, lines, LineBufferHeight);
 
 				accumulation_texture_->bind_framebuffer();
 				output_shader_->bind();
@@ -710,7 +811,7 @@ void ScanTarget::update(int output_width, int output_height) {
 			}
 
 			// Render to the output.
-			test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+			draw_instances(start_line, lines, LineBufferHeight);
 
 			start_line = end_line;
 			new_lines -= lines;
@@ -724,9 +825,13 @@ void ScanTarget::update(int output_width, int output_height) {
 	// That's it for operations affecting the accumulation buffer.
 	is_drawing_to_accumulation_buffer_.clear();
 
-	// All data now having been spooled to the GPU, update the read pointers to
-	// the submit pointer location.
-	read_pointers_.store(submit_pointers);
+	// All data now having been spooled to the GPU, update the draw pointers to
+	// the submit pointer location. The read pointers follow immediately if data
+	// was copied, or once the fence below has passed if it is being drawn in place.
+	draw_pointers_ = submit_pointers;
+	if(!uses_persistent_buffers_) {
+		read_pointers_.store(submit_pointers);
+	}
 
 	// Grab a fence sync object to avoid busy waiting upon the next extry into this
 	// function, and reset the is_updating_ flag.
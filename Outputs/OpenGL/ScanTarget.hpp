@@ -68,6 +68,8 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		static constexpr int LineBufferWidth = 2048;
 		static constexpr int LineBufferHeight = 2048;
 
+		static constexpr size_t ScanBufferSize = 16384;
+
 		GLuint target_framebuffer_;
 		const float output_gamma_;
 
@@ -114,21 +116,23 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		};
 
 		/// A pointer to the next thing that should be provided to the caller for data.
+		/// This is owned by the producer; it is published to update() only by copying
+		/// it to submit_pointers_ at the end of each line.
 		PointerSet write_pointers_;
 
-		/// A mutex for gettng access to write_pointers_; access to write_pointers_,
-		/// data_type_size_ or write_area_texture_ is almost never contended, so this
-		/// is cheap for the main use case.
-		std::mutex write_pointers_mutex_;
-
 		/// A pointer to the final thing currently cleared for submission.
 		std::atomic<PointerSet> submit_pointers_;
 
-		/// A pointer to the first thing not yet submitted for display.
+		/// A pointer to the first thing that may not yet be overwritten. If buffers are
+		/// persistently mapped then this trails draw_pointers_ until the GPU has finished
+		/// with the frame that consumed the intervening data.
 		std::atomic<PointerSet> read_pointers_;
 
+		/// A pointer to the first thing not yet submitted for display; this is used only by update().
+		PointerSet draw_pointers_;
+
 		/// Maintains a buffer of the most recent scans.
-		std::array<Scan, 16384> scan_buffer_;
+		Scan *scan_buffer_ = nullptr;
 
 		// Maintains a list of composite scan buffer coordinates; the Line struct
 		// is transported to the GPU in its entirety; the LineMetadatas live in CPU
@@ -146,7 +150,7 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 			bool is_first_in_frame;
 			bool previous_frame_was_complete;
 		};
-		std::array<Line, LineBufferHeight> line_buffer_;
+		Line *line_buffer_ = nullptr;
 		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
 
 		// Contains the first composition of scans into lines;
@@ -174,12 +178,22 @@ class ScanTarget: public Outputs::Display::ScanTarget {
 		// OpenGL storage handles for buffer data.
 		GLuint scan_buffer_name_ = 0, scan_vertex_array_ = 0;
 		GLuint line_buffer_name_ = 0, line_vertex_array_ = 0;
+		GLuint write_area_buffer_name_ = 0;
+
+		// If OpenGL 4.4 or later is available, scan_buffer_, line_buffer_ and write_area_texture_
+		// point directly into persistently-mapped, coherent GPU buffers and are drawn from in place;
+		// otherwise they point into the CPU-side storage below and are copied to the GPU in update().
+		bool uses_persistent_buffers_ = false;
+		std::vector<Scan> scan_buffer_storage_;
+		std::vector<Line> line_buffer_storage_;
+		std::vector<uint8_t> write_area_texture_storage_;
 
-		template <typename T> void allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
-		template <typename T> void patch_buffer(const T &array, GLuint target, uint16_t submit_pointer, uint16_t read_pointer);
+		void allocate_buffers();
+		uint8_t *allocate_buffer(GLenum target, size_t size, GLuint &buffer_name);
+		void draw_instances(size_t start, size_t count, size_t buffer_size);
 
 		// Uses a texture to vend write areas.
-		std::vector<uint8_t> write_area_texture_;
+		uint8_t *write_area_texture_ = nullptr;
 		size_t data_type_size_ = 0;
 
 		GLuint write_area_texture_name_ = 0;
@@ -0,0 +1,889 @@
+//
+//  ScanTarget.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ScanTarget.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.1415926f
+#endif
+
+using namespace Outputs::Display::Software;
+
+namespace {
+
+// MARK: - Line kernels.
+
+/*!
+	Applies the column-major 3x3 matrix @c m to each of the @c count vectors formed
+	by taking one element from each of @c a, @c b and @c c, in place.
+*/
+void transform_planes_scalar(const float *m, float *a, float *b, float *c, size_t count) {
+	for(size_t index = 0; index < count; ++index) {
+		const float x = a[index], y = b[index], z = c[index];
+		a[index] = m[0]*x + m[3]*y + m[6]*z;
+		b[index] = m[1]*x + m[4]*y + m[7]*z;
+		c[index] = m[2]*x + m[5]*y + m[8]*z;
+	}
+}
+
+/*!
+	Writes @c count RGBA pixels to @c destination, taking colour components from @c red,
+	@c green and @c blue, each of which is scaled by @c brightness and clamped to [0, 1].
+*/
+void pack_rgba_scalar(const float *red, const float *green, const float *blue, float brightness, uint8_t *destination, size_t count) {
+	const auto component = [brightness] (float value) {
+		return uint8_t(std::clamp(value * brightness, 0.0f, 1.0f) * 255.0f + 0.5f);
+	};
+	for(size_t index = 0; index < count; ++index) {
+		destination[0] = component(red[index]);
+		destination[1] = component(green[index]);
+		destination[2] = component(blue[index]);
+		destination[3] = 0xff;
+		destination += 4;
+	}
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+void transform_planes(const float *m, float *a, float *b, float *c, size_t count) {
+	size_t index = 0;
+	for(; index + 4 <= count; index += 4) {
+		const __m128 x = _mm_loadu_ps(&a[index]);
+		const __m128 y = _mm_loadu_ps(&b[index]);
+		const __m128 z = _mm_loadu_ps(&c[index]);
+
+		const auto row = [&] (int offset) {
+			return _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[offset])), _mm_mul_ps(y, _mm_set1_ps(m[offset + 3]))),
+				_mm_mul_ps(z, _mm_set1_ps(m[offset + 6])));
+		};
+		_mm_storeu_ps(&a[index], row(0));
+		_mm_storeu_ps(&b[index], row(1));
+		_mm_storeu_ps(&c[index], row(2));
+	}
+	transform_planes_scalar(m, &a[index], &b[index], &c[index], count - index);
+}
+
+void pack_rgba(const float *red, const float *green, const float *blue, float brightness, uint8_t *destination, size_t count) {
+	const __m128 scale = _mm_set1_ps(brightness * 255.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 maximum = _mm_set1_ps(255.0f);
+	const __m128i alpha = _mm_set1_epi32(int(0xff000000));
+
+	// _mm_cvtps_epi32 rounds to nearest under the default rounding mode.
+	const auto component = [&] (const float *source) {
+		return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(source), scale), zero), maximum));
+	};
+
+	size_t index = 0;
+	for(; index + 4 <= count; index += 4) {
+		const __m128i pixels = _mm_or_si128(
+			_mm_or_si128(component(&red[index]), _mm_slli_epi32(component(&green[index]), 8)),
+			_mm_or_si128(_mm_slli_epi32(component(&blue[index]), 16), alpha));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&destination[index * 4]), pixels);
+	}
+	pack_rgba_scalar(&red[index], &green[index], &blue[index], brightness, &destination[index * 4], count - index);
+}
+
+#elif defined(__aarch64__)
+
+void transform_planes(const float *m, float *a, float *b, float *c, size_t count) {
+	size_t index = 0;
+	for(; index + 4 <= count; index += 4) {
+		const float32x4_t x = vld1q_f32(&a[index]);
+		const float32x4_t y = vld1q_f32(&b[index]);
+		const float32x4_t z = vld1q_f32(&c[index]);
+
+		const auto row = [&] (int offset) {
+			return vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(x, m[offset]), y, m[offset + 3]), z, m[offset + 6]);
+		};
+		vst1q_f32(&a[index], row(0));
+		vst1q_f32(&b[index], row(1));
+		vst1q_f32(&c[index], row(2));
+	}
+	transform_planes_scalar(m, &a[index], &b[index], &c[index], count - index);
+}
+
+void pack_rgba(const float *red, const float *green, const float *blue, float brightness, uint8_t *destination, size_t count) {
+	const float scale = brightness * 255.0f;
+	const auto component = [&] (const float *source) {
+		return vcvtnq_u32_f32(vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(source), scale), vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f)));
+	};
+
+	size_t index = 0;
+	for(; index + 4 <= count; index += 4) {
+		const uint32x4_t pixels = vorrq_u32(
+			vorrq_u32(component(&red[index]), vshlq_n_u32(component(&green[index]), 8)),
+			vorrq_u32(vshlq_n_u32(component(&blue[index]), 16), vdupq_n_u32(0xff000000)));
+		vst1q_u8(&destination[index * 4], vreinterpretq_u8_u32(pixels));
+	}
+	pack_rgba_scalar(&red[index], &green[index], &blue[index], brightness, &destination[index * 4], count - index);
+}
+
+#else
+
+void transform_planes(const float *m, float *a, float *b, float *c, size_t count) {
+	transform_planes_scalar(m, a, b, c, count);
+}
+
+void pack_rgba(const float *red, const float *green, const float *blue, float brightness, uint8_t *destination, size_t count) {
+	pack_rgba_scalar(red, green, blue, brightness, destination, count);
+}
+
+#endif
+
+/*!
+	Applies a five-tap filter spanning exactly one colour cycle at four samples per cycle,
+	which entirely removes a subcarrier sampled at that rate, to @c source, writing the
+	result to @c destination. The first and final two samples are left unfiltered.
+*/
+void filter_colour_cycle(const float *source, float *destination, size_t count) {
+	if(count < 5) {
+		std::copy(source, source + count, destination);
+		return;
+	}
+
+	destination[0] = source[0];
+	destination[1] = source[1];
+	for(size_t index = 2; index < count - 2; ++index) {
+		destination[index] =
+			(source[index - 2] + source[index + 2]) * 0.125f +
+			(source[index - 1] + source[index] + source[index + 1]) * 0.25f;
+	}
+	destination[count - 2] = source[count - 2];
+	destination[count - 1] = source[count - 1];
+}
+
+// MARK: - Input decoding.
+
+/*!
+	Decodes a single sample of input of type @c type at @c source to four channels at
+	@c target, normalised as per the OpenGL scan target's composition shader.
+*/
+template <Outputs::Display::InputDataType type> void decode(const uint8_t *source, float *target) {
+	using InputDataType = Outputs::Display::InputDataType;
+	switch(type) {
+		case InputDataType::Luminance1:
+			target[0] = target[1] = target[2] = target[3] = source[0] ? 1.0f : 0.0f;
+		break;
+
+		case InputDataType::Luminance8:
+			target[0] = target[1] = target[2] = target[3] = float(source[0]) / 255.0f;
+		break;
+
+		case InputDataType::Luminance8Phase8:
+			target[0] = float(source[0]) / 255.0f;
+			target[1] = float(source[1]) / 255.0f;
+			target[2] = target[3] = 0.0f;
+		break;
+
+		case InputDataType::PhaseLinkedLuminance8:
+		case InputDataType::Red8Green8Blue8:
+			target[0] = float(source[0]) / 255.0f;
+			target[1] = float(source[1]) / 255.0f;
+			target[2] = float(source[2]) / 255.0f;
+			target[3] = float(source[3]) / 255.0f;
+		break;
+
+		case InputDataType::Red1Green1Blue1:
+			target[0] = (source[0] & 4) ? 1.0f : 0.0f;
+			target[1] = (source[0] & 2) ? 1.0f : 0.0f;
+			target[2] = (source[0] & 1) ? 1.0f : 0.0f;
+			target[3] = 1.0f;
+		break;
+
+		case InputDataType::Red2Green2Blue2:
+			target[0] = float((source[0] >> 4) & 3) / 3.0f;
+			target[1] = float((source[0] >> 2) & 3) / 3.0f;
+			target[2] = float(source[0] & 3) / 3.0f;
+			target[3] = 1.0f;
+		break;
+
+		case InputDataType::Red4Green4Blue4:
+			target[0] = std::min(float(source[0]) / 15.0f, 1.0f);
+			target[1] = float(source[1] & 0xf0) / 240.0f;
+			target[2] = float(source[1] & 0x0f) / 15.0f;
+			target[3] = 1.0f;
+		break;
+	}
+}
+
+/*!
+	Composes the clocks [@c start_clock, @c end_clock) of the scan with data starting at
+	@c data, at @c data_size bytes per sample, that runs from @c scan_start to @c scan_end
+	and from data offset 0 to @c samples, to @c target at four channels per clock.
+*/
+template <Outputs::Display::InputDataType type> void compose(
+	const uint8_t *data, size_t data_size, size_t samples,
+	int scan_start, int scan_end,
+	int start_clock, int end_clock,
+	float *target) {
+	const int length = scan_end - scan_start;
+	for(int clock = start_clock; clock < end_clock; ++clock) {
+		const size_t sample = std::min(size_t(((clock - scan_start) * 2 + 1) * int(samples) / (length * 2)), samples - 1);
+		decode<type>(&data[sample * data_size], target);
+		target += 4;
+	}
+}
+
+}
+
+// MARK: - Lifecycle.
+
+ScanTarget::ScanTarget(int width, int height, float output_gamma, size_t bands) : output_gamma_(output_gamma) {
+	// Ensure proper initialisation of the two atomic pointer sets.
+	read_pointers_.store(write_pointers_);
+	submit_pointers_.store(write_pointers_);
+	is_updating_.clear();
+
+	if(!bands) {
+		bands = std::max(1u, std::thread::hardware_concurrency());
+	}
+	bands_.resize(bands);
+	if(bands > 1) {
+		for(auto &band: bands_) {
+			band.queue = std::make_unique<Concurrency::AsyncTaskQueue>();
+		}
+	}
+
+	set_output_size(width, height);
+}
+
+ScanTarget::~ScanTarget() {
+	while(is_updating_.test_and_set());
+}
+
+void ScanTarget::set_output_size(int width, int height) {
+	while(is_updating_.test_and_set());
+
+	width_ = std::max(width, 1);
+	height_ = std::max(height, 1);
+	pixels_.resize(size_t(width_ * height_ * 4));
+	for(size_t index = 0; index < pixels_.size(); index += 4) {
+		pixels_[index + 0] = pixels_[index + 1] = pixels_[index + 2] = 0x00;
+		pixels_[index + 3] = 0xff;
+	}
+	row_frames_.assign(size_t(height_), 0);
+
+	const int band_count = int(bands_.size());
+	for(int index = 0; index < band_count; ++index) {
+		bands_[size_t(index)].first_row = (index * height_) / band_count;
+		bands_[size_t(index)].end_row = ((index + 1) * height_) / band_count;
+		bands_[size_t(index)].row.resize(size_t(width_ * 4));
+	}
+
+	is_updating_.clear();
+}
+
+const uint8_t *ScanTarget::get_pixels() const {
+	return pixels_.data();
+}
+
+int ScanTarget::get_width() const {
+	return width_;
+}
+
+int ScanTarget::get_height() const {
+	return height_;
+}
+
+Outputs::Display::Metrics &ScanTarget::display_metrics() {
+	return display_metrics_;
+}
+
+// MARK: - Input.
+
+void ScanTarget::set_modals(Modals modals) {
+	// Don't change the modals while drawing is ongoing; a previous set might be
+	// in the process of being established.
+	while(is_updating_.test_and_set());
+	modals_ = modals;
+	modals_are_dirty_ = true;
+
+	// As per the OpenGL scan target, the write area and write_pointers_ are adjusted here,
+	// on the producer's thread, while update() is excluded.
+	const auto data_type_size = Outputs::Display::size_for_data_type(modals_.input_data_type);
+	if(data_type_size != data_type_size_) {
+		data_type_size_ = data_type_size;
+		write_area_.resize(WriteAreaSize * data_type_size_);
+
+		// Anything already buffered was in the old format, so discard it.
+		write_pointers_ = PointerSet();
+		active_line_ = nullptr;
+		provided_scans_ = 0;
+		submit_pointers_.store(write_pointers_);
+		read_pointers_.store(write_pointers_);
+	}
+
+	is_updating_.clear();
+}
+
+Outputs::Display::ScanTarget::Scan *ScanTarget::begin_scan() {
+	if(allocation_has_failed_) return nullptr;
+
+	const auto result = &scan_buffer_[write_pointers_.scan_buffer];
+	const auto read_pointers = read_pointers_.load();
+
+	// Advance the pointer.
+	const auto next_write_pointer = decltype(write_pointers_.scan_buffer)((write_pointers_.scan_buffer + 1) % scan_buffer_.size());
+
+	// Check whether that's too many.
+	if(next_write_pointer == read_pointers.scan_buffer) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+	write_pointers_.scan_buffer = next_write_pointer;
+	++provided_scans_;
+
+	result->line = write_pointers_.line;
+
+	vended_scan_ = result;
+	return &result->scan;
+}
+
+void ScanTarget::end_scan() {
+	if(vended_scan_) {
+		vended_scan_->data_base = vended_write_area_pointer_;
+		vended_scan_->line = write_pointers_.line;
+	}
+	vended_scan_ = nullptr;
+}
+
+uint8_t *ScanTarget::begin_data(size_t required_length, size_t required_alignment) {
+	assert(required_alignment);
+
+	if(allocation_has_failed_) return nullptr;
+
+	if(write_area_.empty() || required_length >= WriteAreaSize) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	// Determine where the proposed write area would start and end, wrapping
+	// back to the start of the buffer if there's insufficient space at the end.
+	size_t start = write_pointers_.write_area;
+	start += (required_alignment - start % required_alignment) % required_alignment;
+	if(start + required_length > WriteAreaSize) {
+		start = 0;
+	}
+	const size_t end = start + required_length;
+
+	// Check that neither the allocation nor any space skipped over at the end of the
+	// buffer overlaps anything not yet output.
+	const size_t read_pointer = read_pointers_.load().write_area;
+	const size_t used = (write_pointers_.write_area + WriteAreaSize - read_pointer) % WriteAreaSize;
+	const size_t span = (start < write_pointers_.write_area) ? (WriteAreaSize - write_pointers_.write_area + end) : (end - write_pointers_.write_area);
+	if(used + span >= WriteAreaSize) {
+		allocation_has_failed_ = true;
+		return nullptr;
+	}
+
+	// Everything checks out, note expectation of a future end_data and return the pointer.
+	data_is_allocated_ = true;
+	vended_write_area_pointer_ = write_pointers_.write_area = uint32_t(start);
+	return &write_area_[start * data_type_size_];
+}
+
+void ScanTarget::end_data(size_t actual_length) {
+	if(allocation_has_failed_ || !data_is_allocated_) return;
+
+	// Advance to the end of the current run, wrapping if that exactly fills the buffer.
+	write_pointers_.write_area = uint32_t((write_pointers_.write_area + actual_length) % WriteAreaSize);
+
+	// Record that no further end_data calls are expected.
+	data_is_allocated_ = false;
+}
+
+void ScanTarget::will_change_owner() {
+	allocation_has_failed_ = true;
+	vended_scan_ = nullptr;
+}
+
+void ScanTarget::announce(Event event, bool is_visible, const Outputs::Display::ScanTarget::Scan::EndPoint &location, uint8_t composite_amplitude) {
+	// Forward the event to the display metrics tracker.
+	display_metrics_.announce_event(event);
+
+	if(event == ScanTarget::Event::EndVerticalRetrace) {
+		// As per the OpenGL scan target, the previous-frame-is-complete flag is subject to
+		// a two-slot queue; it'll be attached to the first successful line output.
+		is_first_in_frame_ = true;
+		previous_frame_was_complete_ = frame_is_complete_;
+		frame_is_complete_ = true;
+	}
+
+	if(output_is_visible_ == is_visible) return;
+	if(is_visible) {
+		const auto read_pointers = read_pointers_.load();
+
+		// Commit the most recent line only if any scans fell on it.
+		// Otherwise there's no point outputting it, it'll contribute nothing.
+		if(provided_scans_) {
+			// Store metadata if concluding a previous line.
+			if(active_line_) {
+				line_metadata_buffer_[size_t(write_pointers_.line)].is_first_in_frame = is_first_in_frame_;
+				line_metadata_buffer_[size_t(write_pointers_.line)].previous_frame_was_complete = previous_frame_was_complete_;
+				is_first_in_frame_ = false;
+			}
+
+			// Attempt to allocate a new line; note allocation failure if necessary.
+			const auto next_line = uint16_t((write_pointers_.line + 1) % LineBufferHeight);
+			if(next_line == read_pointers.line) {
+				allocation_has_failed_ = true;
+				active_line_ = nullptr;
+			} else {
+				write_pointers_.line = next_line;
+				active_line_ = &line_buffer_[size_t(write_pointers_.line)];
+			}
+			provided_scans_ = 0;
+		}
+
+		if(active_line_) {
+			active_line_->end_points[0].x = location.x;
+			active_line_->end_points[0].y = location.y;
+			active_line_->end_points[0].cycles_since_end_of_horizontal_retrace = location.cycles_since_end_of_horizontal_retrace;
+			active_line_->end_points[0].composite_angle = location.composite_angle;
+			active_line_->composite_amplitude = composite_amplitude;
+		}
+	} else {
+		if(active_line_) {
+			// A successfully-allocated line is ending.
+			active_line_->end_points[1].x = location.x;
+			active_line_->end_points[1].y = location.y;
+			active_line_->end_points[1].cycles_since_end_of_horizontal_retrace = location.cycles_since_end_of_horizontal_retrace;
+			active_line_->end_points[1].composite_angle = location.composite_angle;
+		}
+
+		// A line is complete; submit latest updates if nothing failed.
+		if(allocation_has_failed_) {
+			// Reset all pointers to where they were.
+			write_pointers_ = submit_pointers_.load();
+			frame_is_complete_ = false;
+		} else {
+			// Advance submit pointer.
+			submit_pointers_.store(write_pointers_);
+		}
+		allocation_has_failed_ = false;
+	}
+	output_is_visible_ = is_visible;
+}
+
+// MARK: - Output.
+
+void ScanTarget::setup_pipeline() {
+	switch(modals_.composite_colour_space) {
+		case ColourSpace::YIQ: {
+			const float rgb_to_yiq[] = {0.299f, 0.596f, 0.211f, 0.587f, -0.274f, -0.523f, 0.114f, -0.322f, 0.312f};
+			const float yiq_to_rgb[] = {1.0f, 1.0f, 1.0f, 0.956f, -0.272f, -1.106f, 0.621f, -0.647f, 1.703f};
+			std::copy(std::begin(rgb_to_yiq), std::end(rgb_to_yiq), conversion_.rgb_to_luma_chroma);
+			std::copy(std::begin(yiq_to_rgb), std::end(yiq_to_rgb), conversion_.luma_chroma_to_rgb);
+		} break;
+
+		case ColourSpace::YUV: {
+			const float rgb_to_yuv[] = {0.299f, -0.14713f, 0.615f, 0.587f, -0.28886f, -0.51499f, 0.114f, 0.436f, -0.10001f};
+			const float yuv_to_rgb[] = {1.0f, 1.0f, 1.0f, 0.0f, -0.39465f, 2.03211f, 1.13983f, -0.58060f, 0.0f};
+			std::copy(std::begin(rgb_to_yuv), std::end(rgb_to_yuv), conversion_.rgb_to_luma_chroma);
+			std::copy(std::begin(yuv_to_rgb), std::end(yuv_to_rgb), conversion_.luma_chroma_to_rgb);
+		} break;
+	}
+
+	// Apply brightness and gamma adjustments only if they're significant, as per the OpenGL target.
+	conversion_.brightness = (std::fabs(modals_.brightness - 1.0f) > 0.05f) ? modals_.brightness : 1.0f;
+	conversion_.apply_gamma = std::fabs(output_gamma_ - modals_.intended_gamma) > 0.05f;
+	if(conversion_.apply_gamma) {
+		const float gamma_ratio = output_gamma_ / modals_.intended_gamma;
+		for(size_t index = 0; index < conversion_.gamma.size(); ++index) {
+			conversion_.gamma[index] = uint8_t(std::pow(float(index) / 255.0f, gamma_ratio) * 255.0f + 0.5f);
+		}
+	}
+}
+
+void ScanTarget::update() {
+	while(is_updating_.test_and_set());
+
+	if(modals_are_dirty_) {
+		setup_pipeline();
+		modals_are_dirty_ = false;
+	}
+
+	const auto begin_time = std::chrono::high_resolution_clock::now();
+
+	// Grab the current read and submit pointers.
+	const auto submit_pointers = submit_pointers_.load();
+	const auto read_pointers = read_pointers_.load();
+
+	// Lines are output one behind the submit pointer; the metadata of the line
+	// at the submit pointer isn't yet final.
+	const uint16_t new_lines = uint16_t((submit_pointers.line + LineBufferHeight - read_pointers.line) % LineBufferHeight);
+	for(uint16_t offset = 0; offset < new_lines; ++offset) {
+		auto &metadata = line_metadata_buffer_[(read_pointers.line + offset) % LineBufferHeight];
+		metadata.first_scan = metadata.end_scan = 0;
+		if(metadata.is_first_in_frame) ++frame_;
+		metadata.frame = frame_;
+	}
+
+	// Attribute scans to lines, stopping at the first that belongs to the line still being built;
+	// that and everything after it is retained for the next update.
+	PointerSet consumed_pointers = submit_pointers;
+	first_update_scan_ = read_pointers.scan_buffer;
+	uint32_t scan_offset = 0;
+	for(uint16_t scan = read_pointers.scan_buffer; scan != submit_pointers.scan_buffer; scan = uint16_t((scan + 1) % scan_buffer_.size())) {
+		const uint16_t line = scan_buffer_[scan].line;
+		if(line == submit_pointers.line) {
+			consumed_pointers.scan_buffer = scan;
+			consumed_pointers.write_area = scan_buffer_[scan].data_base;
+			break;
+		}
+
+		auto &metadata = line_metadata_buffer_[line];
+		if(metadata.first_scan == metadata.end_scan) {
+			metadata.first_scan = scan_offset;
+		}
+		metadata.end_scan = ++scan_offset;
+	}
+
+	// Convert lines, in parallel if there are multiple bands.
+	if(new_lines && data_type_size_) {
+		if(bands_.size() == 1) {
+			convert(bands_[0], read_pointers.line, new_lines);
+		} else {
+			for(auto &band: bands_) {
+				band.queue->enqueue([this, &band, read_pointers, new_lines] {
+					convert(band, read_pointers.line, new_lines);
+				});
+			}
+			for(auto &band: bands_) {
+				band.queue->flush();
+			}
+		}
+	}
+
+	display_metrics_.announce_draw_status(new_lines, std::chrono::high_resolution_clock::now() - begin_time, true);
+
+	// Release everything consumed.
+	consumed_pointers.line = submit_pointers.line;
+	read_pointers_.store(consumed_pointers);
+
+	is_updating_.clear();
+}
+
+void ScanTarget::convert(Band &band, uint16_t start_line, uint16_t count) {
+	for(uint16_t offset = 0; offset < count; ++offset) {
+		const size_t line = (start_line + offset) % LineBufferHeight;
+		const auto &metadata = line_metadata_buffer_[line];
+
+		// Upon each new frame, clear any rows that have been painted in neither this frame nor the
+		// previous, so that interlaced output persists but anything else untouched decays to black.
+		if(metadata.frame != band.frame) {
+			band.frame = metadata.frame;
+			if(metadata.previous_frame_was_complete) {
+				for(int row = band.first_row; row < band.end_row; ++row) {
+					if(row_frames_[size_t(row)] + 2 >= band.frame) continue;
+
+					uint8_t *const target = &pixels_[size_t(row * width_ * 4)];
+					for(int column = 0; column < width_; ++column) {
+						target[column*4 + 0] = target[column*4 + 1] = target[column*4 + 2] = 0x00;
+					}
+					row_frames_[size_t(row)] = band.frame;
+				}
+			}
+		}
+
+		convert_line(band, line);
+	}
+}
+
+void ScanTarget::compose_line(Band &band, size_t line, int start_clock, int end_clock) {
+	const size_t length = size_t(end_clock - start_clock);
+	band.composition.resize(length * 4);
+
+	// Fill with whatever describes black in the input colour encoding.
+	const float luminance_phase_black[] = {0.0f, 1.0f, 0.0f, 0.0f};
+	for(size_t clock = 0; clock < length; ++clock) {
+		if(modals_.input_data_type == InputDataType::Luminance8Phase8) {
+			std::copy(std::begin(luminance_phase_black), std::end(luminance_phase_black), &band.composition[clock * 4]);
+		} else {
+			std::fill(&band.composition[clock * 4], &band.composition[clock * 4 + 4], 0.0f);
+		}
+	}
+
+	// Paint in all scans.
+	const auto &metadata = line_metadata_buffer_[line];
+	for(uint32_t offset = metadata.first_scan; offset < metadata.end_scan; ++offset) {
+		const Scan &scan = scan_buffer_[(first_update_scan_ + offset) % scan_buffer_.size()];
+		if(scan.line != line) continue;
+
+		const int scan_start = scan.scan.end_points[0].cycles_since_end_of_horizontal_retrace;
+		const int scan_end = scan.scan.end_points[1].cycles_since_end_of_horizontal_retrace;
+		const int compose_start = std::max(scan_start, start_clock);
+		const int compose_end = std::min(scan_end, end_clock);
+		if(compose_end <= compose_start) continue;
+
+		const size_t data_start = scan.data_base + scan.scan.end_points[0].data_offset;
+		const size_t data_end = scan.data_base + scan.scan.end_points[1].data_offset;
+		const size_t samples = std::max(data_end, data_start + 1) - data_start;
+		const uint8_t *const data = &write_area_[data_start * data_type_size_];
+		float *const target = &band.composition[size_t(compose_start - start_clock) * 4];
+
+#define Compose(type)	\
+		case type: compose<type>(data, data_type_size_, samples, scan_start, scan_end, compose_start, compose_end, target);	break;
+
+		switch(modals_.input_data_type) {
+			Compose(InputDataType::Luminance1);
+			Compose(InputDataType::Luminance8);
+			Compose(InputDataType::PhaseLinkedLuminance8);
+			Compose(InputDataType::Luminance8Phase8);
+			Compose(InputDataType::Red1Green1Blue1);
+			Compose(InputDataType::Red2Green2Blue2);
+			Compose(InputDataType::Red4Green4Blue4);
+			Compose(InputDataType::Red8Green8Blue8);
+		}
+
+#undef Compose
+	}
+
+	// Accumulate running totals, to allow box filtering over arbitrary spans.
+	band.prefixes.resize((length + 1) * 4);
+	std::fill(&band.prefixes[0], &band.prefixes[4], 0.0f);
+	for(size_t index = 0; index < length * 4; ++index) {
+		band.prefixes[index + 4] = band.prefixes[index] + band.composition[index];
+	}
+}
+
+void ScanTarget::convert_line(Band &band, size_t index) {
+	const Line &line = line_buffer_[index];
+	const LineMetadata &metadata = line_metadata_buffer_[index];
+
+	// Determine which rows of the output this line covers, using the same geometry as the OpenGL
+	// scan target: a row height slightly in excess of the expected line spacing, centred on the line.
+	const float scale_x = float(modals_.output_scale.x);
+	const float scale_y = float(modals_.output_scale.y) * modals_.aspect_ratio * (3.0f / 4.0f);
+	const auto &origin = modals_.visible_area.origin;
+	const auto &size = modals_.visible_area.size;
+
+	const float centre_row = ((float(line.end_points[0].y) / scale_y - origin.y) / size.height) * float(height_);
+	const float row_height = (1.05f / float(modals_.expected_vertical_lines)) / size.height * float(height_);
+
+	int first_row = int(std::ceil(centre_row - row_height * 0.5f - 0.5f));
+	int end_row = int(std::ceil(centre_row + row_height * 0.5f - 0.5f));
+	if(end_row <= first_row) {
+		first_row = int(std::floor(centre_row));
+		end_row = first_row + 1;
+	}
+	first_row = std::max(first_row, band.first_row);
+	end_row = std::min(end_row, band.end_row);
+	if(end_row <= first_row) return;
+
+	// Determine which columns it covers.
+	const float start_x = ((float(line.end_points[0].x) / scale_x - origin.x) / size.width) * float(width_);
+	const float end_x = ((float(line.end_points[1].x) / scale_x - origin.x) / size.width) * float(width_);
+	if(end_x <= start_x) return;
+
+	const int first_column = std::max(int(std::ceil(start_x - 0.5f)), 0);
+	const int end_column = std::min(int(std::ceil(end_x - 0.5f)), width_);
+	if(end_column <= first_column) return;
+	const size_t columns = size_t(end_column - first_column);
+
+	// Compose the line's input.
+	const int start_clock = line.end_points[0].cycles_since_end_of_horizontal_retrace;
+	const int end_clock = line.end_points[1].cycles_since_end_of_horizontal_retrace;
+	if(end_clock <= start_clock) return;
+	compose_line(band, index, start_clock, end_clock);
+
+	const float clocks = float(end_clock - start_clock);
+	const float clocks_per_pixel = clocks / (end_x - start_x);
+
+	// Provides the average of channel @c channel of the composed line over [start, end), in clocks
+	// relative to the start of the line.
+	const auto average = [&band, clocks] (float start, float end, int channel) {
+		const auto total = [&band, clocks, channel] (float position) {
+			position = std::clamp(position, 0.0f, clocks);
+			const size_t index = size_t(position);
+			const float fraction = position - float(index);
+			float result = band.prefixes[index * 4 + size_t(channel)];
+			if(fraction > 0.0f) result += fraction * band.composition[index * 4 + size_t(channel)];
+			return result;
+		};
+
+		start = std::clamp(start, 0.0f, clocks);
+		end = std::clamp(end, 0.0f, clocks);
+		if(end - start < 0.001f) {
+			const size_t index = std::min(size_t(start), size_t(clocks) - 1);
+			return band.composition[index * 4 + size_t(channel)];
+		}
+		return (total(end) - total(start)) / (end - start);
+	};
+
+	band.red.resize(columns);
+	band.green.resize(columns);
+	band.blue.resize(columns);
+
+	if(modals_.display_type == DisplayType::RGB) {
+		// Box filter each pixel's span of clocks.
+		for(size_t column = 0; column < columns; ++column) {
+			const float centre = (float(first_column + int(column)) + 0.5f - start_x) * clocks_per_pixel;
+			const float start = centre - clocks_per_pixel * 0.5f;
+			const float end = centre + clocks_per_pixel * 0.5f;
+			band.red[column] = average(start, end, 0);
+			band.green[column] = average(start, end, 1);
+			band.blue[column] = average(start, end, 2);
+		}
+	} else {
+		// Sample the composite or S-Video signal at exactly four points per colour cycle,
+		// at the zero crossings and peaks of the subcarrier; demodulation then reduces to
+		// multiplication by 0, 1 or -1.
+		//
+		// Composite angles are in 64ths of a colour cycle; they're negative on phase-alternated lines.
+		const bool is_alternate_line = line.end_points[0].composite_angle < 0 || line.end_points[1].composite_angle < 0;
+		const float start_angle = std::fabs(float(line.end_points[0].composite_angle));
+		float end_angle = std::fabs(float(line.end_points[1].composite_angle));
+		if(end_angle <= start_angle) {
+			// Without a meaningful angle range, assume the nominal rate.
+			end_angle = start_angle + clocks * 64.0f * float(modals_.colour_cycle_numerator) / float(modals_.cycles_per_line * modals_.colour_cycle_denominator);
+		}
+		const float clocks_per_angle = clocks / (end_angle - start_angle);
+		const float amplitude = float(line.composite_amplitude) / 255.0f;
+		const bool is_svideo = modals_.display_type == DisplayType::SVideo;
+
+		// Pad by two samples either side, for the filters.
+		const int first_quarter = int(std::floor(start_angle / 16.0f)) - 2;
+		const int end_quarter = int(std::ceil(end_angle / 16.0f)) + 3;
+		const size_t quarters = size_t(end_quarter - first_quarter);
+
+		band.samples.resize(quarters * 2);
+		for(int quarter = first_quarter; quarter < end_quarter; ++quarter) {
+			const float centre = (float(quarter) * 16.0f - start_angle) * clocks_per_angle;
+			float channels[4];
+			for(int channel = 0; channel < 4; ++channel) {
+				channels[channel] = average(centre - 8.0f * clocks_per_angle, centre + 8.0f * clocks_per_angle, channel);
+			}
+
+			static constexpr float cosines[] = {1.0f, 0.0f, -1.0f, 0.0f};
+			static constexpr float sines[] = {0.0f, 1.0f, 0.0f, -1.0f};
+			const float cosine = cosines[quarter & 3];
+			const float sine = is_alternate_line ? -sines[quarter & 3] : sines[quarter & 3];
+
+			// Produce luminance and chrominance, per the OpenGL target's sampling function; luminance-only
+			// input is taken to be a complete composite signal already.
+			float luminance, chrominance = 0.0f;
+			bool is_modulated = false;
+			switch(modals_.input_data_type) {
+				case InputDataType::Luminance1:
+				case InputDataType::Luminance8:
+					luminance = channels[0];
+				break;
+
+				case InputDataType::PhaseLinkedLuminance8:
+					luminance = channels[(is_alternate_line ? 3 : 0) ^ (quarter & 3)];
+				break;
+
+				case InputDataType::Luminance8Phase8: {
+					const float angle = float(quarter) * float(M_PI) * 0.5f * (is_alternate_line ? -1.0f : 1.0f);
+					luminance = channels[0];
+					chrominance = (channels[1] <= 0.75f) ? std::cos(angle + float(M_PI) * 4.0f * channels[1]) : 0.0f;
+					is_modulated = true;
+				} break;
+
+				default: {
+					const float *const m = conversion_.rgb_to_luma_chroma;
+					luminance = m[0]*channels[0] + m[3]*channels[1] + m[6]*channels[2];
+					const float u = m[1]*channels[0] + m[4]*channels[1] + m[7]*channels[2];
+					const float v = m[2]*channels[0] + m[5]*channels[1] + m[8]*channels[2];
+					chrominance = u*cosine + v*sine;
+					is_modulated = true;
+				} break;
+			}
+
+			// S-Video keeps the two separate; composite mixes them per the colour burst amplitude.
+			const size_t index = size_t(quarter - first_quarter);
+			if(is_svideo) {
+				band.samples[index] = luminance;
+				band.samples[quarters + index] = chrominance;
+			} else {
+				band.samples[index] = is_modulated ? luminance + (chrominance - luminance) * amplitude : luminance;
+			}
+		}
+
+		// Separate luminance and chrominance; for composite video that's a filter to remove the
+		// subcarrier from the luminance and then the difference between that and the original.
+		band.luminance.resize(quarters);
+		band.chroma_u.resize(quarters);
+		band.chroma_v.resize(quarters);
+		if(is_svideo) {
+			std::copy(&band.samples[0], &band.samples[quarters], band.luminance.begin());
+		} else {
+			filter_colour_cycle(band.samples.data(), band.luminance.data(), quarters);
+		}
+
+		// Demodulate chrominance.
+		const bool is_colour = modals_.display_type != DisplayType::CompositeMonochrome && (is_svideo || amplitude > 0.0f);
+		if(is_colour) {
+			const float chroma_scale = is_svideo ? 2.0f : 2.0f / amplitude;
+			for(size_t index = 0; index < quarters; ++index) {
+				const int phase = (first_quarter + int(index)) & 3;
+				const float chrominance = is_svideo ? band.samples[quarters + index] : band.samples[index] - band.luminance[index];
+				const float modulated = chrominance * chroma_scale;
+
+				band.samples[index] = (phase == 0) ? modulated : ((phase == 2) ? -modulated : 0.0f);
+				band.samples[quarters + index] =
+					((phase == 1) ? modulated : ((phase == 3) ? -modulated : 0.0f)) * (is_alternate_line ? -1.0f : 1.0f);
+			}
+			filter_colour_cycle(&band.samples[0], band.chroma_u.data(), quarters);
+			filter_colour_cycle(&band.samples[quarters], band.chroma_v.data(), quarters);
+		}
+
+		// Resample to output pixels.
+		const float luminance_scale = (!is_svideo && is_colour) ? 1.0f / std::max(1.0f - amplitude, 0.01f) : 1.0f;
+		const float angles_per_pixel = (end_angle - start_angle) / (end_x - start_x);
+		for(size_t column = 0; column < columns; ++column) {
+			const float quarter = (start_angle + (float(first_column + int(column)) + 0.5f - start_x) * angles_per_pixel) / 16.0f - float(first_quarter);
+			const size_t index = std::min(size_t(std::max(quarter, 0.0f)), quarters - 2);
+			const float fraction = std::clamp(quarter - float(index), 0.0f, 1.0f);
+			const auto sample = [index, fraction] (const std::vector<float> &source) {
+				return source[index] + (source[index + 1] - source[index]) * fraction;
+			};
+
+			band.red[column] = sample(band.luminance) * luminance_scale;
+			band.green[column] = is_colour ? sample(band.chroma_u) : 0.0f;
+			band.blue[column] = is_colour ? sample(band.chroma_v) : 0.0f;
+		}
+
+		if(is_colour) {
+			transform_planes(conversion_.luma_chroma_to_rgb, band.red.data(), band.green.data(), band.blue.data(), columns);
+		} else {
+			std::copy(band.red.begin(), band.red.end(), band.green.begin());
+			std::copy(band.red.begin(), band.red.end(), band.blue.begin());
+		}
+	}
+
+	// Pack, adjust gamma if required, and write to every row covered.
+	uint8_t *const row = band.row.data();
+	pack_rgba(band.red.data(), band.green.data(), band.blue.data(), conversion_.brightness, row, columns);
+	if(conversion_.apply_gamma) {
+		for(size_t index = 0; index < columns * 4; ++index) {
+			row[index] = conversion_.gamma[row[index]];
+		}
+	}
+
+	for(int target_row = first_row; target_row < end_row; ++target_row) {
+		memcpy(&pixels_[size_t((target_row * width_ + first_column) * 4)], row, columns * 4);
+		row_frames_[size_t(target_row)] = metadata.frame;
+	}
+}
@@ -0,0 +1,217 @@
+//
+//  ScanTarget.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Software_ScanTarget_hpp
+#define Software_ScanTarget_hpp
+
+#include "../DisplayMetrics.hpp"
+#include "../ScanTarget.hpp"
+
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+namespace Software {
+
+/*!
+	Provides a ScanTarget that composites its output into a framebuffer in host memory,
+	without any GPU involvement.
+
+	Input is buffered exactly as by the OpenGL ScanTarget: scans and their data are accumulated
+	by the emulation thread into ring buffers and published a line at a time. A call to @c update
+	then converts all published lines into the framebuffer — composing each line's scans into a
+	per-clock buffer, decoding composite or S-Video where necessary, and writing the result to every
+	framebuffer row the line covers.
+
+	That work is divided by horizontal band of the framebuffer, with each band being processed
+	on a separate thread.
+
+	The framebuffer holds 8-bit RGBA pixels, in that byte order and with opaque alpha, rows
+	being contiguous and top to bottom; that's directly suitable for PNG encoding or for
+	piping to a video encoder as raw RGBA.
+*/
+class ScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		/*!
+			Constructs a scan target with a framebuffer of @c width by @c height pixels.
+
+			@param output_gamma The gamma of the display that the framebuffer will be shown on.
+			@param bands The number of bands, and therefore threads, to divide work between; 0 selects
+				one per available core.
+		*/
+		ScanTarget(int width, int height, float output_gamma = 2.2f, size_t bands = 0);
+		~ScanTarget();
+
+		/*! Changes the size of the framebuffer, discarding its current contents. */
+		void set_output_size(int width, int height);
+
+		/*! Converts all input received since the last update into the framebuffer. */
+		void update();
+
+		/*! @returns The framebuffer, as @c get_width() * @c get_height() RGBA pixels. */
+		const uint8_t *get_pixels() const;
+		int get_width() const;
+		int get_height() const;
+
+		/*! @returns The DisplayMetrics object that this ScanTarget has been providing with announcements and draw overages. */
+		Metrics &display_metrics();
+
+	private:
+		static constexpr size_t WriteAreaSize = 2048*2048;
+		static constexpr size_t LineBufferHeight = 2048;
+
+		const float output_gamma_;
+
+		// Outputs::Display::ScanTarget finals.
+		void set_modals(Modals) final;
+		Scan *begin_scan() final;
+		void end_scan() final;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
+		void end_data(size_t actual_length) final;
+		void announce(Event event, bool is_visible, const Outputs::Display::ScanTarget::Scan::EndPoint &location, uint8_t colour_burst_amplitude) final;
+		void will_change_owner() final;
+
+		bool output_is_visible_ = false;
+
+		Metrics display_metrics_;
+
+		// Extends the definition of a Scan to include two extra fields,
+		// relevant to the way that this scan target processes video.
+		struct Scan {
+			Outputs::Display::ScanTarget::Scan scan;
+
+			/// Stores the offset of this scan's data within the write area; the data offsets within
+			/// @c scan are relative to this.
+			uint32_t data_base;
+			/// Stores the index of this scan's line within the line buffer.
+			uint16_t line;
+		};
+
+		struct PointerSet {
+			// This constructor is here to appease GCC's interpretation of
+			// an ambiguity in the C++ standard; cf. https://stackoverflow.com/questions/17430377
+			PointerSet() noexcept {}
+
+			// As per the OpenGL scan target, this is squeezed into 64 bits so that the
+			// std::atomics are likely to be lock free.
+			uint32_t write_area = 0;
+			uint16_t scan_buffer = 0;
+			uint16_t line = 0;
+		};
+
+		/// A pointer to the next thing that should be provided to the caller for data.
+		/// As per the OpenGL scan target, this is owned by the producer and published
+		/// only via submit_pointers_.
+		PointerSet write_pointers_;
+
+		/// A pointer to the final thing currently cleared for submission.
+		std::atomic<PointerSet> submit_pointers_;
+
+		/// A pointer to the first thing not yet submitted for display.
+		std::atomic<PointerSet> read_pointers_;
+
+		/// Maintains a buffer of the most recent scans.
+		std::array<Scan, 16384> scan_buffer_;
+
+		// Maintains a buffer of completed lines, with their metadata.
+		struct Line {
+			struct EndPoint {
+				uint16_t x, y;
+				uint16_t cycles_since_end_of_horizontal_retrace;
+				int16_t composite_angle;
+			} end_points[2];
+			uint8_t composite_amplitude;
+		};
+		struct LineMetadata {
+			bool is_first_in_frame;
+			bool previous_frame_was_complete;
+
+			// These are populated by update(), prior to conversion.
+			uint32_t first_scan, end_scan;
+			uint32_t frame;
+		};
+		std::array<Line, LineBufferHeight> line_buffer_;
+		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
+
+		// Ephemeral state that helps in line composition.
+		Line *active_line_ = nullptr;
+		int provided_scans_ = 0;
+		bool is_first_in_frame_ = true;
+		bool frame_is_complete_ = true;
+		bool previous_frame_was_complete_ = true;
+
+		// Storage for the data that scans refer to.
+		std::vector<uint8_t> write_area_;
+		size_t data_type_size_ = 0;
+
+		// Ephemeral information for the begin/end functions.
+		Scan *vended_scan_ = nullptr;
+		uint32_t vended_write_area_pointer_ = 0;
+
+		// Track allocation failures.
+		bool data_is_allocated_ = false;
+		bool allocation_has_failed_ = false;
+
+		// Receives scan target modals.
+		Modals modals_;
+		bool modals_are_dirty_ = false;
+		std::atomic_flag is_updating_;
+		void setup_pipeline();
+
+		// The framebuffer, and a record of the frame in which each row was most recently painted.
+		int width_ = 0, height_ = 0;
+		std::vector<uint8_t> pixels_;
+		std::vector<uint32_t> row_frames_;
+		uint32_t frame_ = 0;
+
+		// Derived from the modals by setup_pipeline.
+		struct Conversion {
+			float luma_chroma_to_rgb[9];
+			float rgb_to_luma_chroma[9];
+			float brightness = 1.0f;
+			std::array<uint8_t, 256> gamma;
+			bool apply_gamma = false;
+		} conversion_;
+
+		/// Per-band scratch space and processing.
+		struct Band {
+			int first_row, end_row;
+			uint32_t frame = 0;
+
+			// The line currently being converted, composed to one sample of four channels per clock;
+			// prefixes holds the running totals of those channels.
+			std::vector<float> composition, prefixes;
+
+			// Per quarter-colour-cycle luminance and chrominance, for composite and S-Video decoding.
+			std::vector<float> samples, luminance, chroma_u, chroma_v;
+
+			// A line of output, as planar RGB.
+			std::vector<float> red, green, blue;
+			std::vector<uint8_t> row;
+
+			std::unique_ptr<Concurrency::AsyncTaskQueue> queue;
+		};
+		std::vector<Band> bands_;
+
+		void convert(Band &band, uint16_t start_line, uint16_t end_line);
+		uint16_t first_update_scan_ = 0;	// The first scan considered by the current update.
+		void convert_line(Band &band, size_t line);
+		void compose_line(Band &band, size_t line, int start_clock, int end_clock);
+};
+
+}
+}
+}
+
+#endif /* Software_ScanTarget_hpp */
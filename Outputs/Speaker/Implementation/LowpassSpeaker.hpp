@@ -139,6 +139,14 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 			std::size_t cycles_remaining = size_t(cycles.as_integral());
 			if(!cycles_remaining) return;
 
+			// If output is disabled, just advance the source, abandoning any input that
+			// had been collected towards the next output sample.
+			if(!output_enabled_) {
+				sample_source_.skip_samples(cycles_remaining);
+				input_buffer_start_ = input_buffer_depth_ = 0;
+				return;
+			}
+
 			FilterParameters filter_parameters;
 			{
 				std::lock_guard<std::mutex> lock_guard(filter_parameters_mutex_);
@@ -172,12 +180,15 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 
 				case Conversion::ResampleSmaller:
 					while(cycles_remaining) {
-						const auto cycles_to_read = std::min((input_buffer_.size() - input_buffer_depth_) / (SampleSource::get_is_stereo() ? 2 : 1), cycles_remaining);
+						// Read only as far as the end of the current window, so that the filter is
+						// applied exactly when an output sample is due.
+						const auto window_end = input_buffer_start_ + input_window_size_;
+						const auto cycles_to_read = std::min((window_end - input_buffer_depth_) / (SampleSource::get_is_stereo() ? 2 : 1), cycles_remaining);
 
 						sample_source_.get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
 						input_buffer_depth_ += cycles_to_read * (SampleSource::get_is_stereo() ? 2 : 1);
 
-						if(input_buffer_depth_ == input_buffer_.size()) {
+						if(input_buffer_depth_ == window_end) {
 							resample_input_buffer(scale);
 						}
 
@@ -194,7 +205,13 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 		SampleSource &sample_source_;
 
 		std::size_t output_buffer_pointer_ = 0;
+
+		// The filter is applied to a window of input_window_size_ samples that begins at input_buffer_start_
+		// and slides along input_buffer_ as output is generated. input_buffer_ has space for several windows
+		// so that its contents need be moved back to the start only occasionally.
+		std::size_t input_buffer_start_ = 0;
 		std::size_t input_buffer_depth_ = 0;
+		std::size_t input_window_size_ = 0;
 		std::vector<int16_t> input_buffer_;
 		std::vector<int16_t> output_buffer_;
 
@@ -258,28 +275,40 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 				default: break;
 
 				case Conversion::ResampleSmaller: {
-					// Reize the input buffer only if absolutely necessary; if sizing downward
-					// such that a sample would otherwise be lost then output it now. Keep anything
-					// currently in the input buffer that hasn't yet been processed.
-					const size_t required_buffer_size = size_t(number_of_taps) * (SampleSource::get_is_stereo() ? 2 : 1);
-					if(input_buffer_.size() != required_buffer_size) {
-						if(input_buffer_depth_ >= required_buffer_size) {
+					// Resize the window only if absolutely necessary, keeping anything currently in the
+					// input buffer that hasn't yet been processed. That is first moved to the start of
+					// the buffer so that the new window is guaranteed to fit. If sizing downward such
+					// that a sample would otherwise be lost then output it now.
+					const size_t window_size = size_t(number_of_taps) * (SampleSource::get_is_stereo() ? 2 : 1);
+					if(input_window_size_ != window_size) {
+						if(input_buffer_start_) {
+							auto *const input_buffer = input_buffer_.data();
+							std::memmove(	input_buffer,
+											&input_buffer[input_buffer_start_],
+											sizeof(int16_t) * (input_buffer_depth_ - input_buffer_start_));
+							input_buffer_depth_ -= input_buffer_start_;
+							input_buffer_start_ = 0;
+						}
+
+						input_window_size_ = window_size;
+						input_buffer_.resize(std::max(window_size * 4, input_buffer_depth_));
+
+						while(input_buffer_depth_ - input_buffer_start_ >= input_window_size_) {
 							resample_input_buffer(scale);
-							input_buffer_depth_ %= required_buffer_size;
 						}
-						input_buffer_.resize(required_buffer_size);
 					}
 				} break;
 			}
 		}
 
 		inline void resample_input_buffer(int scale) {
+			const int16_t *const window = &input_buffer_[input_buffer_start_];
 			if constexpr (SampleSource::get_is_stereo()) {
-				output_buffer_[output_buffer_pointer_ + 0] = filter_->apply(input_buffer_.data(), 2);
-				output_buffer_[output_buffer_pointer_ + 1] = filter_->apply(input_buffer_.data() + 1, 2);
+				output_buffer_[output_buffer_pointer_ + 0] = filter_->apply(window, 2);
+				output_buffer_[output_buffer_pointer_ + 1] = filter_->apply(window + 1, 2);
 				output_buffer_pointer_+= 2;
 			} else {
-				output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
+				output_buffer_[output_buffer_pointer_] = filter_->apply(window);
 				output_buffer_pointer_++;
 			}
 
@@ -301,21 +330,22 @@ template <typename SampleSource> class LowpassSpeaker: public Speaker {
 				did_complete_samples(this, output_buffer_, SampleSource::get_is_stereo());
 			}
 
-			// If the next loop around is going to reuse some of the samples just collected, use a memmove to
-			// preserve them in the correct locations (TODO: use a longer buffer to fix that?) and don't skip
-			// anything. Otherwise skip as required to get to the next sample batch and don't expect to reuse.
-			const auto steps = stepper_->step() * (SampleSource::get_is_stereo() ? 2 : 1);
-			if(steps < input_buffer_.size()) {
+			// Advance the window. If that moves it beyond everything collected so far then skip as required
+			// to get to the next sample batch. Otherwise, if there isn't space for the whole of the next
+			// window, use a memmove to bring the part of it already collected back to the start of the buffer.
+			input_buffer_start_ += stepper_->step() * (SampleSource::get_is_stereo() ? 2 : 1);
+			if(input_buffer_start_ >= input_buffer_depth_) {
+				if(input_buffer_start_ > input_buffer_depth_) {
+					sample_source_.skip_samples((input_buffer_start_ - input_buffer_depth_) / (SampleSource::get_is_stereo() ? 2 : 1));
+				}
+				input_buffer_start_ = input_buffer_depth_ = 0;
+			} else if(input_buffer_start_ + input_window_size_ > input_buffer_.size()) {
 				auto *const input_buffer = input_buffer_.data();
 				std::memmove(	input_buffer,
-								&input_buffer[steps],
-								sizeof(int16_t) * (input_buffer_.size() - steps));
-				input_buffer_depth_ -= steps;
-			} else {
-				if(steps > input_buffer_.size()) {
-					sample_source_.skip_samples((steps - input_buffer_.size()) / (SampleSource::get_is_stereo() ? 2 : 1));
-				}
-				input_buffer_depth_ = 0;
+								&input_buffer[input_buffer_start_],
+								sizeof(int16_t) * (input_buffer_depth_ - input_buffer_start_));
+				input_buffer_depth_ -= input_buffer_start_;
+				input_buffer_start_ = 0;
 			}
 		}
 
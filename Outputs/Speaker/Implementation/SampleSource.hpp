@@ -28,15 +28,15 @@ class SampleSource {
 		void get_samples(std::size_t number_of_samples, std::int16_t *target) {}
 
 		/*!
-			Should skip the next @c number_of_samples. Subclasses of this SampleSource
-			need not implement this if it would no more efficient to do so than it is
-			merely to call get_samples and throw the result away, as per the default
-			implementation below.
+			Should skip the next @c number_of_samples, advancing internal state exactly as
+			get_samples would but without producing any output.
+
+			This is used both to bridge gaps between output samples when resampling and to
+			consume time when output is disabled, so @c number_of_samples may be very large.
+			Subclasses with self-evolving state should implement it as something much cheaper
+			than generating and discarding output. The default implementation does nothing.
 		*/
-		void skip_samples(const std::size_t number_of_samples) {
-			std::int16_t scratch_pad[number_of_samples];
-			get_samples(number_of_samples, scratch_pad);
-		}
+		void skip_samples(const std::size_t number_of_samples) {}
 
 		/*!
 			@returns @c true if it is trivially true that a call to get_samples would just
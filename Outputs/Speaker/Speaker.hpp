@@ -57,6 +57,22 @@ class Speaker {
 			compute_output_rate();
 		}
 
+		/*!
+			Enables or disables output. While output is disabled the speaker continues to accept time,
+			advancing its source, but neither generates nor filters samples and so makes no calls to
+			its delegate.
+		*/
+		void set_output_enabled(bool enabled) {
+			output_enabled_ = enabled;
+		}
+
+		/*!
+			@returns @c true if output is enabled; @c false otherwise.
+		*/
+		bool get_output_enabled() const {
+			return output_enabled_;
+		}
+
 		/*!
 			@returns The number of sample sets so far delivered to the delegate.
 		*/
@@ -119,6 +135,7 @@ class Speaker {
 			delegate->speaker_did_complete_samples(this, mix_buffer_);
 		}
 		std::atomic<Delegate *> delegate_{nullptr};
+		std::atomic<bool> output_enabled_{true};
 
 	private:
 		void compute_output_rate() {
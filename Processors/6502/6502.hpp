@@ -111,6 +111,31 @@ class BusHandler {
 			return Cycles(1);
 		}
 
+		/*!
+			Offered while the 6502 is idle — because RDY is active or, on those processors that implement them,
+			because of a WAI or STP — before each BusOperation::Ready cycle that it would otherwise perform. The bus
+			handler may elect to perform some number of consecutive Ready cycles in a single step, e.g. by advancing the
+			rest of the machine directly to the next point at which the processor might resume, which is likely to be
+			much cheaper than the equivalent sequence of individual calls to @c perform_bus_operation.
+
+			Repetitions should stop short of any change to RDY, the interrupt inputs or reset; that'll be observed only
+			once the final repetition is complete.
+
+			@param address The value of the address bus during each Ready cycle.
+			@param limit The maximum number of cycles that may be performed.
+			@returns The number of cycles that passed in objective time, or 0 to decline.
+		*/
+		Cycles perform_idle_cycles(uint16_t address, Cycles limit) {
+			return Cycles(0);
+		}
+
+		/*!
+			Used only once plain memory has been nominated via @c Processor::set_plain_memory. Announces that @c cycles
+			have passed during which the 6502 accessed only plain memory, without any of those accesses having been
+			announced via @c perform_bus_operation; the bus handler should advance the rest of the machine accordingly.
+		*/
+		void advance_plain_cycles(Cycles cycles) {}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the 6502. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -202,10 +227,10 @@ class ProcessorBase: public ProcessorStorage {
 
 	@discussion Users should provide as the first template parameter a subclass of CPU::MOS6502::BusHandler; the 6502
 	will announce its cycle-by-cycle activity via the bus handler, which is responsible for marrying it to a bus. They
-	can also nominate whether the processor includes support for the ready line. Declining to support the ready line
-	can produce a minor runtime performance improvement.
+	can also nominate whether the processor includes support for the ready line and for plain memory. Declining to
+	support either can produce a minor runtime performance improvement.
 */
-template <Personality personality, typename T, bool uses_ready_line> class Processor: public ProcessorBase {
+template <Personality personality, typename T, bool uses_ready_line, bool uses_plain_memory = false> class Processor: public ProcessorBase {
 	public:
 		/*!
 			Constructs an instance of the 6502 that will use @c bus_handler for all bus communications.
@@ -226,6 +251,25 @@ template <Personality personality, typename T, bool uses_ready_line> class Proce
 		*/
 		void set_ready_line(bool active);
 
+		/*!
+			Nominates plain memory, i.e. memory that has no side effects and to which the exact timing of accesses is
+			unimportant, in exchange for which the processor's timing becomes instruction-granular. Reads from and
+			writes to plain memory are performed directly, without calling @c perform_bus_operation, and each takes exactly
+			one cycle. The time spent upon them is announced to the bus handler in aggregate via @c advance_plain_cycles,
+			before any other bus activity, at the end of each instruction and at the end of each @c run_for.
+
+			Both tables are retained and consulted upon every access, so may be updated in place.
+
+			@param read_pages A table of 256 pointers, one for each 256-byte page of the address space. Reads from any
+				page with a non-null entry are fulfilled from the 256 bytes to which that entry points.
+			@param write_pages As per @c read_pages, for writes.
+
+			Supply @c nullptr for both to return to cycle-exact timing.
+
+			Available only if this processor was declared to use plain memory.
+		*/
+		void set_plain_memory(const uint8_t *const *read_pages, uint8_t *const *write_pages);
+
 	private:
 		T &bus_handler_;
 };
@@ -12,7 +12,7 @@
 	6502.hpp, but it's implementation stuff.
 */
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::run_for(const Cycles cycles) {
+template <Personality personality, typename T, bool uses_ready_line, bool uses_plain_memory> void Processor<personality, T, uses_ready_line, uses_plain_memory>::run_for(const Cycles cycles) {
 	static uint8_t throwaway_target;
 
 	// These plus program below act to give the compiler permission to update these values
@@ -40,26 +40,50 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 		}\
 	}
 
+// Time spent accessing plain memory is accumulated in plain_cycles, and reported to the bus handler
+// before anything else happens on the bus, at the end of each instruction and upon exit.
+#define report_plain_cycles()	\
+	if(uses_plain_memory && plain_cycles > Cycles(0)) {	\
+		bus_handler_.advance_plain_cycles(plain_cycles);	\
+		plain_cycles = Cycles(0);	\
+	}
+
 #define bus_access() \
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | irq_request_history_;	\
 	irq_request_history_ = irq_line_ & inverse_interrupt_flag_;	\
-	number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
+	if(uses_plain_memory && plain_read_pages_ && perform_plain_access(nextBusOperation, busAddress, busValue)) {	\
+		plain_cycles += Cycles(1);	\
+		number_of_cycles -= Cycles(1);	\
+	} else {	\
+		report_plain_cycles();	\
+		number_of_cycles -= bus_handler_.perform_bus_operation(nextBusOperation, busAddress, busValue);	\
+	}	\
 	nextBusOperation = BusOperation::None;	\
 	if(number_of_cycles <= Cycles(0)) break;
 
+#define ready_cycle() {	\
+		report_plain_cycles();	\
+		const Cycles idle_time = bus_handler_.perform_idle_cycles(busAddress, number_of_cycles);	\
+		number_of_cycles -=	\
+			(idle_time > Cycles(0)) ?	\
+				idle_time :	\
+				bus_handler_.perform_bus_operation(BusOperation::Ready, busAddress, busValue);	\
+	}
+
 	checkSchedule();
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
+	Cycles plain_cycles;
 
 	while(number_of_cycles > Cycles(0)) {
 
 		// Deal with a potential RDY state, if this 6502 has anything connected to ready.
 		while(uses_ready_line && ready_is_active_ && number_of_cycles > Cycles(0)) {
-			number_of_cycles -= bus_handler_.perform_bus_operation(BusOperation::Ready, busAddress, busValue);
+			ready_cycle();
 		}
 
 		// Deal with a potential STP state, if this 6502 implements STP.
 		while(has_stpwai(personality) && stop_is_active_ && number_of_cycles > Cycles(0)) {
-			number_of_cycles -= bus_handler_.perform_bus_operation(BusOperation::Ready, busAddress, busValue);
+			ready_cycle();
 			if(interrupt_requests_ & InterruptRequestFlags::Reset) {
 				stop_is_active_ = false;
 				checkSchedule();
@@ -69,7 +93,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 
 		// Deal with a potential WAI state, if this 6502 implements WAI.
 		while(has_stpwai(personality) && wait_is_active_ && number_of_cycles > Cycles(0)) {
-			number_of_cycles -= bus_handler_.perform_bus_operation(BusOperation::Ready, busAddress, busValue);
+			ready_cycle();
 			interrupt_requests_ |= (irq_line_ & inverse_interrupt_flag_);
 			if(interrupt_requests_ & InterruptRequestFlags::NMI || irq_line_) {
 				wait_is_active_ = false;
@@ -126,6 +150,7 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 					continue;
 
 					case OperationMoveToNextProgram:
+						report_plain_cycles();
 						scheduled_program_counter_ = nullptr;
 						checkSchedule();
 					continue;
@@ -663,10 +688,15 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	bus_address_ = busAddress;
 	bus_value_ = busValue;
 
+	report_plain_cycles();
 	bus_handler_.flush();
 }
 
-template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::set_ready_line(bool active) {
+#undef ready_cycle
+#undef bus_access
+#undef report_plain_cycles
+
+template <Personality personality, typename T, bool uses_ready_line, bool uses_plain_memory> void Processor<personality, T, uses_ready_line, uses_plain_memory>::set_ready_line(bool active) {
 	assert(uses_ready_line);
 	if(active) {
 		ready_line_is_enabled_ = true;
@@ -676,6 +706,12 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	}
 }
 
+template <Personality personality, typename T, bool uses_ready_line, bool uses_plain_memory> void Processor<personality, T, uses_ready_line, uses_plain_memory>::set_plain_memory(const uint8_t *const *read_pages, uint8_t *const *write_pages) {
+	assert(uses_plain_memory);
+	plain_read_pages_ = read_pages;
+	plain_write_pages_ = write_pages;
+}
+
 void ProcessorBase::set_reset_line(bool active) {
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::Reset) | (active ? InterruptRequestFlags::Reset : 0);
 }
@@ -247,6 +247,33 @@ class ProcessorStorage {
 		uint16_t bus_address_;
 		uint8_t *bus_value_;
 
+		/*
+			Plain memory, if any; see set_plain_memory.
+		*/
+		const uint8_t *const *plain_read_pages_ = nullptr;
+		uint8_t *const *plain_write_pages_ = nullptr;
+
+		/*!
+			Performs @c operation directly if it is a read from or write to plain memory.
+
+			@returns @c true if the operation was performed; @c false otherwise.
+		*/
+		forceinline bool perform_plain_access(BusOperation operation, uint16_t address, uint8_t *value) {
+			if(isReadOperation(operation)) {
+				const uint8_t *const page = plain_read_pages_[address >> 8];
+				if(!page) return false;
+				*value = page[address & 0xff];
+				return true;
+			}
+			if(operation == BusOperation::Write) {
+				uint8_t *const page = plain_write_pages_[address >> 8];
+				if(!page) return false;
+				page[address & 0xff] = *value;
+				return true;
+			}
+			return false;
+		}
+
 		/*!
 			Gets the flags register.
 
@@ -50,7 +50,7 @@ State::State(const ProcessorBase &src): State() {
 	assert(&src.operations_[execution_state.micro_program][execution_state.micro_program_offset] == src.scheduled_program_counter_);
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	target.pc_.full = registers.program_counter;
 	target.s_ = registers.stack_pointer;
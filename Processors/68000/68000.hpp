@@ -338,6 +338,32 @@ class BusHandler {
 			return HalfCycles(0);
 		}
 
+		/*!
+			Offered while the processor is stopped or halted, before each idle @c cycle that it would otherwise
+			perform while awaiting an interrupt or the end of the halt. The bus handler may elect to perform some
+			number of consecutive repetitions of @c cycle in a single step, e.g. by advancing the rest of the
+			machine directly to the next point at which an interrupt might occur, which is likely to be much
+			cheaper than the equivalent sequence of individual calls to @c perform_bus_operation.
+
+			Repetitions should stop short of any change to the interrupt inputs or to the halt line; that'll be
+			observed only once the final repetition is complete.
+
+			@param limit The maximum amount of time that may be performed.
+			@returns The amount of time performed, which should be a multiple of the length of @c cycle,
+				or 0 to decline.
+		*/
+		HalfCycles perform_idle_cycles(const Microcycle &cycle, HalfCycles limit, int is_supervisor) {
+			return HalfCycles(0);
+		}
+
+		/*!
+			Used only once plain memory has been nominated via @c Processor::set_plain_memory. Announces that @c duration
+			has passed during which the processor performed only internal cycles and accesses to plain memory, none of
+			which were announced via @c perform_bus_operation; the bus handler should advance the rest of the machine
+			accordingly.
+		*/
+		void advance_plain_time(HalfCycles duration) {}
+
 		void flush() {}
 
 		/*!
@@ -346,6 +372,17 @@ class BusHandler {
 		void will_perform(uint32_t address, uint16_t opcode) {}
 };
 
+/*!
+	Nominates the microcycle of each access to contended plain memory that is extended; see
+	@c Processor::set_plain_memory.
+*/
+enum class ContentionPoint {
+	/// The microcycle in which a new address is strobed.
+	AddressStrobe,
+	/// Any microcycle in which data is selected.
+	DataStrobe,
+};
+
 #include "Implementation/68000Storage.hpp"
 
 class ProcessorBase: public ProcessorStorage {
@@ -384,7 +421,7 @@ struct ProcessorState {
 //			uint16_t current_instruction;
 };
 
-template <class T, bool dtack_is_implicit, bool signal_will_perform = false> class Processor: public ProcessorBase {
+template <class T, bool dtack_is_implicit, bool signal_will_perform = false, bool uses_plain_memory = false> class Processor: public ProcessorBase {
 	public:
 		Processor(T &bus_handler) : ProcessorBase(), bus_handler_(bus_handler) {}
 
@@ -434,6 +471,32 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform = false> cla
 			halt_ = halt;
 		}
 
+		/*!
+			Nominates plain memory, i.e. memory that has no side effects and to which the exact timing of accesses is
+			unimportant, in exchange for which the processor's timing becomes instruction-granular. Internal cycles and
+			accesses to plain memory are performed without calling @c perform_bus_operation; plain accesses never signal
+			VPA or a bus error. The time spent upon them is announced to the bus handler in aggregate via
+			@c advance_plain_time, before any other bus activity, before the interrupt inputs are sampled and at the
+			end of each @c run_for.
+
+			All tables are retained and consulted upon every access, so may be updated in place.
+
+			@param read_pages A table of 256 pointers, one for each 64kb page of the 24-bit address space. Reads from
+				any page with a non-null entry are fulfilled from the 64kb to which that entry points, which should be
+				arranged as host-endian 16-bit words, as per @c Microcycle::apply.
+			@param write_pages As per @c read_pages, for writes.
+			@param contention Either @c nullptr or a table of 256 masks, one for each page. A page with a nonzero mask is
+				contended: the microcycle nominated by @c contention_point of each access upon it will be extended until
+				it ends at a time when bit n of the mask is set, where n is the time since this processor was constructed,
+				in half cycles and modulo 16.
+			@param contention_point The microcycle of each access to which @c contention applies.
+
+			Supply @c nullptr for all to return to cycle-exact timing.
+
+			Available only if this processor was declared to use plain memory.
+		*/
+		void set_plain_memory(const uint8_t *const *read_pages, uint8_t *const *write_pages, const uint16_t *contention, ContentionPoint contention_point = ContentionPoint::DataStrobe);
+
 	private:
 		T &bus_handler_;
 };
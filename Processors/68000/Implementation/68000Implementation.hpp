@@ -67,12 +67,31 @@
 	bus_program->microcycle.length = x
 #endif
 
-template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::run_for(HalfCycles duration) {
+template <class T, bool dtack_is_implicit, bool signal_will_perform, bool uses_plain_memory> void Processor<T, dtack_is_implicit, signal_will_perform, uses_plain_memory>::run_for(HalfCycles duration) {
 	const HalfCycles remaining_duration = duration + half_cycles_left_to_run_;
 
 	// This loop counts upwards rather than downwards because it simplifies calculation of
 	// E as and when required.
 	HalfCycles cycles_run_for;
+
+	// Time spent on plain memory and internal cycles is accumulated in plain_time, and reported to the
+	// bus handler before anything else happens on the bus, before interrupts are sampled and upon exit.
+	HalfCycles plain_time;
+#define report_plain_time()	\
+	if(uses_plain_memory && plain_time > HalfCycles(0)) {	\
+		bus_handler_.advance_plain_time(plain_time);	\
+		plain_time = HalfCycles(0);	\
+	}
+
+	// Performs a stop cycle, or as many as the bus handler would prefer to perform at once.
+#define perform_idle_cycle()	{	\
+		report_plain_time();	\
+		const HalfCycles idle_time = bus_handler_.perform_idle_cycles(stop_cycle_, remaining_duration - cycles_run_for, is_supervisor_);	\
+		cycles_run_for +=	\
+			(idle_time > HalfCycles(0)) ?	\
+				idle_time :	\
+				stop_cycle_.length + bus_handler_.perform_bus_operation(stop_cycle_, is_supervisor_);	\
+	}
 	while(cycles_run_for < remaining_duration) {
 		/*
 			PERFORM THE CURRENT BUS STEP'S MICROCYCLE.
@@ -128,11 +147,22 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 						// TODO: it's also not correct for a bus error that occurs during another exception.
 					}
 
-					// Perform the microcycle if it is of non-zero length. If this is an operation that
+					// Perform the microcycle if it is of non-zero length. Internal cycles and accesses to plain memory
+					// are performed without involving the bus handler. Otherwise, if this is an operation that
 					// would normally strobe one of the data selects and VPA is active, it will also need
 					// stretching.
 					if(active_step_->microcycle.length != HalfCycles(0)) {
-						if(is_peripheral_address_ && active_step_->microcycle.data_select_active()) {
+						HalfCycles plain_length;
+						if(uses_plain_memory && plain_read_pages_) {
+							plain_length = perform_plain_cycle(active_step_->microcycle, int((contention_phase_ + cycles_run_for).as_integral() & 15));
+						}
+
+						if(plain_length != HalfCycles(0)) {
+							cycles_run_for += plain_length;
+							plain_time += plain_length;
+						} else if(is_peripheral_address_ && active_step_->microcycle.data_select_active()) {
+							report_plain_time();
+
 							auto cycle_copy = active_step_->microcycle;
 							cycle_copy.operation |= Microcycle::IsPeripheral;
 
@@ -145,6 +175,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 								cycle_copy.length +
 								bus_handler_.perform_bus_operation(cycle_copy, is_supervisor_);
 						} else {
+							report_plain_time();
 							cycles_run_for +=
 								active_step_->microcycle.length +
 								bus_handler_.perform_bus_operation(active_step_->microcycle, is_supervisor_);
@@ -191,6 +222,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 
 							case BusStep::Action::AdvancePrefetch:
 								prefetch_queue_.halves.high = prefetch_queue_.halves.low;
+								report_plain_time();
 
 								// During prefetch advance seems to be the only time the interrupt inputs are sampled;
 								// TODO: determine whether this really happens on *every* advance.
@@ -215,9 +247,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 					}
 
 					// Otherwise continue being stopped.
-					cycles_run_for +=
-						stop_cycle_.length +
-						bus_handler_.perform_bus_operation(stop_cycle_, is_supervisor_);
+					perform_idle_cycle();
 				continue;
 
 				case ExecutionState::WaitingForDTack:
@@ -228,6 +258,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 					}
 
 					// Otherwise, signal another cycle of wait.
+					report_plain_time();
 					cycles_run_for +=
 						dtack_cycle_.length +
 						bus_handler_.perform_bus_operation(dtack_cycle_, is_supervisor_);
@@ -239,9 +270,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 						continue;
 					}
 
-					cycles_run_for +=
-						stop_cycle_.length +
-						bus_handler_.perform_bus_operation(stop_cycle_, is_supervisor_);
+					perform_idle_cycle();
 				continue;
 
 				case ExecutionState::WillBeginInterrupt:
@@ -2186,13 +2215,16 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 #undef source_address
 #undef destination
 #undef destination_address
+#undef perform_idle_cycle
 
+	report_plain_time();
 	bus_handler_.flush();
 	e_clock_phase_ = (e_clock_phase_ + cycles_run_for) % 10;
+	contention_phase_ = (contention_phase_ + cycles_run_for) % 16;
 	half_cycles_left_to_run_ = remaining_duration - cycles_run_for;
 }
 
-template <class T, bool dtack_is_implicit, bool signal_will_perform> ProcessorState Processor<T, dtack_is_implicit, signal_will_perform>::get_state() {
+template <class T, bool dtack_is_implicit, bool signal_will_perform, bool uses_plain_memory> ProcessorState Processor<T, dtack_is_implicit, signal_will_perform, uses_plain_memory>::get_state() {
 	write_back_stack_pointer();
 
 	State state;
@@ -2207,7 +2239,7 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> ProcessorSt
 	return state;
 }
 
-template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::set_state(const ProcessorState &state) {
+template <class T, bool dtack_is_implicit, bool signal_will_perform, bool uses_plain_memory> void Processor<T, dtack_is_implicit, signal_will_perform, uses_plain_memory>::set_state(const ProcessorState &state) {
 	memcpy(data_, state.data, sizeof(state.data));
 	memcpy(address_, state.address, sizeof(state.address));
 
@@ -2218,6 +2250,14 @@ template <class T, bool dtack_is_implicit, bool signal_will_perform> void Proces
 	address_[7] = stack_pointers_[is_supervisor_];
 }
 
+template <class T, bool dtack_is_implicit, bool signal_will_perform, bool uses_plain_memory> void Processor<T, dtack_is_implicit, signal_will_perform, uses_plain_memory>::set_plain_memory(const uint8_t *const *read_pages, uint8_t *const *write_pages, const uint16_t *contention, ContentionPoint contention_point) {
+	assert(uses_plain_memory);
+	plain_read_pages_ = read_pages;
+	plain_write_pages_ = write_pages;
+	plain_contention_ = contention;
+	plain_contention_operation_ = (contention_point == ContentionPoint::AddressStrobe) ? Microcycle::NewAddress : Microcycle::SelectWord | Microcycle::SelectByte;
+}
+
 uint16_t ProcessorStorage::get_status() const {
 	return status();
 }
@@ -2236,4 +2276,5 @@ void ProcessorStorage::set_status(uint16_t status) {
 #undef s_extend8
 #undef set_next_microcycle_length
 #undef convert_to_bit_count_16
+#undef report_plain_time
 
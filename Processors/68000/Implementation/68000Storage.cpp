@@ -10,7 +10,6 @@
 
 #include <algorithm>
 #include <cassert>
-#include <ctime>
 #include <map>
 #include <vector>
 #include <sstream>
@@ -32,7 +31,7 @@ namespace MC68000 {
 #define Imm		0x14
 
 struct ProcessorStorageConstructor {
-	ProcessorStorageConstructor(ProcessorStorage &storage) : storage_(storage) {}
+	ProcessorStorageConstructor(ProcessorStorage &storage, ProcessorStorage::Tables &tables) : storage_(storage), tables_(tables) {}
 
 	using BusStep = ProcessorStorage::BusStep;
 
@@ -470,7 +469,7 @@ struct ProcessorStorageConstructor {
 		Walks through the sequence of micro-ops beginning at @c start, replacing the value supplied for each write
 		encountered in each micro-op's bus steps with the respective value from @c values.
 	*/
-	void replace_write_values(ProcessorBase::MicroOp *start, const std::initializer_list<RegisterPair16 *> &values) {
+	void replace_write_values(const ProcessorBase::MicroOp *start, const std::initializer_list<RegisterPair16 *> &values) {
 		auto value = values.begin();
 		while(!start->is_terminal()) {
 			value = replace_write_values(&storage_.all_bus_steps_[start->bus_program], value);
@@ -829,7 +828,7 @@ struct ProcessorStorageConstructor {
 		// storage_.all_bus_steps_ at the end.
 //		BusStep arbitrary_base;
 
-#define op(...) 	storage_.all_micro_ops_.emplace_back(__VA_ARGS__)
+#define op(...) 	tables_.micro_ops.emplace_back(__VA_ARGS__)
 #define seq(...)	assemble_program(__VA_ARGS__)
 #define ea(n)		&storage_.effective_address_[n].full
 #define a(n)		&storage_.address_[n].full
@@ -845,7 +844,7 @@ struct ProcessorStorageConstructor {
 			for(const auto &mapping: mappings) {
 				if((instruction & mapping.mask) == mapping.value) {
 					auto operation = mapping.operation;
-					const auto micro_op_start = storage_.all_micro_ops_.size();
+					const auto micro_op_start = tables_.micro_ops.size();
 
 					// The following fields are used commonly enough to be worth pulling out here.
 					const int ea_register = instruction & 7;
@@ -3005,17 +3004,17 @@ struct ProcessorStorageConstructor {
 					}
 
 					// Add a terminating micro operation if necessary.
-					if(!storage_.all_micro_ops_.back().is_terminal()) {
-						storage_.all_micro_ops_.emplace_back();
+					if(!tables_.micro_ops.back().is_terminal()) {
+						tables_.micro_ops.emplace_back();
 					}
 
 					// Ensure that steps that weren't meant to look terminal aren't terminal; also check
 					// for improperly encoded address calculation-type actions.
-					for(auto index = micro_op_start; index < storage_.all_micro_ops_.size() - 1; ++index) {
+					for(auto index = micro_op_start; index < tables_.micro_ops.size() - 1; ++index) {
 
 #ifdef DEBUG
 						// All of the actions below must also nominate a source and/or destination.
-						switch(storage_.all_micro_ops_[index].action) {
+						switch(tables_.micro_ops[index].action) {
 							default: break;
 							case int(Action::CalcD16PC):
 							case int(Action::CalcD8PCXn):
@@ -3034,14 +3033,14 @@ struct ProcessorStorageConstructor {
 						}
 #endif
 
-						if(storage_.all_micro_ops_[index].is_terminal()) {
-							storage_.all_micro_ops_[index].bus_program = uint16_t(seq(""));
+						if(tables_.micro_ops[index].is_terminal()) {
+							tables_.micro_ops[index].bus_program = uint16_t(seq(""));
 						}
 					}
 
 					// Install the operation and make a note of where micro-ops begin.
 					program.operation = operation;
-					storage_.instructions[instruction] = program;
+					tables_.instructions[instruction] = program;
 					micro_op_pointers[size_t(instruction)] = size_t(micro_op_start);
 
 					// Don't search further through the list of possibilities, unless this is a debugging build,
@@ -3060,7 +3059,7 @@ struct ProcessorStorageConstructor {
 		}
 
 		// Throw in the interrupt program.
-		const auto interrupt_pointer = storage_.all_micro_ops_.size();
+		const auto interrupt_pointer = tables_.micro_ops.size();
 
 		// WORKAROUND FOR THE 68000 MAIN LOOP. Hopefully temporary.
 		op(Action::None, seq(""));
@@ -3113,21 +3112,20 @@ struct ProcessorStorageConstructor {
 		// Finalise micro-op and program pointers.
 		for(size_t instruction = 0; instruction < 65536; ++instruction) {
 			if(micro_op_pointers[instruction] != std::numeric_limits<size_t>::max()) {
-				storage_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
-//				link_operations(&storage_.all_micro_ops_[micro_op_pointers[instruction]], &arbitrary_base);
+				tables_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
+//				link_operations(&tables_.micro_ops[micro_op_pointers[instruction]], &arbitrary_base);
 			}
 		}
 
 		// Link up the interrupt micro ops.
-		storage_.interrupt_micro_ops_ = &storage_.all_micro_ops_[interrupt_pointer];
+		storage_.interrupt_micro_ops_ = &tables_.micro_ops[interrupt_pointer];
 //		link_operations(storage_.interrupt_micro_ops_, &arbitrary_base);
 
-		std::cout << storage_.all_bus_steps_.size() << " total bus steps" << std::endl;
-		std::cout << storage_.all_micro_ops_.size() << " total micro ops" << std::endl;
 	}
 
 	private:
 		ProcessorStorage &storage_;
+		ProcessorStorage::Tables &tables_;
 
 		std::initializer_list<RegisterPair16 *>::const_iterator replace_write_values(BusStep *start, std::initializer_list<RegisterPair16 *>::const_iterator value) {
 			while(!start->is_terminal()) {
@@ -3165,7 +3163,54 @@ struct ProcessorStorageConstructor {
 }
 
 CPU::MC68000::ProcessorStorage::ProcessorStorage() {
-	ProcessorStorageConstructor constructor(*this);
+	// Generating the tables is relatively expensive, so do it only once, into a
+	// prototype instance; every instance then shares its micro-ops and instruction
+	// table and takes a copy of its bus steps.
+	static Tables tables;
+	static const ProcessorStorage prototype(tables);
+
+	all_micro_ops_ = prototype.all_micro_ops_;
+	instructions = prototype.instructions;
+	long_exception_micro_ops_ = prototype.long_exception_micro_ops_;
+	short_exception_micro_ops_ = prototype.short_exception_micro_ops_;
+	interrupt_micro_ops_ = prototype.interrupt_micro_ops_;
+
+	// Bus steps refer to the registers they read and write by address, so
+	// relocate any that point into the prototype.
+	all_bus_steps_ = prototype.all_bus_steps_;
+	const auto prototype_start = reinterpret_cast<const uint8_t *>(&prototype);
+	const auto prototype_end = prototype_start + sizeof(ProcessorStorage);
+	const auto relocate = [&](auto pointer) {
+		const auto byte_pointer = reinterpret_cast<const uint8_t *>(pointer);
+		if(byte_pointer < prototype_start || byte_pointer >= prototype_end) return pointer;
+		return reinterpret_cast<decltype(pointer)>(reinterpret_cast<uint8_t *>(this) + (byte_pointer - prototype_start));
+	};
+	for(auto &step: all_bus_steps_) {
+		step.microcycle.address = relocate(step.microcycle.address);
+		step.microcycle.value = relocate(step.microcycle.value);
+	}
+
+	const auto link = [&](BusStep *prototype_steps) {
+		return &all_bus_steps_[size_t(prototype_steps - prototype.all_bus_steps_.data())];
+	};
+	reset_bus_steps_ = link(prototype.reset_bus_steps_);
+	branch_taken_bus_steps_ = link(prototype.branch_taken_bus_steps_);
+	branch_byte_not_taken_bus_steps_ = link(prototype.branch_byte_not_taken_bus_steps_);
+	branch_word_not_taken_bus_steps_ = link(prototype.branch_word_not_taken_bus_steps_);
+	bsr_bus_steps_ = link(prototype.bsr_bus_steps_);
+	dbcc_condition_true_steps_ = link(prototype.dbcc_condition_true_steps_);
+	dbcc_condition_false_no_branch_steps_ = link(prototype.dbcc_condition_false_no_branch_steps_);
+	dbcc_condition_false_branch_steps_ = link(prototype.dbcc_condition_false_branch_steps_);
+	movem_read_steps_ = link(prototype.movem_read_steps_);
+	movem_write_steps_ = link(prototype.movem_write_steps_);
+	trap_steps_ = link(prototype.trap_steps_);
+	bus_error_steps_ = link(prototype.bus_error_steps_);
+
+	set_initial_state();
+}
+
+CPU::MC68000::ProcessorStorage::ProcessorStorage(Tables &tables) {
+	ProcessorStorageConstructor constructor(*this, tables);
 
 	// Create the special programs.
 	const size_t reset_offset = constructor.assemble_program("n n n n n nn nF nf nV nv np np");
@@ -3211,22 +3256,18 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 	);
 
 	// Chuck in the proper micro-ops for handling an exception.
-	const auto short_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	const auto short_exception_offset = tables.micro_ops.size();
+	tables.micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	tables.micro_ops.emplace_back();
 
-	const auto long_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	const auto long_exception_offset = tables.micro_ops.size();
+	tables.micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	tables.micro_ops.emplace_back();
 
 	// Install operations.
-//#ifndef NDEBUG
-	const std::clock_t start = std::clock();
-//#endif
 	constructor.install_instructions();
-//#ifndef NDEBUG
-	std::cout << "Construction took " << double(std::clock() - start) / double(CLOCKS_PER_SEC / 1000) << "ms" << std::endl;
-//#endif
+	all_micro_ops_ = tables.micro_ops.data();
+	instructions = tables.instructions;
 
 	// Realise the special programs as direct pointers.
 	reset_bus_steps_ = &all_bus_steps_[reset_offset];
@@ -3276,15 +3317,19 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 		steps[4].microcycle.value = steps[5].microcycle.value = &program_counter_.halves.low;
 	}
 
-	// Setup the stop cycle.
-	stop_cycle_.length = HalfCycles(2);
-
 	// Complete linkage of the exception micro program.
+	tables.micro_ops[short_exception_offset].bus_program = uint16_t(trap_offset);
 	short_exception_micro_ops_ = &all_micro_ops_[short_exception_offset];
-	short_exception_micro_ops_->bus_program = uint16_t(trap_offset);
 
+	tables.micro_ops[long_exception_offset].bus_program = uint16_t(bus_error_offset);
 	long_exception_micro_ops_ = &all_micro_ops_[long_exception_offset];
-	long_exception_micro_ops_->bus_program = uint16_t(bus_error_offset);
+
+	set_initial_state();
+}
+
+void CPU::MC68000::ProcessorStorage::set_initial_state() {
+	// Setup the stop cycle.
+	stop_cycle_.length = HalfCycles(2);
 
 	// Set initial state.
 	active_step_ = reset_bus_steps_;
@@ -81,6 +81,62 @@ class ProcessorStorage {
 		HalfCycles half_cycles_left_to_run_;
 		HalfCycles e_clock_phase_;
 
+		// Plain memory, if any; see Processor::set_plain_memory. The contention phase is the
+		// time since construction, modulo 16, kept in the same way as the E clock phase.
+		const uint8_t *const *plain_read_pages_ = nullptr;
+		uint8_t *const *plain_write_pages_ = nullptr;
+		const uint16_t *plain_contention_ = nullptr;
+		int plain_contention_operation_ = Microcycle::SelectWord | Microcycle::SelectByte;	// Operation flags that identify a contended microcycle.
+		HalfCycles contention_phase_;
+
+		/*!
+			Performs @c cycle directly if it is either free of any address or an access to plain memory;
+			in the latter case VPA and bus error are also cleared.
+
+			@param phase The contention phase at which @c cycle begins.
+			@returns The time taken by @c cycle, including any contention, or 0 if it wasn't performed.
+		*/
+		forceinline HalfCycles perform_plain_cycle(const Microcycle &cycle, int phase) {
+			if(cycle.operation & (Microcycle::Reset | Microcycle::InterruptAcknowledge)) return HalfCycles(0);
+			if(!(cycle.operation & (Microcycle::NewAddress | Microcycle::SameAddress))) return cycle.length;
+
+			const uint32_t address = cycle.host_endian_byte_address();
+			const uint32_t page = address >> 16;
+			if(cycle.operation & Microcycle::Read) {
+				const uint8_t *const memory = plain_read_pages_[page];
+				if(!memory) return HalfCycles(0);
+
+				switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte)) {
+					default: break;
+					case Microcycle::SelectWord:
+						cycle.value->full = *reinterpret_cast<const uint16_t *>(&memory[address & 0xffff]);
+					break;
+					case Microcycle::SelectByte:
+						cycle.value->halves.low = memory[address & 0xffff];
+					break;
+				}
+			} else {
+				uint8_t *const memory = plain_write_pages_[page];
+				if(!memory) return HalfCycles(0);
+				cycle.apply(&memory[address & 0xffff]);
+			}
+
+			is_peripheral_address_ = false;
+			bus_error_ = false;
+
+			// Stretch the relevant strobe until the next slot in which this page is available, if it is contended.
+			HalfCycles length = cycle.length;
+			const int slots = (plain_contention_ && (cycle.operation & plain_contention_operation_)) ? plain_contention_[page] : 0;
+			if(slots) {
+				int end = (phase + length.as<int>()) & 15;
+				while(!(slots & (1 << end))) {
+					length += HalfCycles(1);
+					end = (end + 1) & 15;
+				}
+			}
+			return length;
+		}
+
 		enum class Operation: uint8_t {
 			None,
 			ABCD,	SBCD,	NBCD,
@@ -410,19 +466,21 @@ class ProcessorStorage {
 			}
 		};
 
-		// Storage for all the sequences of bus steps and micro-ops used throughout
-		// the 68000.
+		// Storage for all the sequences of bus steps used throughout the 68000. Bus steps
+		// point directly into this instance and some are modified at runtime, so each
+		// instance has its own copy.
 		std::vector<BusStep> all_bus_steps_;
-		std::vector<MicroOp> all_micro_ops_;
 
-		// A lookup table from instructions to implementations.
-		Program instructions[65536];
+		// Storage for all micro-ops, and a lookup table from instructions to implementations.
+		// These are identical for every instance, so are generated once and then shared.
+		const MicroOp *all_micro_ops_ = nullptr;
+		const Program *instructions = nullptr;
 
 		// Special steps and programs for exception handlers.
 		BusStep *reset_bus_steps_;
-		MicroOp *long_exception_micro_ops_;		// i.e. those that leave 14 bytes on the stack — bus error and address error.
-		MicroOp *short_exception_micro_ops_;	// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
-		MicroOp *interrupt_micro_ops_;
+		const MicroOp *long_exception_micro_ops_;	// i.e. those that leave 14 bytes on the stack — bus error and address error.
+		const MicroOp *short_exception_micro_ops_;	// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
+		const MicroOp *interrupt_micro_ops_;
 
 		// Special micro-op sequences and storage for conditionals.
 		BusStep *branch_taken_bus_steps_;
@@ -545,6 +603,18 @@ class ProcessorStorage {
 		inline void set_status(uint16_t);
 
 	private:
+		/// Backing storage for the shared micro-ops and instruction table.
+		struct Tables {
+			std::vector<MicroOp> micro_ops;
+			Program instructions[65536];
+		};
+
+		/// Generates all tables from scratch, populating @c tables and this instance's bus steps.
+		ProcessorStorage(Tables &tables);
+
+		/// Sets the register and execution state that a newly-constructed processor should have.
+		void set_initial_state();
+
 		friend class ProcessorStorageConstructor;
 		friend class ProcessorStorageTests;
 		friend class State;
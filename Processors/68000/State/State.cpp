@@ -164,7 +164,7 @@ State::State(const ProcessorBase &src): State() {
 	execution_state.bus_step = uint8_t(src.active_step_ - bus_step_base);
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	for(int c = 0; c < 7; ++c) {
 		target.address_[c].full = registers.address[c];
@@ -20,6 +20,7 @@ class AllRAMProcessor:
 
 	public:
 		static AllRAMProcessor *Processor();
+		virtual ~AllRAMProcessor() {}
 
 		struct MemoryAccessDelegate {
 			virtual void z80_all_ram_processor_did_perform_bus_operation(CPU::Z80::AllRAMProcessor &processor, CPU::Z80::PartialMachineCycle::Operation operation, uint16_t address, uint8_t value, HalfCycles time_stamp) = 0;
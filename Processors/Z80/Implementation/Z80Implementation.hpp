@@ -10,9 +10,16 @@ template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> Processor <T, uses_bus_request, uses_wait_line>
 				::Processor(T &bus_handler) :
-					bus_handler_(bus_handler) {
-	install_default_instruction_set();
-}
+					ProcessorBase(uses_wait_line),
+					bus_handler_(bus_handler) {}
+
+// Where the compiler supports taking the addresses of labels, micro-ops are dispatched by jumping
+// directly from the end of one to the start of the next rather than via a single switch. Define
+// Z80_SWITCH_DISPATCH to use the switch regardless; the SCons build does so if passed
+// z80_switch_dispatch=1.
+#if defined(__GNUC__) && !defined(Z80_SWITCH_DISPATCH)
+#define Z80_THREADED_DISPATCH
+#endif
 
 template <	class T,
 			bool uses_bus_request,
@@ -36,11 +43,79 @@ template <	class T,
 		scheduled_program_counter_ = base_page_.fetch_decode_execute_data;	\
 	}
 
+#ifdef Z80_THREADED_DISPATCH
+	// In the same order as MicroOp::Type.
+	static const void *const micro_op_labels[] = {
+		&&BusOperation,	&&DecodeOperation,	&&DecodeOperationNoRChange,	&&MoveToNextProgram,
+
+		&&Increment8NoFlags,	&&Increment8,	&&Increment16,	&&Decrement8,	&&Decrement16,
+		&&Move8,	&&Move16,
+		&&IncrementPC,
+		&&AssembleAF,	&&DisassembleAF,
+		&&And,	&&Or,	&&Xor,
+		&&TestNZ,	&&TestZ,	&&TestNC,	&&TestC,	&&TestPO,	&&TestPE,	&&TestP,	&&TestM,
+
+		&&ADD16,	&&ADC16,	&&SBC16,
+		&&CP8,	&&SUB8,	&&SBC8,	&&ADD8,	&&ADC8,
+		&&NEG,
+
+		&&ExDEHL,	&&ExAFAFDash,	&&EXX,
+		&&EI,	&&DI,	&&IM,
+
+		&&LDI,	&&LDIR,	&&LDD,	&&LDDR,
+		&&CPI,	&&CPIR,	&&CPD,	&&CPDR,
+		&&INI,	&&INIR,	&&IND,	&&INDR,
+		&&OUTI,	&&OUTD,	&&OUT_R,
+
+		&&RLA,	&&RLCA,	&&RRA,	&&RRCA,
+		&&RLC,	&&RRC,	&&RL,	&&RR,
+		&&SLA,	&&SRA,	&&SLL,	&&SRL,
+		&&RLD,	&&RRD,
+
+		&&SetInstructionPage,	&&CalculateIndexAddress,
+
+		&&BeginNMI,	&&BeginIRQ,	&&BeginIRQMode0,	&&RETN,	&&JumpTo66,	&&HALT,
+		&&DJNZ,	&&DAA,	&&CPL,	&&SCF,	&&CCF,
+		&&RES,	&&BIT,	&&SET,
+		&&CalculateRSTDestination,
+		&&SetAFlags,	&&SetInFlags,	&&SetOutFlags,	&&SetZero,
+		&&IndexedPlaceHolder,
+		&&SetAddrAMemptr,
+		&&Reset,
+	};
+	static_assert(sizeof(micro_op_labels) / sizeof(*micro_op_labels) == MicroOp::Reset + 1);
+
+#define micro_op(x)			x
+#define dispatch_micro_op()	\
+	operation = scheduled_program_counter_;	\
+	++scheduled_program_counter_;	\
+	goto *micro_op_labels[operation->type];
+#define next_micro_op()		dispatch_micro_op()
+#else
+#define micro_op(x)			case MicroOp::x
+#define dispatch_micro_op()	\
+	operation = scheduled_program_counter_;	\
+	++scheduled_program_counter_;	\
+	switch(operation->type)
+#define next_micro_op()		break
+#endif
+
+// Most bus operations are followed by another, as is almost every decode and the end of every program;
+// continue directly into those rather than via dispatch. So e.g. the end of one instruction and the
+// opcode fetch, decode and refresh of the next are performed as a single run.
+#define chain_bus_operation()	\
+	if(scheduled_program_counter_->type == MicroOp::BusOperation) {	\
+		operation = scheduled_program_counter_;	\
+		++scheduled_program_counter_;	\
+		goto perform_bus_operation;	\
+	}
+
 	number_of_cycles_ += cycles;
 	if(!scheduled_program_counter_) {
 		advance_operation();
 	}
 
+	const MicroOp *operation;
 	while(1) {
 
 		do_bus_acknowledge:
@@ -54,8 +129,6 @@ template <	class T,
 		}
 
 		while(true) {
-			const MicroOp *const operation = scheduled_program_counter_;
-			scheduled_program_counter_++;
 
 #define set_did_compute_flags()	\
 	flag_adjustment_history_ |= 1;
@@ -66,8 +139,9 @@ template <	class T,
 	parity_overflow_result_ ^= parity_overflow_result_ << 2;\
 	parity_overflow_result_ ^= parity_overflow_result_ >> 1;
 
-			switch(operation->type) {
-				case MicroOp::BusOperation:
+			dispatch_micro_op() {
+				micro_op(BusOperation):
+				perform_bus_operation:
 					if(number_of_cycles_ < operation->machine_cycle.length) {
 						scheduled_program_counter_--;
 						bus_handler_.flush();
@@ -82,40 +156,73 @@ template <	class T,
 					}
 					number_of_cycles_ -= operation->machine_cycle.length;
 					last_request_status_ = request_status_;
-					number_of_cycles_ -= bus_handler_.perform_machine_cycle(operation->machine_cycle);
+					number_of_cycles_ -= bus_handler_.perform_machine_cycle(machine_cycle_for(operation->machine_cycle));
 					if(uses_bus_request && bus_request_line_) goto do_bus_acknowledge;
-				break;
-				case MicroOp::MoveToNextProgram:
+					chain_bus_operation();
+				next_micro_op();
+				micro_op(MoveToNextProgram):
 					advance_operation();
-				break;
-				case MicroOp::DecodeOperation:
+
+					// If halted and with nothing yet requested to end that, offer the bus handler the chance
+					// to perform the following NOPs in bulk.
+					if(
+						!halt_mask_ && !last_request_status_ && !request_status_ &&
+						(!uses_wait_line || !wait_line_) &&
+						(!uses_bus_request || !bus_request_line_)
+					) {
+						int repetitions = int(number_of_cycles_.as_integral() / HaltedNOPLength);
+						if(repetitions) {
+							const PartialMachineCycle halted_cycle(
+								PartialMachineCycle::ReadOpcode, HalfCycles(HaltedNOPLength), &pc_.full, &operation_, false);
+							const HalfCycles additional = bus_handler_.perform_halted_cycles(halted_cycle, repetitions);
+
+							if(repetitions) {
+								number_of_cycles_ -= HalfCycles(HaltedNOPLength * repetitions) + additional;
+
+								// Account for the refresh counter and flag history as each NOP's decode would have.
+								ir_.halves.low = uint8_t((ir_.halves.low & 0x80) | ((ir_.halves.low + repetitions) & 0x7f));
+								flag_adjustment_history_ = (repetitions < 32) ? (flag_adjustment_history_ << repetitions) : 0;
+
+								// Sample the interrupt lines as the final repetition would have.
+								last_request_status_ = request_status_;
+								if(last_request_status_) {
+									advance_operation();
+								}
+							}
+						}
+					}
+					chain_bus_operation();
+				next_micro_op();
+				micro_op(DecodeOperation):
 					refresh_addr_ = ir_;
 					ir_.halves.low = (ir_.halves.low & 0x80) | ((ir_.halves.low + current_instruction_page_->r_step) & 0x7f);
 					pc_.full += pc_increment_ & uint16_t(halt_mask_);
 					scheduled_program_counter_ = current_instruction_page_->instructions[operation_ & halt_mask_];
 					flag_adjustment_history_ <<= 1;
-				break;
-				case MicroOp::DecodeOperationNoRChange:
+					chain_bus_operation();
+				next_micro_op();
+				micro_op(DecodeOperationNoRChange):
 					refresh_addr_ = ir_;
 					pc_.full += pc_increment_ & uint16_t(halt_mask_);
 					scheduled_program_counter_ = current_instruction_page_->instructions[operation_ & halt_mask_];
-				break;
+					chain_bus_operation();
+				next_micro_op();
 
-				case MicroOp::Increment8NoFlags:	++ *static_cast<uint8_t *>(operation->source);			break;
-				case MicroOp::Increment16:			++ *static_cast<uint16_t *>(operation->source);			break;
-				case MicroOp::IncrementPC:			pc_.full += pc_increment_;								break;
-				case MicroOp::Decrement16:			-- *static_cast<uint16_t *>(operation->source);			break;
-				case MicroOp::Move8:				*static_cast<uint8_t *>(operation->destination) = *static_cast<uint8_t *>(operation->source);		break;
-				case MicroOp::Move16:				*static_cast<uint16_t *>(operation->destination) = *static_cast<uint16_t *>(operation->source);		break;
+				micro_op(Increment8NoFlags):	++ *register_at<uint8_t>(operation->source);			next_micro_op();
+				micro_op(Increment16):			++ *register_at<uint16_t>(operation->source);			next_micro_op();
+				micro_op(IncrementPC):			pc_.full += pc_increment_;								next_micro_op();
+				micro_op(Decrement16):			-- *register_at<uint16_t>(operation->source);			next_micro_op();
+				micro_op(Move8):				*register_at<uint8_t>(operation->destination) = *register_at<uint8_t>(operation->source);		next_micro_op();
+				micro_op(Move16):				*register_at<uint16_t>(operation->destination) = *register_at<uint16_t>(operation->source);		next_micro_op();
 
-				case MicroOp::AssembleAF:
+				micro_op(AssembleAF):
 					temp16_.halves.high = a_;
 					temp16_.halves.low = get_flags();
-				break;
-				case MicroOp::DisassembleAF:
+				next_micro_op();
+				micro_op(DisassembleAF):
 					a_ = temp16_.halves.high;
 					set_flags(temp16_.halves.low);
-				break;
+				next_micro_op();
 
 // MARK: - Logical
 
@@ -127,32 +234,32 @@ template <	class T,
 	carry_result_ = 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::And:
-					a_ &= *static_cast<uint8_t *>(operation->source);
+				micro_op(And):
+					a_ &= *register_at<uint8_t>(operation->source);
 					set_logical_flags(Flag::HalfCarry);
-				break;
+				next_micro_op();
 
-				case MicroOp::Or:
-					a_ |= *static_cast<uint8_t *>(operation->source);
+				micro_op(Or):
+					a_ |= *register_at<uint8_t>(operation->source);
 					set_logical_flags(0);
-				break;
+				next_micro_op();
 
-				case MicroOp::Xor:
-					a_ ^= *static_cast<uint8_t *>(operation->source);
+				micro_op(Xor):
+					a_ ^= *register_at<uint8_t>(operation->source);
 					set_logical_flags(0);
-				break;
+				next_micro_op();
 
 #undef set_logical_flags
 
-				case MicroOp::CPL:
+				micro_op(CPL):
 					a_ ^= 0xff;
 					subtract_flag_ = Flag::Subtract;
 					half_carry_result_ = Flag::HalfCarry;
 					bit53_result_ = a_;
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::CCF:
+				micro_op(CCF):
 					half_carry_result_ = uint8_t(carry_result_ << 4);
 					carry_result_ ^= Flag::Carry;
 					subtract_flag_ = 0;
@@ -162,9 +269,9 @@ template <	class T,
 						bit53_result_ |= a_;
 					}
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SCF:
+				micro_op(SCF):
 					carry_result_ = Flag::Carry;
 					half_carry_result_ = 0;
 					subtract_flag_ = 0;
@@ -174,20 +281,20 @@ template <	class T,
 						bit53_result_ |= a_;
 					}
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
 // MARK: - Flow control
 
-				case MicroOp::DJNZ:
+				micro_op(DJNZ):
 					bc_.halves.high--;
 					if(!bc_.halves.high) {
 						advance_operation();
 					}
-				break;
+				next_micro_op();
 
-				case MicroOp::CalculateRSTDestination:
+				micro_op(CalculateRSTDestination):
 					memptr_.full = operation_ & 0x38;
-				break;
+				next_micro_op();
 
 // MARK: - 8-bit arithmetic
 
@@ -200,8 +307,8 @@ template <	class T,
 	bit53_result_ = uint8_t(b53);	\
 	set_did_compute_flags();
 
-				case MicroOp::CP8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+				micro_op(CP8): {
+					const uint8_t value = *register_at<uint8_t>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
 
@@ -211,10 +318,10 @@ template <	class T,
 
 					// the 5 and 3 flags come from the operand, atypically
 					set_arithmetic_flags(Flag::Subtract, value);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SUB8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+				micro_op(SUB8): {
+					const uint8_t value = *register_at<uint8_t>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
 
@@ -224,10 +331,10 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(Flag::Subtract, result);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SBC8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+				micro_op(SBC8): {
+					const uint8_t value = *register_at<uint8_t>(operation->source);
 					const int result = a_ - value - (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) - (value&0xf) - (carry_result_ & Flag::Carry);
 
@@ -237,10 +344,10 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(Flag::Subtract, result);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ADD8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+				micro_op(ADD8): {
+					const uint8_t value = *register_at<uint8_t>(operation->source);
 					const int result = a_ + value;
 					const int half_result = (a_&0xf) + (value&0xf);
 
@@ -250,10 +357,10 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(0, result);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ADC8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+				micro_op(ADC8): {
+					const uint8_t value = *register_at<uint8_t>(operation->source);
 					const int result = a_ + value + (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) + (value&0xf) + (carry_result_ & Flag::Carry);
 
@@ -263,11 +370,11 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(0, result);
-				} break;
+				} next_micro_op();
 
 #undef set_arithmetic_flags
 
-				case MicroOp::NEG: {
+				micro_op(NEG): {
 					const int overflow = (a_ == 0x80);
 					const int result = -a_;
 					const int halfResult = -(a_&0xf);
@@ -279,10 +386,10 @@ template <	class T,
 					carry_result_ = uint8_t(result >> 8);
 					half_carry_result_ = uint8_t(halfResult);
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::Increment8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+				micro_op(Increment8): {
+					const uint8_t value = *register_at<uint8_t>(operation->source);
 					const int result = value + 1;
 
 					// with an increment, overflow occurs if the sign changes from
@@ -290,7 +397,7 @@ template <	class T,
 					const int overflow = (value ^ result) & ~value;
 					const int half_result = (value&0xf) + 1;
 
-					*static_cast<uint8_t *>(operation->source) = uint8_t(result);
+					*register_at<uint8_t>(operation->source) = uint8_t(result);
 
 					// sign, zero and 5 & 3 are set directly from the result
 					bit53_result_ = sign_result_ = zero_result_ = uint8_t(result);
@@ -298,10 +405,10 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 5);
 					subtract_flag_ = 0;
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::Decrement8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+				micro_op(Decrement8): {
+					const uint8_t value = *register_at<uint8_t>(operation->source);
 					const int result = value - 1;
 
 					// with a decrement, overflow occurs if the sign changes from
@@ -309,7 +416,7 @@ template <	class T,
 					const int overflow = (value ^ result) & value;
 					const int half_result = (value&0xf) - 1;
 
-					*static_cast<uint8_t *>(operation->source) = uint8_t(result);
+					*register_at<uint8_t>(operation->source) = uint8_t(result);
 
 					// sign, zero and 5 & 3 are set directly from the result
 					bit53_result_ = sign_result_ = zero_result_ = uint8_t(result);
@@ -317,9 +424,9 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 5);
 					subtract_flag_ = Flag::Subtract;
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::DAA: {
+				micro_op(DAA): {
 					const int lowNibble = a_ & 0xf;
 					const int highNibble = a_ >> 4;
 					int amountToAdd = 0;
@@ -360,13 +467,13 @@ template <	class T,
 
 					set_parity(a_);
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
 // MARK: - 16-bit arithmetic
 
-				case MicroOp::ADD16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+				micro_op(ADD16): {
+					memptr_.full = *register_at<uint16_t>(operation->destination);
+					const uint16_t sourceValue = *register_at<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = sourceValue + destinationValue;
 					const int halfResult = (sourceValue&0xfff) + (destinationValue&0xfff);
@@ -377,13 +484,13 @@ template <	class T,
 					subtract_flag_ = 0;
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
+					*register_at<uint16_t>(operation->destination) = uint16_t(result);
 					memptr_.full++;
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ADC16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+				micro_op(ADC16): {
+					memptr_.full = *register_at<uint16_t>(operation->destination);
+					const uint16_t sourceValue = *register_at<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = sourceValue + destinationValue + (carry_result_ & Flag::Carry);
 					const int halfResult = (sourceValue&0xfff) + (destinationValue&0xfff) + (carry_result_ & Flag::Carry);
@@ -399,13 +506,13 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 13);
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
+					*register_at<uint16_t>(operation->destination) = uint16_t(result);
 					memptr_.full++;
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SBC16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+				micro_op(SBC16): {
+					memptr_.full = *register_at<uint16_t>(operation->destination);
+					const uint16_t sourceValue = *register_at<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = destinationValue - sourceValue - (carry_result_ & Flag::Carry);
 					const int halfResult = (destinationValue&0xfff) - (sourceValue&0xfff) - (carry_result_ & Flag::Carry);
@@ -424,27 +531,27 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 13);
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
+					*register_at<uint16_t>(operation->destination) = uint16_t(result);
 					memptr_.full++;
-				} break;
+				} next_micro_op();
 
 // MARK: - Conditionals
 
 #define decline_conditional()	\
 	if(operation->source) {		\
-		scheduled_program_counter_ = (MicroOp *)operation->source;	\
+		scheduled_program_counter_ = static_cast<const MicroOp *>(operation->source);	\
 	} else {	\
 		advance_operation();	\
 	}
 
-				case MicroOp::TestNZ:	if(!zero_result_)								{ decline_conditional(); }		break;
-				case MicroOp::TestZ:	if(zero_result_)								{ decline_conditional(); }		break;
-				case MicroOp::TestNC:	if(carry_result_ & Flag::Carry)					{ decline_conditional(); }		break;
-				case MicroOp::TestC:	if(!(carry_result_ & Flag::Carry))				{ decline_conditional(); }		break;
-				case MicroOp::TestPO:	if(parity_overflow_result_ & Flag::Parity)		{ decline_conditional(); }		break;
-				case MicroOp::TestPE:	if(!(parity_overflow_result_ & Flag::Parity))	{ decline_conditional(); }		break;
-				case MicroOp::TestP:	if(sign_result_ & Flag::Sign)					{ decline_conditional(); }		break;
-				case MicroOp::TestM:	if(!(sign_result_ & Flag::Sign))				{ decline_conditional(); }		break;
+				micro_op(TestNZ):	if(!zero_result_)								{ decline_conditional(); }		next_micro_op();
+				micro_op(TestZ):	if(zero_result_)								{ decline_conditional(); }		next_micro_op();
+				micro_op(TestNC):	if(carry_result_ & Flag::Carry)					{ decline_conditional(); }		next_micro_op();
+				micro_op(TestC):	if(!(carry_result_ & Flag::Carry))				{ decline_conditional(); }		next_micro_op();
+				micro_op(TestPO):	if(parity_overflow_result_ & Flag::Parity)		{ decline_conditional(); }		next_micro_op();
+				micro_op(TestPE):	if(!(parity_overflow_result_ & Flag::Parity))	{ decline_conditional(); }		next_micro_op();
+				micro_op(TestP):	if(sign_result_ & Flag::Sign)					{ decline_conditional(); }		next_micro_op();
+				micro_op(TestM):	if(!(sign_result_ & Flag::Sign))				{ decline_conditional(); }		next_micro_op();
 
 #undef decline_conditional
 
@@ -452,26 +559,26 @@ template <	class T,
 
 #define swap(a, b)	temp = a.full; a.full = b.full; b.full = temp;
 
-				case MicroOp::ExDEHL: {
+				micro_op(ExDEHL): {
 					uint16_t temp;
 					swap(de_, hl_);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ExAFAFDash: {
+				micro_op(ExAFAFDash): {
 					const uint8_t a = a_;
 					const uint8_t f = get_flags();
 					set_flags(afDash_.halves.low);
 					a_ = afDash_.halves.high;
 					afDash_.halves.high = a;
 					afDash_.halves.low = f;
-				} break;
+				} next_micro_op();
 
-				case MicroOp::EXX: {
+				micro_op(EXX): {
 					uint16_t temp;
 					swap(de_, deDash_);
 					swap(bc_, bcDash_);
 					swap(hl_, hlDash_);
-				} break;
+				} next_micro_op();
 
 #undef swap
 
@@ -496,23 +603,23 @@ template <	class T,
 	parity_overflow_result_ = bc_.full ? Flag::Parity : 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::LDDR: {
+				micro_op(LDDR): {
 					LDxR_STEP(-1);
 					REPEAT(bc_.full);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::LDIR: {
+				micro_op(LDIR): {
 					LDxR_STEP(1);
 					REPEAT(bc_.full);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::LDD: {
+				micro_op(LDD): {
 					LDxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::LDI: {
+				micro_op(LDI): {
 					LDxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef LDxR_STEP
 
@@ -533,23 +640,23 @@ template <	class T,
 	bit53_result_ = uint8_t((result&0x8) | ((result&0x2) << 4));	\
 	set_did_compute_flags();
 
-				case MicroOp::CPDR: {
+				micro_op(CPDR): {
 					CPxR_STEP(-1);
 					REPEAT(bc_.full && sign_result_);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::CPIR: {
+				micro_op(CPIR): {
 					CPxR_STEP(1);
 					REPEAT(bc_.full && sign_result_);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::CPD: {
+				micro_op(CPD): {
 					CPxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::CPI: {
+				micro_op(CPI): {
 					CPxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef CPxR_STEP
 
@@ -584,23 +691,23 @@ template <	class T,
 	set_parity(summation);	\
 	set_did_compute_flags();
 
-				case MicroOp::INDR: {
+				micro_op(INDR): {
 					INxR_STEP(-1);
 					REPEAT(bc_.halves.high);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::INIR: {
+				micro_op(INIR): {
 					INxR_STEP(1);
 					REPEAT(bc_.halves.high);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::IND: {
+				micro_op(IND): {
 					INxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::INI: {
+				micro_op(INI): {
 					INxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef INxR_STEP
 
@@ -624,30 +731,30 @@ template <	class T,
 	set_parity(summation);	\
 	set_did_compute_flags();
 
-				case MicroOp::OUT_R:
+				micro_op(OUT_R):
 					REPEAT(bc_.halves.high);
-				break;
+				next_micro_op();
 
-				case MicroOp::OUTD: {
+				micro_op(OUTD): {
 					OUTxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::OUTI: {
+				micro_op(OUTI): {
 					OUTxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef OUTxR_STEP
 
 // MARK: - Bit Manipulation
 
-				case MicroOp::BIT: {
-					const uint8_t result = *static_cast<uint8_t *>(operation->source) & (1 << ((operation_ >> 3)&7));
+				micro_op(BIT): {
+					const uint8_t result = *register_at<uint8_t>(operation->source) & (1 << ((operation_ >> 3)&7));
 
 					// Leak MEMPTR into bits 5 and 3 if this is either BIT n,(HL) or BIT n,(IX/IY+d).
 					if(current_instruction_page_->is_indexed || ((operation_&0x07) == 6)) {
 						bit53_result_ = memptr_.halves.high;
 					} else {
-						bit53_result_ = *static_cast<uint8_t *>(operation->source);
+						bit53_result_ = *register_at<uint8_t>(operation->source);
 					}
 
 					sign_result_ = zero_result_ = result;
@@ -655,15 +762,15 @@ template <	class T,
 					subtract_flag_ = 0;
 					parity_overflow_result_ = result ? 0 : Flag::Parity;
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RES:
-					*static_cast<uint8_t *>(operation->source) &= ~(1 << ((operation_ >> 3)&7));
-				break;
+				micro_op(RES):
+					*register_at<uint8_t>(operation->source) &= ~(1 << ((operation_ >> 3)&7));
+				next_micro_op();
 
-				case MicroOp::SET:
-					*static_cast<uint8_t *>(operation->source) |= (1 << ((operation_ >> 3)&7));
-				break;
+				micro_op(SET):
+					*register_at<uint8_t>(operation->source) |= (1 << ((operation_ >> 3)&7));
+				next_micro_op();
 
 // MARK: - Rotation and shifting
 
@@ -673,88 +780,88 @@ template <	class T,
 	subtract_flag_ = half_carry_result_ = 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::RLA: {
+				micro_op(RLA): {
 					const uint8_t new_carry = a_ >> 7;
 					a_ = uint8_t((a_ << 1) | (carry_result_ & Flag::Carry));
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RRA: {
+				micro_op(RRA): {
 					const uint8_t new_carry = a_ & 1;
 					a_ = uint8_t((a_ >> 1) | (carry_result_ << 7));
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RLCA: {
+				micro_op(RLCA): {
 					const uint8_t new_carry = a_ >> 7;
 					a_ = uint8_t((a_ << 1) | new_carry);
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RRCA: {
+				micro_op(RRCA): {
 					const uint8_t new_carry = a_ & 1;
 					a_ = uint8_t((a_ >> 1) | (new_carry << 7));
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
 #undef set_rotate_flags
 
 #define set_shift_flags()	\
-	sign_result_ = zero_result_ = bit53_result_ = *static_cast<uint8_t *>(operation->source);	\
+	sign_result_ = zero_result_ = bit53_result_ = *register_at<uint8_t>(operation->source);	\
 	set_parity(sign_result_);	\
 	half_carry_result_ = 0;	\
 	subtract_flag_ = 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::RLC:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) << 1) | carry_result_);
+				micro_op(RLC):
+					carry_result_ = *register_at<uint8_t>(operation->source) >> 7;
+					*register_at<uint8_t>(operation->source) = uint8_t((*register_at<uint8_t>(operation->source) << 1) | carry_result_);
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::RRC:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
+				micro_op(RRC):
+					carry_result_ = *register_at<uint8_t>(operation->source);
+					*register_at<uint8_t>(operation->source) = uint8_t((*register_at<uint8_t>(operation->source) >> 1) | (carry_result_ << 7));
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::RL: {
-					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) << 1) | (carry_result_ & Flag::Carry));
+				micro_op(RL): {
+					const uint8_t next_carry = *register_at<uint8_t>(operation->source) >> 7;
+					*register_at<uint8_t>(operation->source) = uint8_t((*register_at<uint8_t>(operation->source) << 1) | (carry_result_ & Flag::Carry));
 					carry_result_ = next_carry;
 					set_shift_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RR: {
-					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
+				micro_op(RR): {
+					const uint8_t next_carry = *register_at<uint8_t>(operation->source);
+					*register_at<uint8_t>(operation->source) = uint8_t((*register_at<uint8_t>(operation->source) >> 1) | (carry_result_ << 7));
 					carry_result_ = next_carry;
 					set_shift_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SLA:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t(*static_cast<uint8_t *>(operation->source) << 1);
+				micro_op(SLA):
+					carry_result_ = *register_at<uint8_t>(operation->source) >> 7;
+					*register_at<uint8_t>(operation->source) = uint8_t(*register_at<uint8_t>(operation->source) << 1);
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SRA:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (*static_cast<uint8_t *>(operation->source) & 0x80));
+				micro_op(SRA):
+					carry_result_ = *register_at<uint8_t>(operation->source);
+					*register_at<uint8_t>(operation->source) = uint8_t((*register_at<uint8_t>(operation->source) >> 1) | (*register_at<uint8_t>(operation->source) & 0x80));
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SLL:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t(*static_cast<uint8_t *>(operation->source) << 1) | 1;
+				micro_op(SLL):
+					carry_result_ = *register_at<uint8_t>(operation->source) >> 7;
+					*register_at<uint8_t>(operation->source) = uint8_t(*register_at<uint8_t>(operation->source) << 1) | 1;
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SRL:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1));
+				micro_op(SRL):
+					carry_result_ = *register_at<uint8_t>(operation->source);
+					*register_at<uint8_t>(operation->source) = uint8_t((*register_at<uint8_t>(operation->source) >> 1));
 					set_shift_flags();
-				break;
+				next_micro_op();
 
 #undef set_shift_flags
 
@@ -765,104 +872,104 @@ template <	class T,
 	bit53_result_ = zero_result_ = sign_result_ = a_;	\
 	set_did_compute_flags();
 
-				case MicroOp::RRD: {
+				micro_op(RRD): {
 					memptr_.full = hl_.full + 1;
 					const uint8_t low_nibble = a_ & 0xf;
 					a_ = (a_ & 0xf0) | (temp8_ & 0xf);
 					temp8_ = uint8_t((temp8_ >> 4) | (low_nibble << 4));
 					set_decimal_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RLD: {
+				micro_op(RLD): {
 					memptr_.full = hl_.full + 1;
 					const uint8_t low_nibble = a_ & 0xf;
 					a_ = (a_ & 0xf0) | (temp8_ >> 4);
 					temp8_ = uint8_t((temp8_ << 4) | low_nibble);
 					set_decimal_rotate_flags();
-				} break;
+				} next_micro_op();
 
 #undef set_decimal_rotate_flags
 
 
 // MARK: - Interrupt state
 
-				case MicroOp::EI:
+				micro_op(EI):
 					iff1_ = iff2_ = true;
 					if(irq_line_) request_status_ |= Interrupt::IRQ;
-				break;
+				next_micro_op();
 
-				case MicroOp::DI:
+				micro_op(DI):
 					iff1_ = iff2_ = false;
 					request_status_ &= ~Interrupt::IRQ;
-				break;
+				next_micro_op();
 
-				case MicroOp::IM:
+				micro_op(IM):
 					switch(operation_ & 0x18) {
 						case 0x00:	interrupt_mode_ = 0;	break;
 						case 0x08:	interrupt_mode_ = 0;	break;	// IM 0/1
 						case 0x10:	interrupt_mode_ = 1;	break;
 						case 0x18:	interrupt_mode_ = 2;	break;
 					}
-				break;
+				next_micro_op();
 
 // MARK: - Input and Output
 
-				case MicroOp::SetInFlags:
+				micro_op(SetInFlags):
 					subtract_flag_ = half_carry_result_ = 0;
-					sign_result_ = zero_result_ = bit53_result_ = *static_cast<uint8_t *>(operation->source);
+					sign_result_ = zero_result_ = bit53_result_ = *register_at<uint8_t>(operation->source);
 					set_parity(sign_result_);
 					set_did_compute_flags();
 					++memptr_.full;
-				break;
+				next_micro_op();
 
-				case MicroOp::SetOutFlags:
+				micro_op(SetOutFlags):
 					memptr_.full = bc_.full + 1;
-				break;
+				next_micro_op();
 
-				case MicroOp::SetAFlags:
+				micro_op(SetAFlags):
 					subtract_flag_ = half_carry_result_ = 0;
 					parity_overflow_result_ = iff2_ ? Flag::Parity : 0;
 					sign_result_ = zero_result_ = bit53_result_ = a_;
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SetZero:
+				micro_op(SetZero):
 					temp8_ = 0;
-				break;
+				next_micro_op();
 
 // MARK: - Special-case Flow
 
-				case MicroOp::BeginIRQMode0:
+				micro_op(BeginIRQMode0):
 					pc_increment_ = 0;			// deliberate fallthrough
-				case MicroOp::BeginIRQ:
+				micro_op(BeginIRQ):
 					iff2_ = iff1_ = false;
 					request_status_ &= ~Interrupt::IRQ;
 					temp16_.full = 0x38;
-				break;
+				next_micro_op();
 
-				case MicroOp::BeginNMI:
+				micro_op(BeginNMI):
 					iff2_ = iff1_;
 					iff1_ = false;
 					request_status_ &= ~Interrupt::IRQ;
-				break;
+				next_micro_op();
 
-				case MicroOp::JumpTo66:
+				micro_op(JumpTo66):
 					pc_.full = 0x66;
-				break;
+				next_micro_op();
 
-				case MicroOp::RETN:
+				micro_op(RETN):
 					iff1_ = iff2_;
 					if(irq_line_ && iff1_) request_status_ |= Interrupt::IRQ;
 					memptr_ = pc_;
-				break;
+				next_micro_op();
 
-				case MicroOp::HALT:
+				micro_op(HALT):
 					halt_mask_ = 0x00;
-				break;
+				next_micro_op();
 
 // MARK: - Interrupt handling
 
-				case MicroOp::Reset:
+				micro_op(Reset):
 					iff1_ = iff2_ = false;
 					interrupt_mode_ = 0;
 					pc_.full = 0;
@@ -870,32 +977,38 @@ template <	class T,
 					a_ = 0xff;
 					set_flags(0xff);
 					ir_.full = 0;
-				break;
+				next_micro_op();
 
 // MARK: - Internal bookkeeping
 
-				case MicroOp::SetInstructionPage:
-					current_instruction_page_ = (InstructionPage *)operation->source;
+				micro_op(SetInstructionPage):
+					current_instruction_page_ = static_cast<const InstructionPage *>(operation->source);
 					scheduled_program_counter_ = current_instruction_page_->fetch_decode_execute_data;
-				break;
+				next_micro_op();
 
-				case MicroOp::CalculateIndexAddress:
-					memptr_.full = uint16_t(*static_cast<uint16_t *>(operation->source) + int8_t(temp8_));
-				break;
+				micro_op(CalculateIndexAddress):
+					memptr_.full = uint16_t(*register_at<uint16_t>(operation->source) + int8_t(temp8_));
+				next_micro_op();
 
-				case MicroOp::SetAddrAMemptr:
-					memptr_.full = uint16_t(((*static_cast<uint16_t *>(operation->source) + 1)&0xff) + (a_ << 8));
-				break;
+				micro_op(SetAddrAMemptr):
+					memptr_.full = uint16_t(((*register_at<uint16_t>(operation->source) + 1)&0xff) + (a_ << 8));
+				next_micro_op();
 
-				case MicroOp::IndexedPlaceHolder:
+				micro_op(IndexedPlaceHolder):
 				return;
 			}
 #undef set_parity
 		}
 
 	}
+#undef chain_bus_operation
+#undef next_micro_op
+#undef dispatch_micro_op
+#undef micro_op
 }
 
+#undef Z80_THREADED_DISPATCH
+
 template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
@@ -926,93 +1039,6 @@ template <	class T,
 	return wait_line_;
 }
 
-#define isTerminal(n)	(n == MicroOp::MoveToNextProgram || n == MicroOp::DecodeOperation || n == MicroOp::DecodeOperationNoRChange)
-
-template <	class T,
-			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-				::assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) {
-	std::size_t number_of_micro_ops = 0;
-	std::size_t lengths[256];
-
-	// Count number of micro-ops required.
-	for(int c = 0; c < 256; c++) {
-		std::size_t length = 0;
-		while(!isTerminal(table[c][length].type)) length++;
-		length++;
-		lengths[c] = length;
-		number_of_micro_ops += length;
-	}
-
-	// Allocate a landing area.
-	std::vector<std::size_t> operation_indices;
-	target.all_operations.reserve(number_of_micro_ops);
-	target.instructions.resize(256, nullptr);
-
-	// Copy in all programs, recording where they go.
-	std::size_t destination = 0;
-	for(std::size_t c = 0; c < 256; c++) {
-		operation_indices.push_back(target.all_operations.size());
-		for(std::size_t t = 0; t < lengths[c];) {
-			// Skip zero-length bus cycles.
-			if(table[c][t].type == MicroOp::BusOperation && table[c][t].machine_cycle.length.as_integral() == 0) {
-				t++;
-				continue;
-			}
-
-			// Skip optional waits if this instance doesn't use the wait line.
-			if(table[c][t].machine_cycle.was_requested && !uses_wait_line) {
-				t++;
-				continue;
-			}
-
-			// If an index placeholder is hit then drop it, and if offsets aren't being added,
-			// then also drop the indexing that follows, which is assumed to be everything
-			// up to and including the next ::CalculateIndexAddress. Coupled to the INDEX() macro.
-			if(table[c][t].type == MicroOp::IndexedPlaceHolder) {
-				t++;
-				if(!add_offsets) {
-					while(table[c][t].type != MicroOp::CalculateIndexAddress) t++;
-					t++;
-				}
-			}
-			target.all_operations.emplace_back(table[c][t]);
-			destination++;
-			t++;
-		}
-	}
-
-	// Since the vector won't change again, it's now safe to set pointers.
-	std::size_t c = 0;
-	for(std::size_t index : operation_indices) {
-		target.instructions[c] = &target.all_operations[index];
-		c++;
-	}
-}
-
-template <	class T,
-			bool uses_bus_request,
-			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
-		::copy_program(const MicroOp *source, std::vector<MicroOp> &destination) {
-	std::size_t length = 0;
-	while(!isTerminal(source[length].type)) length++;
-	std::size_t pointer = 0;
-	while(true) {
-		// TODO: This test is duplicated from assemble_page; can a better factoring be found?
-		// Skip optional waits if this instance doesn't use the wait line.
-		if(source[pointer].machine_cycle.was_requested && !uses_wait_line) {
-			pointer++;
-			continue;
-		}
-
-		destination.emplace_back(source[pointer]);
-		if(isTerminal(source[pointer].type)) break;
-		pointer++;
-	}
-}
-
-#undef isTerminal
-
 bool ProcessorBase::get_halt_line() const {
 	return halt_mask_ == 0x00;
 }
@@ -7,14 +7,44 @@
 //
 
 #include "../Z80.hpp"
+
+#include <cassert>
 #include <cstring>
 
 using namespace CPU::Z80;
 
-ProcessorStorage::ProcessorStorage() {
+ProcessorStorage::ProcessorStorage(const InstructionSet &instruction_set) :
+	conditional_call_untaken_program_(instruction_set.conditional_call_untaken_program),
+	reset_program_(instruction_set.reset_program),
+	irq_program_(instruction_set.irq_program),
+	nmi_program_(instruction_set.nmi_program),
+	base_page_(instruction_set.base_page),
+	ed_page_(instruction_set.ed_page),
+	fd_page_(instruction_set.fd_page),
+	dd_page_(instruction_set.dd_page),
+	cb_page_(instruction_set.cb_page),
+	fdcb_page_(instruction_set.fdcb_page),
+	ddcb_page_(instruction_set.ddcb_page) {
 	set_flags(0xff);
 }
 
+const ProcessorStorage::InstructionSet &ProcessorStorage::instruction_set(bool uses_wait_line) {
+	if(uses_wait_line) {
+		static const InstructionSet instruction_set(true);
+		return instruction_set;
+	}
+
+	static const InstructionSet instruction_set(false);
+	return instruction_set;
+}
+
+ProcessorStorage::InstructionSet::InstructionSet(bool uses_wait_line) {
+	// Programs are written in terms of the registers of a prototype processor, then
+	// stored relative to it.
+	ProcessorStorage prototype(*this);
+	prototype.install_instruction_set(*this, uses_wait_line);
+}
+
 // Elemental bus operations
 #define ReadOpcodeStart()			PartialMachineCycle(PartialMachineCycle::ReadOpcodeStart, HalfCycles(3), &pc_.full, &operation_, false)
 #define ReadOpcodeWait(f)			PartialMachineCycle(PartialMachineCycle::ReadOpcodeWait, HalfCycles(2), &pc_.full, &operation_, f)
@@ -166,31 +196,31 @@ ProcessorStorage::ProcessorStorage() {
 #define ADC16(d, s) StdInstr(InternalOperation(8), InternalOperation(6), {MicroOp::ADC16, &s.full, &d.full})
 #define SBC16(d, s) StdInstr(InternalOperation(8), InternalOperation(6), {MicroOp::SBC16, &s.full, &d.full})
 
-void ProcessorStorage::install_default_instruction_set() {
+void ProcessorStorage::install_instruction_set(InstructionSet &target, bool uses_wait_line) {
 	MicroOp conditional_call_untaken_program[] = Sequence(ReadInc(pc_, memptr_.halves.high));
-	copy_program(conditional_call_untaken_program, conditional_call_untaken_program_);
+	copy_program(conditional_call_untaken_program, target.conditional_call_untaken_program, uses_wait_line);
 
-	assemble_base_page(base_page_, hl_, false, cb_page_);
-	assemble_base_page(dd_page_, ix_, true, ddcb_page_);
-	assemble_base_page(fd_page_, iy_, true, fdcb_page_);
-	assemble_ed_page(ed_page_);
+	assemble_base_page(target.base_page, hl_, false, target.cb_page, uses_wait_line);
+	assemble_base_page(target.dd_page, ix_, true, target.ddcb_page, uses_wait_line);
+	assemble_base_page(target.fd_page, iy_, true, target.fdcb_page, uses_wait_line);
+	assemble_ed_page(target.ed_page, uses_wait_line);
 
-	fdcb_page_.r_step = 0;
-	fd_page_.is_indexed = true;
-	fdcb_page_.is_indexed = true;
+	target.fdcb_page.r_step = 0;
+	target.fd_page.is_indexed = true;
+	target.fdcb_page.is_indexed = true;
 
-	ddcb_page_.r_step = 0;
-	dd_page_.is_indexed = true;
-	ddcb_page_.is_indexed = true;
+	target.ddcb_page.r_step = 0;
+	target.dd_page.is_indexed = true;
+	target.ddcb_page.is_indexed = true;
 
-	assemble_fetch_decode_execute(base_page_, 4);
-	assemble_fetch_decode_execute(dd_page_, 4);
-	assemble_fetch_decode_execute(fd_page_, 4);
-	assemble_fetch_decode_execute(ed_page_, 4);
-	assemble_fetch_decode_execute(cb_page_, 4);
+	assemble_fetch_decode_execute(target.base_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(target.dd_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(target.fd_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(target.ed_page, 4, uses_wait_line);
+	assemble_fetch_decode_execute(target.cb_page, 4, uses_wait_line);
 
-	assemble_fetch_decode_execute(fdcb_page_, 3);
-	assemble_fetch_decode_execute(ddcb_page_, 3);
+	assemble_fetch_decode_execute(target.fdcb_page, 3, uses_wait_line);
+	assemble_fetch_decode_execute(target.ddcb_page, 3, uses_wait_line);
 
 	MicroOp reset_program[] = Sequence(InternalOperation(6), {MicroOp::Reset});
 
@@ -236,14 +266,14 @@ void ProcessorStorage::install_default_instruction_set() {
 		{ MicroOp::MoveToNextProgram }
 	};
 
-	copy_program(reset_program, reset_program_);
-	copy_program(nmi_program, nmi_program_);
-	copy_program(irq_mode0_program, irq_program_[0]);
-	copy_program(irq_mode1_program, irq_program_[1]);
-	copy_program(irq_mode2_program, irq_program_[2]);
+	copy_program(reset_program, target.reset_program, uses_wait_line);
+	copy_program(nmi_program, target.nmi_program, uses_wait_line);
+	copy_program(irq_mode0_program, target.irq_program[0], uses_wait_line);
+	copy_program(irq_mode1_program, target.irq_program[1], uses_wait_line);
+	copy_program(irq_mode2_program, target.irq_program[2], uses_wait_line);
 }
 
-void ProcessorStorage::assemble_ed_page(InstructionPage &target) {
+void ProcessorStorage::assemble_ed_page(InstructionPage &target, bool uses_wait_line) {
 #define IN_C(r)		StdInstr({MicroOp::Move16, &bc_.full, &memptr_.full}, Input(bc_, r), {MicroOp::SetInFlags, &r})
 #define OUT_C(r)	StdInstr(Output(bc_, r), {MicroOp::SetOutFlags})
 #define IN_OUT(r)	IN_C(r), OUT_C(r)
@@ -313,11 +343,11 @@ void ProcessorStorage::assemble_ed_page(InstructionPage &target) {
 		NOP_ROW(),	/* 0xe0 */
 		NOP_ROW(),	/* 0xf0 */
 	};
-	assemble_page(target, ed_program_table, false);
+	assemble_page(target, ed_program_table, false, uses_wait_line);
 #undef NOP_ROW
 }
 
-void ProcessorStorage::assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets) {
+void ProcessorStorage::assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, bool uses_wait_line) {
 #define OCTO_OP_GROUP(m, x)	m(x),	m(x),	m(x),	m(x),	m(x),	m(x),	m(x),	m(x)
 #define CB_PAGE(m, p)	m(RLC), m(RRC),	m(RL),	m(RR),	m(SLA),	m(SRA),	m(SLL),	m(SRL),	OCTO_OP_GROUP(p, BIT),	OCTO_OP_GROUP(m, RES),	OCTO_OP_GROUP(m, SET)
 
@@ -338,13 +368,13 @@ void ProcessorStorage::assemble_cb_page(InstructionPage &target, RegisterPair16
 	InstructionTable offsets_cb_program_table = {
 		CB_PAGE(IX_MODIFY_OP_GROUP, IX_READ_OP_GROUP)
 	};
-	assemble_page(target, add_offsets ? offsets_cb_program_table : cb_program_table, add_offsets);
+	assemble_page(target, add_offsets ? offsets_cb_program_table : cb_program_table, add_offsets, uses_wait_line);
 
 #undef OCTO_OP_GROUP
 #undef CB_PAGE
 }
 
-void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page) {
+void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page, bool uses_wait_line) {
 #define INC_DEC_LD(r)	\
 				StdInstr({MicroOp::Increment8, &r}),	\
 				StdInstr({MicroOp::Decrement8, &r}),	\
@@ -523,11 +553,11 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		std::memcpy(&base_program_table[0x36], &copy_table[0], sizeof(copy_table[0]));
 	}
 
-	assemble_cb_page(cb_page, index, add_offsets);
-	assemble_page(target, base_program_table, add_offsets);
+	assemble_cb_page(cb_page, index, add_offsets, uses_wait_line);
+	assemble_page(target, base_program_table, add_offsets, uses_wait_line);
 }
 
-void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, int length) {
+void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, int length, bool uses_wait_line) {
 	const MicroOp normal_fetch_decode_execute[] = {
 		BusOp(ReadOpcodeStart()),
 		BusOp(ReadOpcodeWait(true)),
@@ -541,7 +571,7 @@ void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, in
 		BusOp(ReadOpcodeEnd()),
 		{ MicroOp::DecodeOperation }
 	};
-	copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute, target.fetch_decode_execute);
+	copy_program((length == 4) ? normal_fetch_decode_execute : short_fetch_decode_execute, target.fetch_decode_execute, uses_wait_line);
 	target.fetch_decode_execute_data = target.fetch_decode_execute.data();
 }
 
@@ -554,3 +584,112 @@ bool ProcessorBase::is_starting_new_instruction() const {
 bool ProcessorBase::get_is_resetting() const {
 	return request_status_ & (Interrupt::PowerOn | Interrupt::Reset);
 }
+
+#define isTerminal(n)	(n == MicroOp::MoveToNextProgram || n == MicroOp::DecodeOperation || n == MicroOp::DecodeOperationNoRChange)
+
+ProcessorStorage::MicroOp ProcessorStorage::relative_micro_op(const MicroOp &op) const {
+	// Any pointer into this prototype is a register; convert it to an offset. Anything
+	// else, i.e. an instruction page or a program, is already shared and can stay as it is.
+	const auto relative = [this] (const void *pointer) -> const void * {
+		const auto address = reinterpret_cast<uintptr_t>(pointer);
+		const auto start = reinterpret_cast<uintptr_t>(this);
+		if(address < start || address >= start + sizeof(ProcessorStorage)) {
+			return pointer;
+		}
+
+		assert(address != start);
+		return reinterpret_cast<const void *>(address - start);
+	};
+
+	// The bus handler sees machine cycles directly, so those are rebuilt rather than adjusted
+	// in place; their pointers are always to registers.
+	const PartialMachineCycle &cycle = op.machine_cycle;
+	assert(!cycle.address || relative(cycle.address) != cycle.address);
+	assert(!cycle.value || relative(cycle.value) != cycle.value);
+	return MicroOp{
+		op.type,
+		relative(op.source),
+		relative(op.destination),
+		PartialMachineCycle(
+			cycle.operation,
+			cycle.length,
+			static_cast<uint16_t *>(const_cast<void *>(relative(cycle.address))),
+			static_cast<uint8_t *>(const_cast<void *>(relative(cycle.value))),
+			cycle.was_requested)
+	};
+}
+
+void ProcessorStorage::assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets, bool uses_wait_line) {
+	std::size_t number_of_micro_ops = 0;
+	std::size_t lengths[256];
+
+	// Count number of micro-ops required.
+	for(int c = 0; c < 256; c++) {
+		std::size_t length = 0;
+		while(!isTerminal(table[c][length].type)) length++;
+		length++;
+		lengths[c] = length;
+		number_of_micro_ops += length;
+	}
+
+	// Allocate a landing area.
+	std::vector<std::size_t> operation_indices;
+	target.all_operations.reserve(number_of_micro_ops);
+	target.instructions.resize(256, nullptr);
+
+	// Copy in all programs, recording where they go.
+	for(std::size_t c = 0; c < 256; c++) {
+		operation_indices.push_back(target.all_operations.size());
+		for(std::size_t t = 0; t < lengths[c];) {
+			// Skip zero-length bus cycles.
+			if(table[c][t].type == MicroOp::BusOperation && table[c][t].machine_cycle.length.as_integral() == 0) {
+				t++;
+				continue;
+			}
+
+			// Skip optional waits if this instruction set doesn't use the wait line.
+			if(table[c][t].machine_cycle.was_requested && !uses_wait_line) {
+				t++;
+				continue;
+			}
+
+			// If an index placeholder is hit then drop it, and if offsets aren't being added,
+			// then also drop the indexing that follows, which is assumed to be everything
+			// up to and including the next ::CalculateIndexAddress. Coupled to the INDEX() macro.
+			if(table[c][t].type == MicroOp::IndexedPlaceHolder) {
+				t++;
+				if(!add_offsets) {
+					while(table[c][t].type != MicroOp::CalculateIndexAddress) t++;
+					t++;
+				}
+			}
+			target.all_operations.emplace_back(relative_micro_op(table[c][t]));
+			t++;
+		}
+	}
+
+	// Since the vector won't change again, it's now safe to set pointers.
+	std::size_t c = 0;
+	for(std::size_t index : operation_indices) {
+		target.instructions[c] = &target.all_operations[index];
+		c++;
+	}
+}
+
+void ProcessorStorage::copy_program(const MicroOp *source, std::vector<MicroOp> &destination, bool uses_wait_line) {
+	std::size_t pointer = 0;
+	while(true) {
+		// TODO: This test is duplicated from assemble_page; can a better factoring be found?
+		// Skip optional waits if this instruction set doesn't use the wait line.
+		if(source[pointer].machine_cycle.was_requested && !uses_wait_line) {
+			pointer++;
+			continue;
+		}
+
+		destination.emplace_back(relative_micro_op(source[pointer]));
+		if(isTerminal(source[pointer].type)) break;
+		pointer++;
+	}
+}
+
+#undef isTerminal
@@ -111,8 +111,14 @@ class ProcessorStorage {
 				Reset
 			};
 			Type type;
-			void *source = nullptr;
-			void *destination = nullptr;
+
+			// Micro-ops are shared between all instances so wherever these, or the address
+			// and value of the machine cycle, refer to a register they do so as an offset from
+			// the start of ProcessorStorage; see register_at and machine_cycle_for.
+			//
+			// Other pointers, e.g. to instruction pages or programs, are used as-is.
+			const void *source = nullptr;
+			const void *destination = nullptr;
 			PartialMachineCycle machine_cycle;
 		};
 
@@ -127,8 +133,63 @@ class ProcessorStorage {
 			InstructionPage() : r_step(1), is_indexed(false) {}
 		};
 
-		ProcessorStorage();
-		void install_default_instruction_set();
+		/*!
+			All micro-op programs and instruction pages. One of these is built, on demand, for each
+			of processors with and without wait line support, and is thereafter shared by all
+			processors of that sort.
+		*/
+		struct InstructionSet {
+			InstructionSet(bool uses_wait_line);
+
+			std::vector<MicroOp> conditional_call_untaken_program;
+			std::vector<MicroOp> reset_program;
+			std::vector<MicroOp> irq_program[3];
+			std::vector<MicroOp> nmi_program;
+
+			InstructionPage base_page;
+			InstructionPage ed_page;
+			InstructionPage fd_page;
+			InstructionPage dd_page;
+
+			InstructionPage cb_page;
+			InstructionPage fdcb_page;
+			InstructionPage ddcb_page;
+		};
+
+		/// @returns The shared instruction set for processors that do or do not use the wait line.
+		static const InstructionSet &instruction_set(bool uses_wait_line);
+
+		ProcessorStorage(const InstructionSet &instruction_set);
+
+		// These are declared first so that no register sits at offset 0.
+		const std::vector<MicroOp> &conditional_call_untaken_program_;
+		const std::vector<MicroOp> &reset_program_;
+		const std::vector<MicroOp> (&irq_program_)[3];
+		const std::vector<MicroOp> &nmi_program_;
+
+		const InstructionPage &base_page_;
+		const InstructionPage &ed_page_;
+		const InstructionPage &fd_page_;
+		const InstructionPage &dd_page_;
+
+		const InstructionPage &cb_page_;
+		const InstructionPage &fdcb_page_;
+		const InstructionPage &ddcb_page_;
+
+		/// @returns The register of this instance at @c offset bytes from the start of ProcessorStorage.
+		template <typename RegisterT> forceinline RegisterT *register_at(const void *offset) {
+			return reinterpret_cast<RegisterT *>(reinterpret_cast<uint8_t *>(this) + reinterpret_cast<uintptr_t>(offset));
+		}
+
+		/// @returns A copy of @c cycle with its address and value referring to this instance's registers.
+		forceinline PartialMachineCycle machine_cycle_for(const PartialMachineCycle &cycle) {
+			return PartialMachineCycle(
+				cycle.operation,
+				cycle.length,
+				cycle.address ? register_at<uint16_t>(cycle.address) : nullptr,
+				cycle.value ? register_at<uint8_t>(cycle.value) : nullptr,
+				cycle.was_requested);
+		}
 
 		uint8_t a_;
 		RegisterPair16 bc_, de_, hl_;
@@ -146,6 +207,7 @@ class ProcessorStorage {
 		uint8_t subtract_flag_;				// contains a copy of the subtract flag in isolation
 		uint8_t carry_result_;				// the carry flag is set if bit 0 of carry_result_ is set
 		uint8_t halt_mask_ = 0xff;
+		static constexpr int HaltedNOPLength = 8;	// i.e. the HalfCycle length of each opcode fetch and refresh performed while halted.
 
 		unsigned int flag_adjustment_history_ = 0;	// a shifting record of whether each opcode set any flags; it turns out
 													// that knowledge of what the last opcode did is necessary to get bits 5 & 3
@@ -170,21 +232,7 @@ class ProcessorStorage {
 		uint8_t temp8_;
 
 		const MicroOp *scheduled_program_counter_ = nullptr;
-
-		std::vector<MicroOp> conditional_call_untaken_program_;
-		std::vector<MicroOp> reset_program_;
-		std::vector<MicroOp> irq_program_[3];
-		std::vector<MicroOp> nmi_program_;
-		InstructionPage *current_instruction_page_;
-
-		InstructionPage base_page_;
-		InstructionPage ed_page_;
-		InstructionPage fd_page_;
-		InstructionPage dd_page_;
-
-		InstructionPage cb_page_;
-		InstructionPage fdcb_page_;
-		InstructionPage ddcb_page_;
+		const InstructionPage *current_instruction_page_ = nullptr;
 
 		/*!
 			Gets the flags register.
@@ -221,14 +269,18 @@ class ProcessorStorage {
 			carry_result_			= flags;
 		}
 
+		// Instruction set generation; these are used only upon a prototype instance, against
+		// whose registers the programs are written.
 		typedef MicroOp InstructionTable[256][30];
-		virtual void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) = 0;
-		virtual void copy_program(const MicroOp *source, std::vector<MicroOp> &destination) = 0;
-
-		void assemble_fetch_decode_execute(InstructionPage &target, int length);
-		void assemble_ed_page(InstructionPage &target);
-		void assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets);
-		void assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page);
+		void install_instruction_set(InstructionSet &target, bool uses_wait_line);
+		MicroOp relative_micro_op(const MicroOp &op) const;
+		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets, bool uses_wait_line);
+		void copy_program(const MicroOp *source, std::vector<MicroOp> &destination, bool uses_wait_line);
+
+		void assemble_fetch_decode_execute(InstructionPage &target, int length, bool uses_wait_line);
+		void assemble_ed_page(InstructionPage &target, bool uses_wait_line);
+		void assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, bool uses_wait_line);
+		void assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page, bool uses_wait_line);
 
 		// Allos state objects to capture and apply state.
 		friend class State;
@@ -56,7 +56,14 @@ State::State(const ProcessorBase &src): State() {
 	execution_state.phase = ExecutionState::Phase::x;	\
 	execution_state.steps_into_phase = int(src.scheduled_program_counter_ - &src.y[0]);
 
-	if(ContainedBy(conditional_call_untaken_program_)) {
+	if(!src.scheduled_program_counter_) {
+		// The processor hasn't run yet, so its first act will be to consume the
+		// power-on request and begin a reset; capture that directly.
+		execution_state.phase = ExecutionState::Phase::Reset;
+		execution_state.steps_into_phase = 0;
+		execution_state.requests &= ~ProcessorStorage::Interrupt::PowerOn;
+		execution_state.pc_increment = 1;
+	} else if(ContainedBy(conditional_call_untaken_program_)) {
 		Populate(UntakenConditionalCall, conditional_call_untaken_program_);
 	} else if(ContainedBy(reset_program_)) {
 		Populate(Reset, reset_program_);
@@ -100,7 +107,7 @@ State::State(const ProcessorBase &src): State() {
 #undef ContainedBy
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	target.a_ = registers.a;
 	target.set_flags(registers.flags);
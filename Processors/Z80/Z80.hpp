@@ -125,9 +125,16 @@ struct PartialMachineCycle {
 		return operation >= Operation::ReadOpcodeWait && operation <= Operation::InterruptWait;
 	}
 
-	PartialMachineCycle(const PartialMachineCycle &rhs) noexcept;
-	PartialMachineCycle(Operation operation, HalfCycles length, uint16_t *address, uint8_t *value, bool was_requested) noexcept;
-	PartialMachineCycle() noexcept;
+	forceinline PartialMachineCycle(const PartialMachineCycle &rhs) noexcept :
+		operation(rhs.operation),
+		length(rhs.length),
+		address(rhs.address),
+		value(rhs.value),
+		was_requested(rhs.was_requested) {}
+	forceinline PartialMachineCycle(Operation operation, HalfCycles length, uint16_t *address, uint8_t *value, bool was_requested) noexcept :
+		operation(operation), length(length), address(address), value(value), was_requested(was_requested) {}
+	forceinline PartialMachineCycle() noexcept :
+		operation(Internal), length(0), address(nullptr), value(nullptr), was_requested(false) {}
 };
 
 /*!
@@ -149,6 +156,27 @@ class BusHandler {
 			return HalfCycles(0);
 		}
 
+		/*!
+			Offered while the Z80 is halted, at the end of each NOP that it performs while awaiting an interrupt.
+			The bus handler may elect to perform some number of further repetitions of that NOP in a single step,
+			e.g. by advancing the rest of the machine directly to the next point at which an interrupt might occur,
+			which is likely to be much cheaper than the equivalent sequence of individual machine cycles.
+
+			Repetitions should stop short of any change to the interrupt lines; that'll be observed only once the
+			final repetition is complete.
+
+			@param cycle An opcode fetch that is representative of each repetition; its length is that of a whole repetition,
+				including the subsequent refresh cycle.
+			@param repetitions On entry, the maximum number of repetitions that will fit within the current run; on exit,
+				the number actually performed, which may be 0 to decline.
+			@returns The number of additional HalfCycles that passed in objective time over those repetitions, exactly
+				as per @c perform_machine_cycle.
+		*/
+		HalfCycles perform_halted_cycles(const PartialMachineCycle &cycle, int &repetitions) {
+			repetitions = 0;
+			return HalfCycles(0);
+		}
+
 		/*!
 			Announces completion of all the cycles supplied to a .run_for request on the Z80. Intended to allow
 			bus handlers to perform any deferred output work.
@@ -238,6 +266,9 @@ class ProcessorBase: public ProcessorStorage {
 			This is not a speedy operation.
 		*/
 		bool is_starting_new_instruction() const;
+
+	protected:
+		ProcessorBase(bool uses_wait_line) : ProcessorStorage(instruction_set(uses_wait_line)) {}
 };
 
 /*!
@@ -285,9 +316,6 @@ template <class T, bool uses_bus_request, bool uses_wait_line> class Processor:
 
 	private:
 		T &bus_handler_;
-
-		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets);
-		void copy_program(const MicroOp *source, std::vector<MicroOp> &destination);
 };
 
 #include "Implementation/Z80Implementation.hpp"
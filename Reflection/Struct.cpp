@@ -391,7 +391,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(!Reflection::Enum::name(*type).empty()) {
 			int value;
 			Reflection::get(*this, key, value, offset);
-			const auto text = Reflection::Enum::to_string(*type, 0);
+			const auto text = Reflection::Enum::to_string(*type, value);
 			push_string(text);
 			return;
 		}
@@ -561,13 +561,15 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 	// Validate the object's declared size.
 	const auto end = bson + size;
 	auto read_int = [&bson] (auto &target) {
-		constexpr auto shift = 8 * (sizeof(target) - 1);
-		target = 0;
+		// Assemble in an unsigned type so that no sign extension occurs along the way.
+		using TargetT = std::remove_reference_t<decltype(target)>;
+		using UnsignedT = std::make_unsigned_t<TargetT>;
+		UnsignedT value = 0;
 		for(size_t c = 0; c < sizeof(target); ++c) {
-			target >>= 8;
-			target |= decltype(target)(*bson) << shift;
+			value |= UnsignedT(*bson) << (c * 8);
 			++bson;
 		}
+		target = TargetT(value);
 	};
 
 	uint32_t object_size;
@@ -600,15 +602,20 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 				uint32_t subobject_size;
 				read_int(subobject_size);
 
-				if(next_type == 0x03 && *type == typeid(Reflection::Struct)) {
-					auto child = reinterpret_cast<Reflection::Struct *>(get(key));
-					child->deserialise(bson - 4, size_t(end - bson + 4));
+				// Subdocuments include their own size field; binary data is followed
+				// by a subtype byte before the data proper.
+				if(next_type == 0x03) {
+					if(type && *type == typeid(Reflection::Struct)) {
+						auto child = reinterpret_cast<Reflection::Struct *>(get(key));
+						if(!child->deserialise(bson - 4, size_t(end - bson + 4))) return false;
+					}
 					bson += subobject_size - 4;
-				}
-
-				if(next_type == 0x05 && *type == typeid(std::vector<uint8_t>)) {
-					auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
-					*child = std::vector<uint8_t>(bson, bson + subobject_size);
+				} else {
+					++bson;
+					if(type && *type == typeid(std::vector<uint8_t>)) {
+						auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
+						*child = std::vector<uint8_t>(bson, bson + subobject_size);
+					}
 					bson += subobject_size;
 				}
 			} break;
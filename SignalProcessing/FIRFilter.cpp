@@ -9,6 +9,14 @@
 #include "FIRFilter.hpp"
 #include <cmath>
 
+#ifndef USE_ACCELERATE
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#endif
+
 #ifndef M_PI
 #define M_PI 3.1415926f
 #endif
@@ -133,12 +141,20 @@ FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float
 	}
 
 	FIRFilter::coefficients_for_idealised_filter_response(filter_coefficients_.data(), A.data(), attenuation, number_of_taps);
+
+#ifndef USE_ACCELERATE
+	build_stride_2_coefficients();
+#endif
 }
 
 FIRFilter::FIRFilter(const std::vector<float> &coefficients) {
 	for(const auto coefficient: coefficients) {
 		filter_coefficients_.push_back(short(coefficient * FixedMultiplier));
 	}
+
+#ifndef USE_ACCELERATE
+	build_stride_2_coefficients();
+#endif
 }
 
 FIRFilter FIRFilter::operator+(const FIRFilter &rhs) const {
@@ -174,3 +190,113 @@ FIRFilter FIRFilter::operator*(const FIRFilter &rhs) const {
 
 	return FIRFilter(sum);
 }
+
+#ifndef USE_ACCELERATE
+
+// MARK: - Dot products
+
+void FIRFilter::build_stride_2_coefficients() {
+	stride_2_coefficients_.clear();
+	for(const auto coefficient: filter_coefficients_) {
+		stride_2_coefficients_.push_back(coefficient);
+		stride_2_coefficients_.push_back(0);
+	}
+
+	// Drop the final zero, so as not to read beyond the final sample.
+	if(!stride_2_coefficients_.empty()) stride_2_coefficients_.pop_back();
+}
+
+namespace {
+
+int dot_product_scalar(const short *coefficients, const short *samples, std::size_t length) {
+	int result = 0;
+	for(std::size_t c = 0; c < length; ++c) {
+		result += coefficients[c] * samples[c];
+	}
+	return result;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+int dot_product_sse2(const short *coefficients, const short *samples, std::size_t length) {
+	__m128i total = _mm_setzero_si128();
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&coefficients[c]));
+		const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&samples[c]));
+		total = _mm_add_epi32(total, _mm_madd_epi16(lhs, rhs));
+	}
+
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(total) + dot_product_scalar(&coefficients[c], &samples[c], length - c);
+}
+
+#if defined(__GNUC__)
+#define USE_AVX2
+
+__attribute__((target("avx2")))
+int dot_product_avx2(const short *coefficients, const short *samples, std::size_t length) {
+	__m256i total = _mm256_setzero_si256();
+	std::size_t c = 0;
+	for(; c + 16 <= length; c += 16) {
+		const __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&coefficients[c]));
+		const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&samples[c]));
+		total = _mm256_add_epi32(total, _mm256_madd_epi16(lhs, rhs));
+	}
+
+	__m128i half = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+	for(; c + 8 <= length; c += 8) {
+		const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&coefficients[c]));
+		const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&samples[c]));
+		half = _mm_add_epi32(half, _mm_madd_epi16(lhs, rhs));
+	}
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+	int result = _mm_cvtsi128_si32(half);
+
+	// Avoid the penalty for mixing AVX and SSE code in the caller.
+	_mm256_zeroupper();
+
+	for(; c < length; ++c) {
+		result += coefficients[c] * samples[c];
+	}
+	return result;
+}
+#endif
+
+#elif defined(__aarch64__)
+
+int dot_product_neon(const short *coefficients, const short *samples, std::size_t length) {
+	int32x4_t total = vdupq_n_s32(0);
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		const int16x8_t lhs = vld1q_s16(&coefficients[c]);
+		const int16x8_t rhs = vld1q_s16(&samples[c]);
+		total = vmlal_s16(total, vget_low_s16(lhs), vget_low_s16(rhs));
+		total = vmlal_high_s16(total, lhs, rhs);
+	}
+
+	return vaddvq_s32(total) + dot_product_scalar(&coefficients[c], &samples[c], length - c);
+}
+
+#endif
+
+}
+
+const FIRFilter::DotProduct FIRFilter::dot_product_ = [] () -> FIRFilter::DotProduct {
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef USE_AVX2
+	if(__builtin_cpu_supports("avx2")) {
+		return dot_product_avx2;
+	}
+#endif
+	return dot_product_sse2;
+#elif defined(__aarch64__)
+	return dot_product_neon;
+#else
+	return dot_product_scalar;
+#endif
+}();
+
+#endif
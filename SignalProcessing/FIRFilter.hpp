@@ -14,6 +14,7 @@
 #define USE_ACCELERATE
 #endif
 
+#include <cstddef>
 #include <vector>
 
 namespace SignalProcessing {
@@ -56,11 +57,19 @@ class FIRFilter {
 				vDSP_dotpr_s1_15(filter_coefficients_.data(), 1, src, vDSP_Stride(stride), &result, filter_coefficients_.size());
 				return result;
 			#else
-				int outputValue = 0;
-				for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
-					outputValue += filter_coefficients_[c] * src[c * stride];
+				switch(stride) {
+					case 1:
+						return short(dot_product_(filter_coefficients_.data(), src, filter_coefficients_.size()) >> FixedShift);
+					case 2:
+						return short(dot_product_(stride_2_coefficients_.data(), src, stride_2_coefficients_.size()) >> FixedShift);
+					default: {
+						int outputValue = 0;
+						for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
+							outputValue += filter_coefficients_[c] * src[c * stride];
+						}
+						return short(outputValue >> FixedShift);
+					}
 				}
-				return short(outputValue >> FixedShift);
 			#endif
 		}
 
@@ -92,6 +101,18 @@ class FIRFilter {
 	private:
 		std::vector<short> filter_coefficients_;
 
+#ifndef USE_ACCELERATE
+		// The coefficients with a zero after each, omitting the final one; a dot product of these with
+		// interleaved samples is that of filter_coefficients_ with every other sample.
+		std::vector<short> stride_2_coefficients_;
+		void build_stride_2_coefficients();
+
+		// Returns the sum of the element-wise products of two arrays of a given length; selected
+		// at startup as the quickest available for this processor.
+		using DotProduct = int (*)(const short *, const short *, std::size_t);
+		static const DotProduct dot_product_;
+#endif
+
 		static void coefficients_for_idealised_filter_response(short *filterCoefficients, float *A, float attenuation, std::size_t numberOfTaps);
 		static float ino(float a);
 };
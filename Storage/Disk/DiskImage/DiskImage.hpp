@@ -9,8 +9,13 @@
 #ifndef DiskImage_hpp
 #define DiskImage_hpp
 
+#include <atomic>
+#include <cstdlib>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 
 #include "../Disk.hpp"
 #include "../Track/Track.hpp"
@@ -71,15 +76,68 @@ class DiskImage {
 
 class DiskImageHolderBase: public Disk {
 	protected:
+		/// The number of tracks that may be cached other than those that have been written but not yet flushed.
+		static constexpr size_t MaximumCachedTracks = 64;
+
+		struct CachedTrack {
+			std::shared_ptr<Track> track;
+			std::list<Track::Address>::iterator usage;
+		};
+
+		// Everything from here to cache_mutex_ may be modified by a prefetch, so is guarded by cache_mutex_.
 		std::set<Track::Address> unwritten_tracks_;
-		std::map<Track::Address, std::shared_ptr<Track>> cached_tracks_;
-		std::unique_ptr<Concurrency::AsyncTaskQueue> update_queue_;
+		std::map<Track::Address, CachedTrack> cached_tracks_;
+		std::list<Track::Address> track_usage_;		// Most-recently used first.
+		std::set<Track::Address> prefetching_tracks_;
+		size_t write_count_ = 0;
+		HeadPosition last_position_;
+		std::mutex cache_mutex_;
+
+		/// Caches @c track as being at @c address, evicting the least-recently used unwritten track if necessary.
+		/// The caller should hold @c cache_mutex_.
+		void cache_track(Track::Address address, const std::shared_ptr<Track> &track) {
+			auto cached_track = cached_tracks_.find(address);
+			if(cached_track != cached_tracks_.end()) {
+				cached_track->second.track = track;
+				touch_track(cached_track->second);
+				return;
+			}
+
+			track_usage_.push_front(address);
+			cached_tracks_.emplace(address, CachedTrack{track, track_usage_.begin()});
+
+			auto candidate = track_usage_.end();
+			while(cached_tracks_.size() - unwritten_tracks_.size() > MaximumCachedTracks && candidate != track_usage_.begin()) {
+				--candidate;
+				if(unwritten_tracks_.find(*candidate) != unwritten_tracks_.end()) continue;
+
+				cached_tracks_.erase(*candidate);
+				candidate = track_usage_.erase(candidate);
+			}
+		}
+
+		/// Marks @c track as the most-recently used. The caller should hold @c cache_mutex_.
+		void touch_track(CachedTrack &track) {
+			track_usage_.splice(track_usage_.begin(), track_usage_, track.usage);
+		}
+
+		// Prefetches and flushes are performed on update_queue_; every access to the disk image other than
+		// for its geometry is made while holding image_mutex_.
+		std::unique_ptr<Concurrency::AsyncTaskQueue> update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+		std::mutex image_mutex_;
+		std::atomic<int> pending_updates_{0};
+		std::atomic<bool> is_closing_{false};
 };
 
 /*!
 	Provides a wrapper that wraps a DiskImage to make it into a Disk, providing caching and,
 	thereby, an intermediate store for modified tracks so that mutable disk images can either
 	update on the fly or perform a block update on closure, as appropriate.
+
+	Whenever a track is requested, those a single step to either side of it, on every head, are
+	decoded speculatively on a background queue, so that a seek ordinarily finds its destination
+	already in the cache. The step size is taken from the most recent seek. Cached tracks other
+	than those awaiting a write are retained on a least-recently-used basis.
 */
 template <typename T> class DiskImageHolder: public DiskImageHolderBase {
 	public:
@@ -96,6 +154,7 @@ template <typename T> class DiskImageHolder: public DiskImageHolderBase {
 
 	private:
 		T disk_image_;
+		void prefetch_around(Track::Address address);
 };
 
 #include "DiskImageImplementation.hpp"
@@ -19,42 +19,131 @@ template <typename T> bool DiskImageHolder<T>::get_is_read_only() {
 }
 
 template <typename T> void DiskImageHolder<T>::flush_tracks() {
-	if(!unwritten_tracks_.empty()) {
-		if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue>();
+	using TrackMap = std::map<Track::Address, std::shared_ptr<Track>>;
+	std::shared_ptr<TrackMap> track_copies(new TrackMap);
+	{
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		if(unwritten_tracks_.empty()) return;
 
-		using TrackMap = std::map<Track::Address, std::shared_ptr<Track>>;
-		std::shared_ptr<TrackMap> track_copies(new TrackMap);
 		for(const auto &address : unwritten_tracks_) {
-			track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_tracks_[address]->clone())));
+			track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_tracks_[address].track->clone())));
 		}
 		unwritten_tracks_.clear();
+	}
 
-		update_queue_->enqueue([this, track_copies]() {
+	++pending_updates_;
+	update_queue_->enqueue([this, track_copies]() {
+		{
+			std::lock_guard<std::mutex> lock_guard(image_mutex_);
 			disk_image_.set_tracks(*track_copies);
-		});
-	}
+		}
+		--pending_updates_;
+	});
 }
 
 template <typename T> void DiskImageHolder<T>::set_track_at_position(Track::Address address, const std::shared_ptr<Track> &track) {
 	if(disk_image_.get_is_read_only()) return;
 
+	std::lock_guard<std::mutex> lock_guard(cache_mutex_);
 	unwritten_tracks_.insert(address);
-	cached_tracks_[address] = track;
+	cache_track(address, track);
+	++write_count_;
 }
 
 template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::get_track_at_position(Track::Address address) {
 	if(address.head >= get_head_count()) return nullptr;
 	if(address.position >= get_maximum_head_position()) return nullptr;
 
-	auto cached_track = cached_tracks_.find(address);
-	if(cached_track != cached_tracks_.end()) return cached_track->second;
+	std::shared_ptr<Track> track;
+	bool is_cached = false;
+	{
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		auto cached_track = cached_tracks_.find(address);
+		if(cached_track != cached_tracks_.end()) {
+			touch_track(cached_track->second);
+			track = cached_track->second.track;
+			is_cached = true;
+		}
+	}
+
+	if(!is_cached) {
+		// Make sure that the disk image is up to date before reading from it; this
+		// will also complete any prefetches already queued.
+		if(pending_updates_) update_queue_->flush();
 
-	std::shared_ptr<Track> track = disk_image_.get_track_at_position(address);
-	if(!track) return nullptr;
-	cached_tracks_[address] = track;
+		// A prefetch of this track may be ongoing, in which case this will wait for it
+		// and then find its result.
+		std::lock_guard<std::mutex> image_lock_guard(image_mutex_);
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		auto cached_track = cached_tracks_.find(address);
+		if(cached_track != cached_tracks_.end()) {
+			touch_track(cached_track->second);
+			track = cached_track->second.track;
+		} else {
+			track = disk_image_.get_track_at_position(address);
+			cache_track(address, track);
+		}
+	}
+
+	prefetch_around(address);
 	return track;
 }
 
+template <typename T> void DiskImageHolder<T>::prefetch_around(Track::Address address) {
+	// Use the most recent step as a guide to the spacing of tracks.
+	int quarters;
+	{
+		std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+		const int step = std::abs(address.position.as_quarter() - last_position_.as_quarter());
+		quarters = (step > 0 && step < 4) ? step : 4;
+		last_position_ = address.position;
+	}
+
+	const int head_count = get_head_count();
+	const HeadPosition maximum_position = get_maximum_head_position();
+	for(int head = 0; head < head_count; ++head) {
+		for(int offset = -quarters; offset <= quarters; offset += quarters) {
+			const int position = address.position.as_quarter() + offset;
+			const Track::Address target(head, HeadPosition(position, 4));
+			if(position < 0 || target.position >= maximum_position) continue;
+
+			size_t write_count;
+			{
+				std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+				if(cached_tracks_.find(target) != cached_tracks_.end()) continue;
+				if(!prefetching_tracks_.insert(target).second) continue;
+				write_count = write_count_;
+			}
+
+			update_queue_->enqueue([this, target, write_count] {
+				if(!is_closing_) {
+					std::lock_guard<std::mutex> image_lock_guard(image_mutex_);
+					{
+						std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+						if(cached_tracks_.find(target) != cached_tracks_.end()) {
+							prefetching_tracks_.erase(target);
+							return;
+						}
+					}
+
+					auto track = disk_image_.get_track_at_position(target);
+
+					// Discard the result if anything has been written since the prefetch was requested,
+					// as it may be older than the cached version of this track that has since been evicted.
+					std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+					if(write_count == write_count_ && cached_tracks_.find(target) == cached_tracks_.end()) {
+						cache_track(target, track);
+					}
+				}
+
+				std::lock_guard<std::mutex> lock_guard(cache_mutex_);
+				prefetching_tracks_.erase(target);
+			});
+		}
+	}
+}
+
 template <typename T> DiskImageHolder<T>::~DiskImageHolder() {
-	if(update_queue_) update_queue_->flush();
+	is_closing_ = true;
+	update_queue_->flush();
 }
@@ -18,16 +18,18 @@ using namespace Storage::Disk;
 
 G64::G64(const std::string &file_name) :
 		file_(file_name) {
+	FileHolder::Cursor cursor = file_.cursor();
+
 	// read and check the file signature
-	if(!file_.check_signature("GCR-1541")) throw Error::InvalidFormat;
+	if(!cursor.check_signature("GCR-1541")) throw Error::InvalidFormat;
 
 	// check the version number
-	int version = file_.get8();
+	int version = cursor.get8();
 	if(version != 0) throw Error::UnknownVersion;
 
 	// get the number of tracks and track size
-	number_of_tracks_ = file_.get8();
-	maximum_track_size_ = file_.get16le();
+	number_of_tracks_ = cursor.get8();
+	maximum_track_size_ = cursor.get16le();
 }
 
 HeadPosition G64::get_maximum_head_position() {
@@ -39,39 +41,41 @@ HeadPosition G64::get_maximum_head_position() {
 std::shared_ptr<Track> G64::get_track_at_position(Track::Address address) {
 	std::shared_ptr<Track> resulting_track;
 
+	// The file is read in place.
+	FileHolder::Cursor cursor = file_.cursor();
+
 	// seek to this track's entry in the track table
-	file_.seek(long((address.position.as_half() * 4) + 0xc), SEEK_SET);
+	cursor.seek(long((address.position.as_half() * 4) + 0xc), SEEK_SET);
 
 	// read the track offset
-	const uint32_t track_offset = file_.get32le();
+	const uint32_t track_offset = cursor.get32le();
 
 	// if the track offset is zero, this track doesn't exist, so...
 	if(!track_offset) return nullptr;
 
 	// seek to the track start
-	file_.seek(long(track_offset), SEEK_SET);
-
-	// get the real track length
-	const uint16_t track_length = file_.get16le();
+	cursor.seek(long(track_offset), SEEK_SET);
 
-	// grab the byte contents of this track
-	const std::vector<uint8_t> track_contents = file_.read(track_length);
+	// get the real track length, and the byte contents of this track
+	const uint16_t claimed_track_length = cursor.get16le();
+	const FileHolder::Span track_contents = cursor.read(claimed_track_length);
+	const uint16_t track_length = uint16_t(track_contents.size());
 
 	// seek to this track's entry in the speed zone table
-	file_.seek(long((address.position.as_half() * 4) + 0x15c), SEEK_SET);
+	cursor.seek(long((address.position.as_half() * 4) + 0x15c), SEEK_SET);
 
 	// read the speed zone offsrt
-	const uint32_t speed_zone_offset = file_.get32le();
+	const uint32_t speed_zone_offset = cursor.get32le();
 
 	// if the speed zone is not constant, create a track based on the whole table; otherwise create one that's constant
 	if(speed_zone_offset > 3) {
 		// seek to start of speed zone
-		file_.seek(long(speed_zone_offset), SEEK_SET);
+		cursor.seek(long(speed_zone_offset), SEEK_SET);
 
 		// read the speed zone bytes
 		const uint16_t speed_zone_length = (track_length + 3) >> 2;
-		uint8_t speed_zone_contents[speed_zone_length];
-		file_.read(speed_zone_contents, speed_zone_length);
+		const FileHolder::Span speed_zone_contents = cursor.read(speed_zone_length);
+		if(speed_zone_contents.size() != speed_zone_length) return nullptr;
 
 		// divide track into appropriately timed PCMSegments
 		std::vector<PCMSegment> segments;
@@ -85,7 +89,7 @@ std::shared_ptr<Track> G64::get_track_at_position(Track::Address address) {
 				PCMSegment segment(
 					Encodings::CommodoreGCR::length_of_a_bit_in_time_zone(current_speed),
 					number_of_bytes * 8,
-					&track_contents[start_byte_in_current_speed]);
+					track_contents.data() + start_byte_in_current_speed);
 				segments.push_back(std::move(segment));
 
 				current_speed = byte_speed;
@@ -98,7 +102,7 @@ std::shared_ptr<Track> G64::get_track_at_position(Track::Address address) {
 		PCMSegment segment(
 			Encodings::CommodoreGCR::length_of_a_bit_in_time_zone(unsigned(speed_zone_offset)),
 			track_length * 8,
-			track_contents
+			track_contents.data()
 		);
 
 		resulting_track = std::make_shared<PCMTrack>(std::move(segment));
@@ -16,14 +16,15 @@ using namespace Storage::Disk;
 
 HFE::HFE(const std::string &file_name) :
 		file_(file_name) {
-	if(!file_.check_signature("HXCPICFE")) throw Error::InvalidFormat;
+	FileHolder::Cursor cursor = file_.cursor();
+	if(!cursor.check_signature("HXCPICFE")) throw Error::InvalidFormat;
 
-	if(file_.get8()) throw Error::UnknownVersion;
-	track_count_ = file_.get8();
-	head_count_ = file_.get8();
+	if(cursor.get8()) throw Error::UnknownVersion;
+	track_count_ = cursor.get8();
+	head_count_ = cursor.get8();
 
-	file_.seek(7, SEEK_CUR);
-	track_list_offset_ = long(file_.get16le()) << 9;
+	cursor.seek(7, SEEK_CUR);
+	track_list_offset_ = long(cursor.get16le()) << 9;
 }
 
 HeadPosition HFE::get_maximum_head_position() {
@@ -35,51 +36,64 @@ int HFE::get_head_count() {
 }
 
 /*!
-	Seeks to the beginning of the track at @c position underneath @c head,
-	returning its length in bytes.
+	Locates the track at @c position underneath @c head, returning its offset within
+	the file and its length in bytes.
 
-	To read the track, start from the current file position, read 256 bytes,
-	skip 256 bytes, read 256 bytes, skip 256 bytes, etc.
+	To read the track, start from the offset, read 256 bytes, skip 256 bytes, read
+	256 bytes, skip 256 bytes, etc.
 */
-uint16_t HFE::seek_track(Track::Address address) {
+std::pair<long, uint16_t> HFE::locate_track(Track::Address address) {
 	// Get track position and length from the lookup table; data is then always interleaved
 	// based on an assumption of two heads.
-	file_.seek(track_list_offset_ + address.position.as_int() * 4, SEEK_SET);
+	FileHolder::Cursor cursor = file_.cursor();
+	cursor.seek(track_list_offset_ + address.position.as_int() * 4, SEEK_SET);
 
-	long track_offset = long(file_.get16le()) << 9;		// Track offset, in units of 512 bytes.
-	uint16_t track_length = file_.get16le();			// Track length, in bytes, containing both the front and back track.
+	long track_offset = long(cursor.get16le()) << 9;		// Track offset, in units of 512 bytes.
+	uint16_t track_length = cursor.get16le();			// Track length, in bytes, containing both the front and back track.
 
-	file_.seek(track_offset, SEEK_SET);
-	if(address.head) file_.seek(256, SEEK_CUR);
+	if(address.head) track_offset += 256;
 
-	return track_length / 2;	// Divide by two to give the track length for a single side.
+	return std::make_pair(track_offset, track_length / 2);	// Divide by two to give the track length for a single side.
+}
+
+/*!
+	Seeks to the beginning of the track at @c position underneath @c head,
+	returning its length in bytes.
+*/
+uint16_t HFE::seek_track(Track::Address address) {
+	const auto location = locate_track(address);
+	file_.seek(location.first, SEEK_SET);
+	return location.second;
 }
 
 std::shared_ptr<Track> HFE::get_track_at_position(Track::Address address) {
 	PCMSegment segment;
 	{
 		std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
-		uint16_t track_length = seek_track(address);
+		const auto location = locate_track(address);
+		const uint16_t track_length = location.second;
 
-		segment.data.resize(track_length * 8);
+		FileHolder::Cursor cursor = file_.cursor();
+		cursor.seek(location.first, SEEK_SET);
 
 		// HFE tracks are stored as 256 bytes for side 1, then 256 bytes for side 2,
 		// then 256 bytes for side 1, then 256 bytes for side 2, etc, until the final
 		// 512-byte segment which will contain less than the full 256 bytes.
 		//
-		// seek_track will have advanced an extra initial 256 bytes if the address
+		// locate_track will have added an extra initial 256 bytes if the address
 		// refers to side 2, so the loop below can act ass though it were definitely
 		// dealing with side 1.
 		uint16_t c = 0;
 		while(c < track_length) {
 			// Decide how many bytes of at most 256 to read, and read them.
-			uint16_t length = uint16_t(std::min(256, track_length - c));
-			std::vector<uint8_t> section = file_.read(length);
+			const FileHolder::Span section = cursor.read(std::min(256, track_length - c));
+			if(section.empty()) break;
 
 			// Push those into the PCMSegment. In HFE the least-significant bit is
 			// serialised first. TODO: move this logic to PCMSegment.
-			for(uint16_t byte = 0; byte < length; ++byte) {
-				const size_t base = size_t(c + byte) << 3;
+			segment.data.resize(size_t(c + section.size()) * 8);
+			for(size_t byte = 0; byte < section.size(); ++byte) {
+				const size_t base = (c + byte) << 3;
 				segment.data[base + 0] = !!(section[byte] & 0x01);
 				segment.data[base + 1] = !!(section[byte] & 0x02);
 				segment.data[base + 2] = !!(section[byte] & 0x04);
@@ -92,8 +106,8 @@ std::shared_ptr<Track> HFE::get_track_at_position(Track::Address address) {
 
 			// Advance the target pointer, and skip the next 256 bytes of the file
 			// (which will be for the other side of the disk).
-			c += length;
-			file_.seek(256, SEEK_CUR);
+			c = uint16_t(c + section.size());
+			cursor.seek(256, SEEK_CUR);
 		}
 	}
 
@@ -122,6 +136,7 @@ void HFE::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tra
 			c += length;
 			file_.seek(256, SEEK_CUR);
 		}
+		file_.flush();
 		lock_guard.unlock();
 	}
 }
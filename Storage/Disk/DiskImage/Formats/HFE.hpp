@@ -13,6 +13,7 @@
 #include "../../../FileHolder.hpp"
 
 #include <string>
+#include <utility>
 
 namespace Storage {
 namespace Disk {
@@ -40,6 +41,7 @@ class HFE: public DiskImage {
 
 	private:
 		Storage::FileHolder file_;
+		std::pair<long, uint16_t> locate_track(Track::Address address);
 		uint16_t seek_track(Track::Address address);
 
 		int head_count_;
@@ -35,9 +35,7 @@ NIB::NIB(const std::string &file_name) :
 
 	// A real NIB should have every single top bit set. Yes, 1/8th of the
 	// file size is a complete waste. But it provides a hook for validation.
-	while(true) {
-		uint8_t next = file_.get8();
-		if(file_.eof()) break;
+	for(const auto next: file_.contents()) {
 		if(!(next & 0x80)) throw Error::InvalidFormat;
 	}
 }
@@ -58,13 +56,11 @@ std::shared_ptr<::Storage::Disk::Track> NIB::get_track_at_position(::Storage::Di
 	// NIBs contain data for even-numbered tracks underneath a single head only.
 	if(address.head) return nullptr;
 
-	long offset = file_offset(address);
-	std::vector<uint8_t> track_data;
-	{
-		std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
-		file_.seek(offset, SEEK_SET);
-		track_data = file_.read(track_length);
-	}
+	// The track is read in place; the constructor has already ensured that the file
+	// is exactly long enough.
+	std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
+	const FileHolder::Span track_data = file_.contents().subspan(size_t(file_offset(address)), size_t(track_length));
+	if(track_data.size() != size_t(track_length)) return nullptr;
 
 	// NIB files leave sync bytes implicit and make no guarantees
 	// about overall track positioning. My current best-guess attempt
@@ -117,10 +113,7 @@ std::shared_ptr<::Storage::Disk::Track> NIB::get_track_at_position(::Storage::Di
 			// This is the usual case; the only occasion on which it won't be true is
 			// when the initial sync was detected to carry over the index hole,
 			// in which case there's nothing to copy.
-			std::vector<uint8_t> data_segment(
-				track_data.begin() + off_t(index),
-				track_data.begin() + off_t(location));
-			segment += PCMSegment(data_segment);
+			segment += PCMSegment((location - index) * 8, track_data.data() + index);
 		}
 
 		// Add a sync from sync_start to end of 0xffs, if there are
@@ -137,10 +130,7 @@ std::shared_ptr<::Storage::Disk::Track> NIB::get_track_at_position(::Storage::Di
 	// the notional index hole, the loop above will already have completed the track
 	// with sync, so no need to deal with that case here.
 	if(index < track_length) {
-		std::vector<uint8_t> data_segment(
-			track_data.begin() + off_t(index),
-			track_data.end());
-		segment += PCMSegment(data_segment);
+		segment += PCMSegment((track_data.size() - index) * 8, track_data.data() + index);
 	}
 
 	return std::make_shared<PCMTrack>(segment);
@@ -194,4 +184,5 @@ void NIB::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tra
 		file_.seek(file_offset(track.first), SEEK_SET);
 		file_.write(track.second);
 	}
+	file_.flush();
 }
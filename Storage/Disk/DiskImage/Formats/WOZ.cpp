@@ -18,43 +18,40 @@ using namespace Storage::Disk;
 WOZ::WOZ(const std::string &file_name) :
 	file_(file_name) {
 
+	// The file is parsed in place.
+	FileHolder::Cursor cursor = file_.cursor();
+
 	const char signature[8] = {
 		'W', 'O', 'Z', '1',
 		char(0xff), 0x0a, 0x0d, 0x0a
 	};
-	if(!file_.check_signature(signature, 8)) throw Error::InvalidFormat;
+	if(!cursor.check_signature(signature, 8)) throw Error::InvalidFormat;
 
 	// Get the file's CRC32.
-	const uint32_t crc = file_.get32le();
-
-	// Get the collection of all data that contributes to the CRC.
-	post_crc_contents_ = file_.read(size_t(file_.stats().st_size - 12));
+	const uint32_t crc = cursor.get32le();
 
-	// Test the CRC.
-	const uint32_t computed_crc = crc_generator.compute_crc(post_crc_contents_);
+	// Test the CRC against all data that contributes to it.
+	const uint32_t computed_crc = crc_generator.compute_crc(file_.contents().subspan(12));
 	if(crc != computed_crc) {
 		 throw Error::InvalidFormat;
 	}
 
-	// Retreat to the first byte after the CRC.
-	file_.seek(12, SEEK_SET);
-
 	// Parse all chunks up front.
 	bool has_tmap = false;
 	while(true) {
-		const uint32_t chunk_id = file_.get32le();
-		const uint32_t chunk_size = file_.get32le();
-		if(file_.eof()) break;
+		const uint32_t chunk_id = cursor.get32le();
+		const uint32_t chunk_size = cursor.get32le();
+		if(cursor.eof()) break;
 
-		long end_of_chunk = file_.tell() + long(chunk_size);
+		long end_of_chunk = cursor.tell() + long(chunk_size);
 
 		#define CK(str) (str[0] | (str[1] << 8) | (str[2] << 16) | (str[3] << 24))
 		switch(chunk_id) {
 			case CK("INFO"): {
-				const uint8_t version = file_.get8();
+				const uint8_t version = cursor.get8();
 				if(version != 1) break;
-				is_3_5_disk_ = file_.get8() == 2;
-				is_read_only_ = file_.get8() == 1;
+				is_3_5_disk_ = cursor.get8() == 2;
+				is_read_only_ = cursor.get8() == 1;
 				/* Ignored:
 					1 byte: Synchronized; 1 = Cross track sync was used during imaging.
 					1 byte: Cleaned; 1 = MC3470 fake bits have been removed.
@@ -63,12 +60,13 @@ WOZ::WOZ(const std::string &file_name) :
 			} break;
 
 			case CK("TMAP"): {
-				file_.read(track_map_, 160);
-				has_tmap = true;
+				if(cursor.read(track_map_, 160) == 160) {
+					has_tmap = true;
+				}
 			} break;
 
 			case CK("TRKS"): {
-				tracks_offset_ = file_.tell();
+				tracks_offset_ = cursor.tell();
 			} break;
 
 			// TODO: parse META chunks.
@@ -78,7 +76,9 @@ WOZ::WOZ(const std::string &file_name) :
 		}
 		#undef CK
 
-		file_.seek(end_of_chunk, SEEK_SET);
+		// Stop if the chunk claims to extend beyond the end of the file.
+		cursor.seek(end_of_chunk, SEEK_SET);
+		if(cursor.tell() != end_of_chunk) break;
 	}
 
 	if(tracks_offset_ == -1 || !has_tmap) throw Error::InvalidFormat;
@@ -106,25 +106,27 @@ std::shared_ptr<Track> WOZ::get_track_at_position(Track::Address address) {
 	long offset = file_offset(address);
 	if(offset == NoSuchTrack) return nullptr;
 
-	// Seek to the real track.
-	std::vector<uint8_t> track_contents;
-	size_t number_of_bits;
-	{
-		std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
-		file_.seek(offset, SEEK_SET);
-
-		// In WOZ a track is up to 6646 bytes of data, followed by a two-byte record of the
-		// number of bytes that actually had data in them, then a two-byte count of the number
-		// of bits that were used. Other information follows but is not intended for emulation.
-		track_contents = file_.read(6646);
-		file_.seek(2, SEEK_CUR);
-		number_of_bits = std::min(file_.get16le(), uint16_t(6646*8));
-	}
+	// In WOZ a track is up to 6646 bytes of data, followed by a two-byte record of the
+	// number of bytes that actually had data in them, then a two-byte count of the number
+	// of bits that were used. Other information follows but is not intended for emulation.
+	std::lock_guard<std::mutex> lock_guard(file_.get_file_access_mutex());
+	FileHolder::Cursor cursor = file_.cursor();
+	cursor.seek(offset, SEEK_SET);
+
+	const FileHolder::Span track_contents = cursor.read(6646);
+	cursor.seek(2, SEEK_CUR);
+	const size_t number_of_bits = std::min(size_t(cursor.get16le()), track_contents.size() * 8);
 
-	return std::make_shared<PCMTrack>(PCMSegment(number_of_bits, track_contents));
+	return std::make_shared<PCMTrack>(PCMSegment(number_of_bits, track_contents.data()));
 }
 
 void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
+	// Take a copy of all data that contributes to the CRC, to be patched and then written back.
+	if(post_crc_contents_.empty()) {
+		const auto contents = file_.contents().subspan(12);
+		post_crc_contents_.assign(contents.begin(), contents.end());
+	}
+
 	for(const auto &pair: tracks) {
 		// Decode the track and store, patching into the post_crc_contents_.
 		auto segment = Storage::Disk::track_serialisation(*pair.second, Storage::Time(1, 50000));
@@ -152,6 +154,7 @@ void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tra
 	file_.seek(8, SEEK_SET);
 	file_.put_le(crc);
 	file_.write(post_crc_contents_);
+	file_.flush();
 }
 
 bool WOZ::get_is_read_only() {
@@ -39,7 +39,7 @@ class WOZ: public DiskImage {
 		uint8_t track_map_[160];
 		long tracks_offset_ = -1;
 
-		std::vector<uint8_t> post_crc_contents_;
+		std::vector<uint8_t> post_crc_contents_;	// Populated upon the first write.
 		CRC::CRC32 crc_generator;
 
 		/*!
@@ -24,6 +24,12 @@ Drive::Drive(int input_clock_rate, int revolutions_per_minute, int number_of_hea
 	ready_type_(rdy_type) {
 	set_rotation_speed(revolutions_per_minute);
 
+	// Noise consists of flux transitions two or three microseconds apart, and begins after
+	// a period of 15µs without any genuine flux transitions.
+	noise_cycles_[0] = std::max(Cycles::IntType(1), (get_input_clock_rate() * 2) / 1000000);
+	noise_cycles_[1] = std::max(Cycles::IntType(1), (get_input_clock_rate() * 3) / 1000000);
+	safe_gain_cycles_ = std::max(Cycles::IntType(1), (get_input_clock_rate() * 15) / 1000000);
+
 	const auto seed = std::default_random_engine::result_type(std::chrono::system_clock::now().time_since_epoch().count());
 	std::default_random_engine randomiser(seed);
 
@@ -40,13 +46,11 @@ Drive::Drive(int input_clock_rate, int number_of_heads, ReadyType rdy_type) : Dr
 
 void Drive::set_rotation_speed(float revolutions_per_minute) {
 	// Rationalise the supplied speed so that cycles_per_revolution_ is exact.
-	cycles_per_revolution_ = int(0.5f + float(get_input_clock_rate()) * 60.0f / revolutions_per_minute);
+	const int new_cycles_per_revolution = int(0.5f + float(get_input_clock_rate()) * 60.0f / revolutions_per_minute);
 
-	// From there derive the appropriate rotational multiplier and possibly update the
-	// count of cycles since the index hole proportionally.
-	const float new_rotational_multiplier = float(cycles_per_revolution_) / float(get_input_clock_rate());
-	cycles_since_index_hole_ = Cycles::IntType(float(cycles_since_index_hole_) * new_rotational_multiplier / rotational_multiplier_);
-	rotational_multiplier_ = new_rotational_multiplier;
+	// Update the count of cycles since the index hole proportionally.
+	cycles_since_index_hole_ = (cycles_since_index_hole_ * new_cycles_per_revolution) / cycles_per_revolution_;
+	cycles_per_revolution_ = new_cycles_per_revolution;
 	cycles_since_index_hole_ %= cycles_per_revolution_;
 }
 
@@ -135,13 +139,12 @@ bool Drive::get_tachometer() const {
 }
 
 float Drive::get_rotation() const {
-	return get_time_into_track();
+	return get_time_into_track().get<float>();
 }
 
-float Drive::get_time_into_track() const {
-	// i.e. amount of time since the index hole was seen, as a proportion of a second,
-	// converted to a proportion of a rotation.
-	return float(cycles_since_index_hole_) / (float(get_input_clock_rate()) * rotational_multiplier_);
+Storage::Time Drive::get_time_into_track() const {
+	// i.e. amount of time since the index hole was seen, as a proportion of a rotation.
+	return Time(unsigned(cycles_since_index_hole_), unsigned(cycles_per_revolution_));
 }
 
 bool Drive::get_is_read_only() const {
@@ -249,65 +252,77 @@ void Drive::run_for(const Cycles cycles) {
 
 // MARK: - Track timed event loop
 
-void Drive::get_next_event(float duration_already_passed) {
+void Drive::get_next_event(Time duration_already_passed) {
 	if(!disk_) {
 		current_event_.type = Track::Event::IndexHole;
-		current_event_.length = 1.0f;
-		set_next_event_time_interval((current_event_.length - duration_already_passed) * rotational_multiplier_);
+		current_event_.length.set_one();
+		set_next_track_interval(current_event_.length, duration_already_passed);
 		return;
 	}
 
 	// Grab a new track if not already in possession of one. This will recursively call get_next_event,
 	// supplying a proper duration_already_passed.
 	if(!track_) {
-		random_interval_ = 0.0f;
+		random_interval_ = 0;
 		setup_track();
 		return;
 	}
 
 	// If gain has now been turned up so as to generate noise, generate some noise.
-	if(random_interval_ > 0.0f) {
+	if(random_interval_) {
 		current_event_.type = Track::Event::FluxTransition;
-		current_event_.length = float(2 + (random_source_&1)) / 1000000.0f;
+		const Cycles::IntType noise_cycles = noise_cycles_[random_source_&1];
 		random_source_ = (random_source_ >> 1) | (random_source_ << 63);
 
-		if(random_interval_ < current_event_.length) {
-			current_event_.length = random_interval_;
-			random_interval_ = 0.0f;
+		// Noise is timed using the same denominator as the gap it fills, so that the
+		// final event falls exactly where the next real one would.
+		uint64_t interval = uint64_t(noise_cycles) * random_denominator_;
+		if(random_interval_ < interval) {
+			interval = random_interval_;
+			random_interval_ = 0;
 		} else {
-			random_interval_ -= current_event_.length;
+			random_interval_ -= interval;
 		}
-		set_next_event_time_interval(current_event_.length);
+		current_event_.length = Time(unsigned(noise_cycles), unsigned(cycles_per_revolution_));
+		set_next_event_cycle_interval(interval, random_denominator_);
 		return;
 	}
 
-	if(track_) {
-		const auto track_event = track_->get_next_event();
-		current_event_.type = track_event.type;
-		current_event_.length = track_event.length.get<float>();
-	} else {
-		current_event_.length = 1.0f;
-		current_event_.type = Track::Event::IndexHole;
-	}
+	const auto track_event = track_->get_next_event();
+	current_event_.type = track_event.type;
+	current_event_.length = track_event.length;
 
 	// Begin a 2ms period of holding the index line pulse active if this is an index pulse event.
 	if(current_event_.type == Track::Event::IndexHole) {
 		index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
 	}
 
-	// divide interval, which is in terms of a single rotation of the disk, by rotation speed to
-	// convert it into revolutions per second; this is achieved by multiplying by rotational_multiplier_
-	float interval = std::max((current_event_.length - duration_already_passed) * rotational_multiplier_, 0.0f);
+	set_next_track_interval(current_event_.length, duration_already_passed);
+}
+
+void Drive::set_next_track_interval(Time length, Time duration_already_passed) {
+	// Intervals are in terms of a single rotation of the disk, so multiply by the number of cycles
+	// per revolution to convert to cycles.
+	uint64_t numerator = 0;
+	uint32_t denominator = length.clock_rate;
+	if(!duration_already_passed.length) {
+		numerator = uint64_t(length.length) * uint64_t(cycles_per_revolution_);
+	} else if(duration_already_passed < length) {
+		const Time remainder = length - duration_already_passed;
+		numerator = uint64_t(remainder.length) * uint64_t(cycles_per_revolution_);
+		denominator = remainder.clock_rate;
+	}
 
 	// An interval greater than 15ms => adjust gain up the point where noise starts happening.
 	// Seed that up and leave a 15ms gap until it starts.
-	constexpr float safe_gain_period = 15.0f / 1000000.0f;
-	if(interval >= safe_gain_period) {
-		random_interval_ = interval - safe_gain_period;
-		interval = safe_gain_period;
+	const uint64_t safe_gain_period = uint64_t(safe_gain_cycles_) * denominator;
+	if(numerator >= safe_gain_period) {
+		random_interval_ = numerator - safe_gain_period;
+		random_denominator_ = denominator;
+		numerator = safe_gain_period;
 	}
 
-	set_next_event_time_interval(interval);
+	set_next_event_cycle_interval(numerator, denominator);
 }
 
 void Drive::process_next_event() {
@@ -324,7 +339,7 @@ void Drive::process_next_event() {
 	){
 		event_delegate_->process_event(current_event_);
 	}
-	get_next_event(0.0f);
+	get_next_event(Time());
 }
 
 // MARK: - Track management
@@ -344,24 +359,28 @@ void Drive::setup_track() {
 		track_ = std::make_shared<UnformattedTrack>();
 	}
 
-	float offset = 0.0f;
-	const auto track_time_now = get_time_into_track();
-	const auto time_found = track_->seek_to(Time(track_time_now)).get<float>();
+	Time offset;
+	const Time track_time_now = get_time_into_track();
+	const Time time_found = track_->seek_to(track_time_now);
 
 	// `time_found` can be greater than `track_time_now` if limited precision caused rounding.
+	Time position = time_found;
 	if(time_found <= track_time_now) {
 		offset = track_time_now - time_found;
+		position = track_time_now;
 	}
 
 	// Reseed cycles_since_index_hole_; 99.99% of the time it'll still be correct as is,
 	// but if the track has rounded one way or the other it may now be very slightly adrift.
-	cycles_since_index_hole_ = (int((time_found + offset) * cycles_per_revolution_)) % cycles_per_revolution_;
+	cycles_since_index_hole_ = Cycles::IntType(
+		(uint64_t(position.length) * uint64_t(cycles_per_revolution_)) / position.clock_rate
+	) % cycles_per_revolution_;
 
 	get_next_event(offset);
 }
 
 void Drive::invalidate_track() {
-	random_interval_ = 0.0f;
+	random_interval_ = 0;
 	track_ = nullptr;
 	if(patched_track_) {
 		set_track(patched_track_);
@@ -388,10 +407,11 @@ void Drive::begin_writing(Time bit_length, bool clamp_to_index_hole) {
 	cycles_per_bit_ = Storage::Time(int(get_input_clock_rate())) * bit_length;
 	cycles_per_bit_.simplify();
 
-	write_segment_.length_of_a_bit = bit_length / Time(rotational_multiplier_);
+	// Convert from seconds to a proportion of a rotation.
+	write_segment_.length_of_a_bit = bit_length * Time(unsigned(get_input_clock_rate()), unsigned(cycles_per_revolution_));
 	write_segment_.data.clear();
 
-	write_start_time_ = Time(get_time_into_track());
+	write_start_time_ = get_time_into_track();
 }
 
 void Drive::write_bit(bool value) {
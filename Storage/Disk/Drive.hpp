@@ -127,7 +127,7 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 		struct Event {
 			Track::Event::Type type;
-			float length = 0.0f;
+			Time length;
 		} current_event_;
 
 		/*!
@@ -203,10 +203,6 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		std::shared_ptr<Track> track_;
 		bool has_disk_ = false;
 
-		// Contains the multiplier that converts between track-relative lengths
-		// to real-time lengths. So it's the reciprocal of rotation speed.
-		float rotational_multiplier_ = 1.0f;
-
 		// A count of time since the index hole was last seen. Which is used to
 		// determine how far the drive is into a full rotation when switching to
 		// a new track.
@@ -253,11 +249,12 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 		// TimedEventLoop call-ins and state.
 		void process_next_event() override;
-		void get_next_event(float duration_already_passed);
+		void get_next_event(Time duration_already_passed);
+		void set_next_track_interval(Time length, Time duration_already_passed);
 		void advance(const Cycles cycles) override;
 
 		// Helper for track changes.
-		float get_time_into_track() const;
+		Time get_time_into_track() const;
 
 		// The target (if any) for track events.
 		EventDelegate *event_delegate_ = nullptr;
@@ -282,7 +279,14 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 		// A rotating random data source.
 		uint64_t random_source_;
-		float random_interval_;
+
+		// The remaining period of noise, as random_interval_ / random_denominator_ cycles.
+		uint64_t random_interval_ = 0;
+		uint32_t random_denominator_ = 1;
+
+		// Noise periods and the delay before noise begins, in cycles.
+		Cycles::IntType noise_cycles_[2];
+		Cycles::IntType safe_gain_cycles_;
 };
 
 
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "Sector.hpp"
+#include "../../Track/PCMSegment.hpp"
 #include "../../Track/Track.hpp"
 #include "../../../../Numeric/CRC.hpp"
 
@@ -44,9 +45,9 @@ std::shared_ptr<Storage::Disk::Track> GetFMTrackWithSectors(const std::vector<co
 
 class Encoder {
 	public:
-		Encoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target);
+		Encoder(Storage::Disk::PCMBits &target, Storage::Disk::PCMBits *fuzzy_target);
 		virtual ~Encoder() {}
-		virtual void reset_target(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
+		virtual void reset_target(Storage::Disk::PCMBits &target, Storage::Disk::PCMBits *fuzzy_target = nullptr);
 
 		virtual void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) = 0;
 		virtual void add_index_address_mark() = 0;
@@ -62,12 +63,12 @@ class Encoder {
 		CRC::CCITT crc_generator_;
 
 	private:
-		std::vector<bool> *target_ = nullptr;
-		std::vector<bool> *fuzzy_target_ = nullptr;
+		Storage::Disk::PCMBits *target_ = nullptr;
+		Storage::Disk::PCMBits *fuzzy_target_ = nullptr;
 };
 
-std::unique_ptr<Encoder> GetMFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
-std::unique_ptr<Encoder> GetFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
+std::unique_ptr<Encoder> GetMFMEncoder(Storage::Disk::PCMBits &target, Storage::Disk::PCMBits *fuzzy_target = nullptr);
+std::unique_ptr<Encoder> GetFMEncoder(Storage::Disk::PCMBits &target, Storage::Disk::PCMBits *fuzzy_target = nullptr);
 
 }
 }
@@ -8,6 +8,7 @@
 
 #include "PCMSegment.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
@@ -47,29 +48,73 @@ void PCMSegmentEventSource::reset() {
 }
 
 PCMSegment &PCMSegment::operator +=(const PCMSegment &rhs) {
-	data.insert(data.end(), rhs.data.begin(), rhs.data.end());
+	data.append(rhs.data, 0, rhs.data.size());
 	return *this;
 }
 
 void PCMSegment::rotate_right(size_t length) {
-	length %= data.size();
-	if(!length) return;
+	data.rotate_right(length);
+}
 
-	// To rotate to the right, front-insert the proper number
-	// of bits from the end and then resize. To rotate to
-	// the left, do the opposite.
-	std::vector<uint8_t> data_copy;
-	if(length > 0) {
-		data_copy.insert(data_copy.end(), data.end() - off_t(length), data.end());
-		data.erase(data.end() - off_t(length), data.end());
-		data.insert(data.begin(), data_copy.begin(), data_copy.end());
-	} else {
-		data_copy.insert(data_copy.end(), data.begin(), data.begin() - off_t(length));
-		data.erase(data.begin(), data.begin() - off_t(length));
-		data.insert(data.end(), data_copy.begin(), data_copy.end());
+// MARK: - PCMBits.
+
+void PCMBits::resize(size_t size, bool value) {
+	if(size <= size_) {
+		// Truncate, ensuring that all bits beyond the new end are clear.
+		words_.resize((size + 63) >> 6);
+		size_ = size;
+		if(size_ & 63) {
+			words_.back() &= ~uint64_t(0) << (64 - (size_ & 63));
+		}
+		return;
 	}
+
+	const uint64_t fill = value ? ~uint64_t(0) : 0;
+	reserve(size);
+	while(size - size_ >= 64) {
+		append(fill, 64);
+	}
+	append(fill, int(size - size_));
 }
 
+void PCMBits::fill(size_t begin, size_t end, bool value) {
+	if(begin >= end) return;
+
+	const auto apply = [this, value] (size_t word, uint64_t mask) {
+		if(value) words_[word] |= mask;
+		else words_[word] &= ~mask;
+	};
+
+	// Masks are of the bits from the start position to the end of the word,
+	// and from the start of the word to just before the end position.
+	const size_t first_word = begin >> 6, last_word = (end - 1) >> 6;
+	const uint64_t first_mask = ~uint64_t(0) >> (begin & 63);
+	const uint64_t last_mask = ~uint64_t(0) << (63 - ((end - 1) & 63));
+
+	if(first_word == last_word) {
+		apply(first_word, first_mask & last_mask);
+		return;
+	}
+
+	apply(first_word, first_mask);
+	std::fill(words_.begin() + ptrdiff_t(first_word + 1), words_.begin() + ptrdiff_t(last_word), value ? ~uint64_t(0) : 0);
+	apply(last_word, last_mask);
+}
+
+void PCMBits::rotate_right(size_t length) {
+	if(!size_) return;
+	length %= size_;
+	if(!length) return;
+
+	PCMBits result;
+	result.reserve(size_);
+	result.append(*this, size_ - length, size_);
+	result.append(*this, 0, size_ - length);
+	*this = std::move(result);
+}
+
+// MARK: - PCMSegmentEventSource.
+
 Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// Track the initial bit pointer for potentially considering whether this was an
 	// initial index hole or a subsequent one later on.
@@ -79,16 +124,28 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// is set, it should be in the centre of its window.
 	next_event_.length.length = bit_pointer_ ? 0 : -(segment_->length_of_a_bit.length >> 1);
 
-	// search for the next bit that is set, if any
-	while(bit_pointer_ < segment_->data.size()) {
-		bool bit = segment_->data[bit_pointer_];
-		++bit_pointer_;	// so this always points one beyond the most recent bit returned
-		next_event_.length.length += segment_->length_of_a_bit.length;
-
-		// if this bit is set, or is fuzzy and a random bit of 1 is selected, return the event.
-		if(bit ||
-			(!segment_->fuzzy_mask.empty() && segment_->fuzzy_mask[bit_pointer_] && lfsr_.next())
-		)	return next_event_;
+	// Search for the next bit that is set, if any; a bit that is fuzzy and not set is
+	// treated as set if a random bit of 1 is selected.
+	const PCMBits &data = segment_->data;
+	const PCMBits &fuzzy_mask = segment_->fuzzy_mask;
+	if(bit_pointer_ < data.size()) {
+		size_t next_bit = data.next_set_bit(bit_pointer_);
+
+		size_t fuzzy_bit = fuzzy_mask.next_set_bit(bit_pointer_);
+		while(fuzzy_bit < fuzzy_mask.size() && fuzzy_bit < next_bit) {
+			if(lfsr_.next()) {
+				next_bit = fuzzy_bit;
+				break;
+			}
+			fuzzy_bit = fuzzy_mask.next_set_bit(fuzzy_bit + 1);
+		}
+
+		// Advance to the bit found, or to the end of the data if none was.
+		const size_t end_bit = std::min(next_bit + 1, data.size());
+		next_event_.length.length += unsigned(end_bit - bit_pointer_) * segment_->length_of_a_bit.length;
+		bit_pointer_ = end_bit;	// so this always points one beyond the most recent bit returned
+
+		if(next_bit < data.size()) return next_event_;
 	}
 
 	// If the end is reached without a bit being set, it'll be index holes from now on.
@@ -9,6 +9,7 @@
 #ifndef PCMSegment_hpp
 #define PCMSegment_hpp
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -20,6 +21,207 @@
 namespace Storage {
 namespace Disk {
 
+/*!
+	A packed sequence of bits, stored most-significant first in 64-bit words.
+
+	This provides the subset of the std::vector<bool> interface that users of PCMSegment
+	require, plus word-at-a-time searching, copying and filling. All bits beyond the end
+	of the sequence within the final word are always zero.
+*/
+class PCMBits {
+	public:
+		PCMBits() = default;
+		PCMBits(size_t size, bool value = false) {
+			resize(size, value);
+		}
+
+		size_t size() const {
+			return size_;
+		}
+
+		bool empty() const {
+			return !size_;
+		}
+
+		void clear() {
+			words_.clear();
+			size_ = 0;
+		}
+
+		void reserve(size_t size) {
+			words_.reserve((size + 63) >> 6);
+		}
+
+		/// Resizes to @c size bits; if this is an extension, the new bits are @c value.
+		void resize(size_t size, bool value = false);
+
+		bool operator[](size_t index) const {
+			return (words_[index >> 6] >> (63 - (index & 63))) & 1;
+		}
+
+		bool back() const {
+			return (*this)[size_ - 1];
+		}
+
+		/// A proxy for a single, writeable bit.
+		class reference {
+			public:
+				operator bool() const {
+					return word_ & mask_;
+				}
+
+				reference &operator =(bool value) {
+					if(value) word_ |= mask_;
+					else word_ &= ~mask_;
+					return *this;
+				}
+
+				reference &operator =(const reference &rhs) {
+					return *this = bool(rhs);
+				}
+
+			private:
+				reference(uint64_t &word, uint64_t mask) : word_(word), mask_(mask) {}
+				uint64_t &word_;
+				const uint64_t mask_;
+				friend class PCMBits;
+		};
+
+		reference operator[](size_t index) {
+			return reference(words_[index >> 6], uint64_t(1) << (63 - (index & 63)));
+		}
+
+		void push_back(bool bit) {
+			if(!(size_ & 63)) words_.push_back(0);
+			if(bit) words_.back() |= uint64_t(1) << (63 - (size_ & 63));
+			++size_;
+		}
+
+		/// Appends the most significant @c count bits of @c value, with @c count being at most 64.
+		void append(uint64_t value, int count) {
+			if(!count) return;
+			value &= ~uint64_t(0) << (64 - count);
+
+			const int offset = int(size_ & 63);
+			if(!offset) {
+				words_.push_back(value);
+			} else {
+				words_.back() |= value >> offset;
+				if(offset + count > 64) words_.push_back(value << (64 - offset));
+			}
+			size_ += size_t(count);
+		}
+
+		/// Appends the bits in the range [@c begin, @c end) of @c source.
+		void append(const PCMBits &source, size_t begin, size_t end) {
+			reserve(size_ + end - begin);
+			while(begin + 64 <= end) {
+				append(source.word_at(begin), 64);
+				begin += 64;
+			}
+			if(begin < end) append(source.word_at(begin), int(end - begin));
+		}
+
+		/// @returns The 64 bits starting from @c index, most significant first; bits beyond the end are zero.
+		uint64_t word_at(size_t index) const {
+			const size_t word = index >> 6;
+			const int shift = int(index & 63);
+
+			uint64_t result = words_[word] << shift;
+			if(shift && word + 1 < words_.size()) {
+				result |= words_[word + 1] >> (64 - shift);
+			}
+			return result;
+		}
+
+		/// Sets all bits in the range [@c begin, @c end) to @c value.
+		void fill(size_t begin, size_t end, bool value);
+
+		/// @returns The index of the first set bit at or after @c index, or @c size() if there is none.
+		size_t next_set_bit(size_t index) const {
+			if(index >= size_) return size_;
+
+			size_t word = index >> 6;
+			uint64_t bits = words_[word] & (~uint64_t(0) >> (index & 63));
+			while(!bits) {
+				++word;
+				if(word == words_.size()) return size_;
+				bits = words_[word];
+			}
+
+			// As bits beyond the end are zero, this is necessarily less than size_.
+			return (word << 6) + size_t(count_leading_zeroes(bits));
+		}
+
+		/// Rotates all bits to the right by @c length, i.e. moves the final @c length to the front.
+		void rotate_right(size_t length);
+
+		/// Provides read-only iteration, for range-based for loops.
+		class const_iterator {
+			public:
+				bool operator *() const {
+					return (*bits_)[index_];
+				}
+
+				const_iterator &operator ++() {
+					++index_;
+					return *this;
+				}
+
+				bool operator ==(const const_iterator &rhs) const {
+					return index_ == rhs.index_;
+				}
+
+				bool operator !=(const const_iterator &rhs) const {
+					return index_ != rhs.index_;
+				}
+
+			private:
+				const_iterator(const PCMBits *bits, size_t index) : bits_(bits), index_(index) {}
+				const PCMBits *bits_;
+				size_t index_;
+				friend class PCMBits;
+		};
+
+		const_iterator begin() const {
+			return const_iterator(this, 0);
+		}
+
+		const_iterator end() const {
+			return const_iterator(this, size_);
+		}
+
+		bool operator ==(const PCMBits &rhs) const {
+			return size_ == rhs.size_ && words_ == rhs.words_;
+		}
+
+		bool operator !=(const PCMBits &rhs) const {
+			return !(*this == rhs);
+		}
+
+		/// @returns The underlying storage, i.e. @c size() bits packed most significant first.
+		const std::vector<uint64_t> &words() const {
+			return words_;
+		}
+
+	private:
+		std::vector<uint64_t> words_;
+		size_t size_ = 0;
+
+		static int count_leading_zeroes(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(value);
+#else
+			int result = 0;
+			while(!(value & 0x8000'0000'0000'0000)) {
+				value <<= 1;
+				++result;
+			}
+			return result;
+#endif
+		}
+};
+
 /*!
 	A segment of PCM-sampled data.
 */
@@ -31,27 +233,26 @@ struct PCMSegment {
 	Time length_of_a_bit = Time(1);
 
 	/*!
-		This is the actual data, taking advantage of the std::vector<bool>
-		specialisation to use whatever one-bit-per-value encoding is
-		most suited to this architecture.
+		This is the actual data, packed one bit per window.
 
 		If a value is @c true then a flux transition occurs in that window.
 		If it is @c false then no flux transition occurs.
 	*/
-	std::vector<bool> data;
+	PCMBits data;
 
 	/*!
 		If a segment has a fuzzy mask then anywhere the mask has a value
 		of @c true, a random bit will be ORd onto whatever is in the
-		corresponding slot in @c data.
+		corresponding slot in @c data. The mask may be shorter than @c data,
+		in which case the bits beyond its end are not fuzzy.
 	*/
-	std::vector<bool> fuzzy_mask;
+	PCMBits fuzzy_mask;
 
 	/*!
 		Constructs an instance of PCMSegment with the specified @c length_of_a_bit
 		and @c data.
 	*/
-	PCMSegment(Time length_of_a_bit, const std::vector<bool> &data)
+	PCMSegment(Time length_of_a_bit, const PCMBits &data)
 		: length_of_a_bit(length_of_a_bit), data(data) {}
 
 	/*!
@@ -59,12 +260,25 @@ struct PCMSegment {
 		long and @c data is populated from the supplied @c source by serialising it
 		from MSB to LSB for @c number_of_bits.
 	*/
-	PCMSegment(size_t number_of_bits, const uint8_t *source)
-		: data(number_of_bits, false) {
-		for(size_t c = 0; c < number_of_bits; ++c) {
-			if((source[c >> 3] >> (7 ^ (c & 7)))&1) {
-				data[c] = true;
+	PCMSegment(size_t number_of_bits, const uint8_t *source) {
+		data.reserve(number_of_bits);
+
+		// Assemble whole words where possible; then finish byte by byte.
+		size_t byte = 0;
+		while(number_of_bits >= 64) {
+			uint64_t word = 0;
+			for(int c = 0; c < 8; ++c) {
+				word = (word << 8) | source[byte + size_t(c)];
 			}
+			data.append(word, 64);
+			byte += 8;
+			number_of_bits -= 64;
+		}
+		while(number_of_bits) {
+			const int count = int(std::min(number_of_bits, size_t(8)));
+			data.append(uint64_t(source[byte]) << 56, count);
+			++byte;
+			number_of_bits -= size_t(count);
 		}
 	}
 
@@ -131,11 +345,14 @@ struct PCMSegment {
 	*/
 	std::vector<uint8_t> byte_data(bool msb_first = true) const {
 		std::vector<uint8_t> bytes((data.size() + 7) >> 3);
-		size_t pointer = 0;
-		const size_t pointer_mask = msb_first ? 7 : 0;
-		for(const auto bit: data) {
-			if(bit) bytes[pointer >> 3] |= 1 << ((pointer & 7) ^ pointer_mask);
-			++pointer;
+		const auto &words = data.words();
+		for(size_t c = 0; c < bytes.size(); ++c) {
+			uint8_t byte = uint8_t(words[c >> 3] >> (56 - ((c & 7) << 3)));
+			if(!msb_first) {
+				// Reverse the order of bits within the byte.
+				byte = uint8_t(((byte * 0x0802u & 0x22110u) | (byte * 0x8020u & 0x88440u)) * 0x10101u >> 16);
+			}
+			bytes[c] = byte;
 		}
 		return bytes;
 	}
@@ -164,15 +164,14 @@ void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bo
 		const size_t selected_end_bit = std::min(end_bit, destination.data.size());
 
 		// Reset the destination.
-		std::fill(destination.data.begin() + off_t(start_bit), destination.data.begin() + off_t(selected_end_bit), false);
-
-		// Step through the source data from start to finish, stopping early if it goes out of bounds.
-		for(size_t bit = 0; bit < segment.data.size(); ++bit) {
-			if(segment.data[bit]) {
-				const size_t output_bit = start_bit + half_offset + (bit * target_width) / segment.data.size();
-				if(output_bit >= destination.data.size()) return;
-				destination.data[output_bit] = true;
-			}
+		destination.data.fill(start_bit, selected_end_bit, false);
+
+		// Step through the source's flux transitions from start to finish, stopping early if they go out of bounds.
+		const size_t source_size = segment.data.size();
+		for(size_t bit = segment.data.next_set_bit(0); bit < source_size; bit = segment.data.next_set_bit(bit + 1)) {
+			const size_t output_bit = start_bit + half_offset + (bit * target_width) / source_size;
+			if(output_bit >= destination.data.size()) return;
+			destination.data[output_bit] = true;
 		}
 	} else {
 		// Clamping is not enabled, so the supplied segment loops over the index hole, arbitrarily many times.
@@ -181,23 +180,22 @@ void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bo
 		// This definitely runs over the index hole; check whether the whole track needs clearing, or whether
 		// a centre segment is untouched.
 		if(target_width >= destination.data.size()) {
-			std::fill(destination.data.begin(), destination.data.end(), false);
+			destination.data.fill(0, destination.data.size(), false);
 		} else {
-			std::fill(destination.data.begin(), destination.data.begin() + off_t(end_bit % destination.data.size()), false);
-			std::fill(destination.data.begin() + off_t(start_bit), destination.data.end(), false);
+			destination.data.fill(0, end_bit % destination.data.size(), false);
+			destination.data.fill(start_bit, destination.data.size(), false);
 		}
 
-		// Run backwards from final bit back to first, stopping early if overlapping the beginning.
-		for(off_t bit = off_t(segment.data.size()-1); bit >= 0; --bit) {
-			// Store flux transitions only; non-transitions can be ignored.
-			if(segment.data[size_t(bit)]) {
-				// Map to the proper output destination; stop if now potentially overwriting where we began.
-				const size_t output_bit = start_bit + half_offset + (size_t(bit) * target_width) / segment.data.size();
-				if(output_bit < end_bit - destination.data.size()) return;
+		// Step through the source's flux transitions, ignoring any that would land before the
+		// final end position less a whole track, as those are overwritten by later data.
+		const size_t source_size = segment.data.size();
+		for(size_t bit = segment.data.next_set_bit(0); bit < source_size; bit = segment.data.next_set_bit(bit + 1)) {
+			// Map to the proper output destination.
+			const size_t output_bit = start_bit + half_offset + (bit * target_width) / source_size;
+			if(output_bit < end_bit - destination.data.size()) continue;
 
-				// Store.
-				destination.data[output_bit % destination.data.size()] = true;
-			}
+			// Store.
+			destination.data[output_bit % destination.data.size()] = true;
 		}
 	}
 }
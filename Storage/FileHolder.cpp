@@ -11,9 +11,17 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define HAS_MMAP
+#endif
+
 using namespace Storage;
 
 FileHolder::~FileHolder() {
+#ifdef HAS_MMAP
+	if(mapping_) munmap(mapping_, mapping_size_);
+#endif
 	if(file_) std::fclose(file_);
 }
 
@@ -146,7 +154,60 @@ bool FileHolder::eof() {
 }
 
 FileHolder::BitStream FileHolder::get_bitstream(bool lsb_first) {
-	return BitStream(file_, lsb_first);
+	return BitStream(file_, nullptr, lsb_first);
+}
+
+uint8_t FileHolder::BitStream::get_bit() {
+	if(!bits_remaining_) {
+		bits_remaining_ = 8;
+		next_value_ = cursor_ ? cursor_->get8() : uint8_t(fgetc(file_));
+	}
+
+	uint8_t bit;
+	if(lsb_first_) {
+		bit = next_value_ & 1;
+		next_value_ >>= 1;
+	} else {
+		bit = next_value_ >> 7;
+		next_value_ <<= 1;
+	}
+
+	bits_remaining_--;
+
+	return bit;
+}
+
+FileHolder::Span FileHolder::contents() {
+	if(!has_contents_) {
+		has_contents_ = true;
+
+		// Use the file's current length rather than that captured at construction, in case it has since been extended.
+		std::fflush(file_);
+		const long position = std::ftell(file_);
+		std::fseek(file_, 0, SEEK_END);
+		const long length = std::ftell(file_);
+		std::fseek(file_, position, SEEK_SET);
+		if(length <= 0) return Span();
+
+#ifdef HAS_MMAP
+		void *const mapping = mmap(nullptr, size_t(length), PROT_READ, MAP_SHARED, fileno(file_), 0);
+		if(mapping != MAP_FAILED) {
+			mapping_ = mapping;
+			mapping_size_ = size_t(length);
+		}
+#endif
+
+		// Fall back on reading the whole file if it couldn't be mapped.
+		if(!mapping_) {
+			contents_.resize(size_t(length));
+			std::fseek(file_, 0, SEEK_SET);
+			contents_.resize(std::fread(contents_.data(), 1, contents_.size(), file_));
+			std::fseek(file_, position, SEEK_SET);
+		}
+	}
+
+	if(mapping_) return Span(static_cast<const uint8_t *>(mapping_), mapping_size_);
+	return Span(contents_);
 }
 
 bool FileHolder::check_signature(const char *signature, std::size_t length) {
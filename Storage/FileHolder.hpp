@@ -10,9 +10,11 @@
 #define FileHolder_hpp
 
 #include <sys/stat.h>
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <cstdint>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -153,6 +155,41 @@ class FileHolder final {
 		/*! @returns @c true if the end-of-file indicator is set, @c false otherwise. */
 		bool eof();
 
+		/*!
+			A read-only view of a contiguous run of bytes, usually obtained via @c contents.
+		*/
+		class Span {
+			public:
+				Span() {}
+				Span(const uint8_t *data, std::size_t size) : data_(data), size_(size) {}
+				Span(const std::vector<uint8_t> &data) : data_(data.data()), size_(data.size()) {}
+
+				const uint8_t *data() const	{	return data_;			}
+				std::size_t size() const	{	return size_;			}
+				bool empty() const			{	return !size_;			}
+
+				const uint8_t *begin() const	{	return data_;			}
+				const uint8_t *end() const		{	return data_ + size_;	}
+
+				uint8_t operator[](std::size_t index) const {
+					return data_[index];
+				}
+
+				/*!
+					@returns The span of up to @c length bytes from @c offset; this is
+					clamped to the bounds of this span, so may be shorter or empty.
+				*/
+				Span subspan(std::size_t offset, std::size_t length = SIZE_MAX) const {
+					if(offset >= size_) return Span();
+					return Span(data_ + offset, std::min(length, size_ - offset));
+				}
+
+			private:
+				const uint8_t *data_ = nullptr;
+				std::size_t size_ = 0;
+		};
+
+		class Cursor;
 		class BitStream {
 			public:
 				uint8_t get_bits(int q) {
@@ -164,37 +201,139 @@ class FileHolder final {
 				}
 
 			private:
-				BitStream(FILE *file, bool lsb_first) :
+				BitStream(FILE *file, Cursor *cursor, bool lsb_first) :
 					file_(file),
+					cursor_(cursor),
 					lsb_first_(lsb_first),
 					next_value_(0),
 					bits_remaining_(0) {}
 				friend FileHolder;
 
 				FILE *file_;
+				Cursor *cursor_;
 				bool lsb_first_;
 				uint8_t next_value_;
 				int bits_remaining_;
 
-				uint8_t get_bit() {
-					if(!bits_remaining_) {
-						bits_remaining_ = 8;
-						next_value_ = uint8_t(fgetc(file_));
+				uint8_t get_bit();
+		};
+
+		/*!
+			Reads from a Span with the same interface as a FileHolder, in place and with bounds checking:
+			reads beyond the end of the span produce 0xff bytes, or as many bytes as remain, and set the
+			end-of-file indicator exactly as a read beyond the end of a file would.
+		*/
+		class Cursor {
+			public:
+				Cursor() {}
+				Cursor(Span span) : span_(span) {}
+
+				uint8_t get8() {
+					if(position_ >= span_.size()) {
+						is_at_end_ = true;
+						return 0xff;
 					}
+					return span_[position_++];
+				}
+
+				uint16_t get16le() {
+					uint16_t result = get8();
+					return uint16_t(result | (get8() << 8));
+				}
+
+				uint16_t get16be() {
+					uint16_t result = uint16_t(get8() << 8);
+					return uint16_t(result | get8());
+				}
+
+				uint32_t get24le() {
+					uint32_t result = get16le();
+					return result | uint32_t(get8() << 16);
+				}
+
+				uint32_t get24be() {
+					uint32_t result = uint32_t(get16be()) << 8;
+					return result | get8();
+				}
+
+				uint32_t get32le() {
+					uint32_t result = get16le();
+					return result | (uint32_t(get16le()) << 16);
+				}
+
+				uint32_t get32be() {
+					uint32_t result = uint32_t(get16be()) << 16;
+					return result | get16be();
+				}
+
+				/*! @returns A span of the next @c size bytes, or of as many as remain if that is fewer. */
+				Span read(std::size_t size) {
+					const Span result = span_.subspan(position_, size);
+					position_ += result.size();
+					if(result.size() < size) is_at_end_ = true;
+					return result;
+				}
+
+				/*! Reads up to @c size bytes into @c buffer; @returns the number read. */
+				std::size_t read(uint8_t *buffer, std::size_t size) {
+					const Span source = read(size);
+					if(!source.empty()) std::memcpy(buffer, source.data(), source.size());
+					return source.size();
+				}
 
-					uint8_t bit;
-					if(lsb_first_) {
-						bit = next_value_ & 1;
-						next_value_ >>= 1;
-					} else {
-						bit = next_value_ >> 7;
-						next_value_ <<= 1;
+				/*! Reads @c a.size() bytes into @c a.data(). */
+				template <size_t size> std::size_t read(std::array<uint8_t, size> &a) {
+					return read(a.data(), a.size());
+				}
+
+				/*! Moves @c bytes from the anchor indicated by @c whence: SEEK_SET, SEEK_CUR or SEEK_END; the result is clamped to the span. */
+				void seek(long offset, int whence) {
+					long base = 0;
+					switch(whence) {
+						default:		break;
+						case SEEK_CUR:	base = long(position_);		break;
+						case SEEK_END:	base = long(span_.size());	break;
 					}
+					position_ = size_t(std::max(0l, std::min(long(span_.size()), base + offset)));
+					is_at_end_ = false;
+				}
 
-					bits_remaining_--;
+				/*! @returns The current cursor position. */
+				long tell() const {
+					return long(position_);
+				}
 
-					return bit;
+				/*! @returns @c true if the end-of-file indicator is set, @c false otherwise. */
+				bool eof() const {
+					return is_at_end_;
 				}
+
+				/*! @returns The number of bytes between the cursor and the end of the span. */
+				std::size_t remaining() const {
+					return span_.size() - position_;
+				}
+
+				/*! Obtains a BitStream for reading from the current cursor position. */
+				BitStream get_bitstream(bool lsb_first) {
+					return BitStream(nullptr, this, lsb_first);
+				}
+
+				/*!
+					Reads @c length bytes and compares them to the first @c length bytes of @c signature.
+					If @c length is 0, it is computed as the length of @c signature not including the terminating null.
+
+					@returns @c true if the bytes read match the signature; @c false otherwise.
+				*/
+				bool check_signature(const char *signature, std::size_t length = 0) {
+					if(!length) length = std::strlen(signature);
+					const Span stored_signature = read(length);
+					return stored_signature.size() == length && !std::memcmp(stored_signature.data(), signature, length);
+				}
+
+			private:
+				Span span_;
+				std::size_t position_ = 0;
+				bool is_at_end_ = false;
 		};
 
 		/*!
@@ -202,6 +341,21 @@ class FileHolder final {
 		*/
 		BitStream get_bitstream(bool lsb_first);
 
+		/*!
+			@returns The entire content of the file, which is memory mapped where possible so that it can be
+			parsed in place and, across processes, shares the page cache. The span remains valid for the lifetime
+			of the FileHolder, and reflects any subsequent changes made with @c write once they have been flushed,
+			but its length is fixed when it is first obtained. The first call is not thread safe.
+		*/
+		Span contents();
+
+		/*!
+			@returns A Cursor for reading @c contents().
+		*/
+		Cursor cursor() {
+			return Cursor(contents());
+		}
+
 		/*!
 			Reads @c length bytes from the file and compares them to the first
 			@c length bytes of @c signature. If @c length is 0, it is computed
@@ -246,6 +400,13 @@ class FileHolder final {
 		bool is_read_only_ = false;
 
 		std::mutex file_access_mutex_;
+
+		// Populated by contents(); either mapping_ is a mapping of the whole file,
+		// or the file has been read into contents_.
+		void *mapping_ = nullptr;
+		std::size_t mapping_size_ = 0;
+		std::vector<uint8_t> contents_;
+		bool has_contents_ = false;
 };
 
 }
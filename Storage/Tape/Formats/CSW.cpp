@@ -8,16 +8,15 @@
 
 #include "CSW.hpp"
 
-#include "../../FileHolder.hpp"
-
 #include <cassert>
 
 using namespace Storage::Tape;
 
 CSW::CSW(const std::string &file_name) :
+	file_(new Storage::FileHolder(file_name, Storage::FileHolder::FileMode::Read)),
 	source_data_pointer_(0) {
-	Storage::FileHolder file(file_name);
-	if(file.stats().st_size < 0x20) throw ErrorNotCSW;
+	Storage::FileHolder::Cursor file = file_->cursor();
+	if(file.remaining() < 0x20) throw ErrorNotCSW;
 
 	// Check signature.
 	if(!file.check_signature("Compressed Square Wave")) {
@@ -57,17 +56,27 @@ CSW::CSW(const std::string &file_name) :
 		pulse_.type = (file.get8() & 1) ? Pulse::High : Pulse::Low;
 		uint8_t extension_length = file.get8();
 
-		if(file.stats().st_size < 0x34 + extension_length) throw ErrorNotCSW;
+		file.seek(0, SEEK_END);
+		if(file.tell() < 0x34 + extension_length) throw ErrorNotCSW;
 		file.seek(0x34 + extension_length, SEEK_SET);
 	}
 
-	// Grab all data remaining in the file.
-	std::vector<uint8_t> file_data;
-	std::size_t remaining_data = size_t(file.stats().st_size) - size_t(file.tell());
-	file_data.resize(remaining_data);
-	file.read(file_data.data(), remaining_data);
+	// Use all data remaining in the file.
+	set_data(file.read(file.remaining()), compression_type_, number_of_waves);
+
+	invert_pulse();
+}
 
-	if(compression_type_ == CompressionType::ZRLE) {
+CSW::CSW(Storage::FileHolder::Span data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate, uint32_t number_of_waves) :
+	source_data_pointer_(0) {
+	pulse_.length.clock_rate = sampling_rate;
+	pulse_.type = initial_level ? Pulse::High : Pulse::Low;
+	compression_type_ = compression_type;
+	set_data(data, compression_type, number_of_waves);
+}
+
+void CSW::set_data(Storage::FileHolder::Span data, CompressionType compression_type, uint32_t number_of_waves) {
+	if(compression_type == CompressionType::ZRLE) {
 		// The only clue given by CSW as to the output size in bytes is that there will be
 		// number_of_waves waves. Waves are usually one byte, but may be five. So this code
 		// is pessimistic.
@@ -77,35 +86,28 @@ CSW::CSW(const std::string &file_name) :
 		// modification of output_length to throw away all the memory that isn't actually
 		// needed.
 		uLongf output_length = uLongf(number_of_waves * 5);
-		uncompress(source_data_.data(), &output_length, file_data.data(), file_data.size());
+		uncompress(source_data_.data(), &output_length, data.data(), uLong(data.size()));
 		source_data_.resize(std::size_t(output_length));
+		source_ = Storage::FileHolder::Span(source_data_);
 	} else {
-		source_data_ = std::move(file_data);
+		source_ = data;
 	}
-
-	invert_pulse();
-}
-
-CSW::CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) {
-	pulse_.length.clock_rate = sampling_rate;
-	pulse_.type = initial_level ? Pulse::High : Pulse::Low;
-	source_data_ = std::move(data);
 }
 
 uint8_t CSW::get_next_byte() {
-	if(source_data_pointer_ == source_data_.size()) return 0xff;
-	uint8_t result = source_data_[source_data_pointer_];
+	if(source_data_pointer_ == source_.size()) return 0xff;
+	uint8_t result = source_[source_data_pointer_];
 	source_data_pointer_++;
 	return result;
 }
 
 uint32_t CSW::get_next_int32le() {
-	if(source_data_pointer_ > source_data_.size() - 4) return 0xffff;
+	if(source_data_pointer_ + 4 > source_.size()) return 0xffff;
 	uint32_t result = uint32_t(
-		(source_data_[source_data_pointer_ + 0] << 0) |
-		(source_data_[source_data_pointer_ + 1] << 8) |
-		(source_data_[source_data_pointer_ + 2] << 16) |
-		(source_data_[source_data_pointer_ + 3] << 24));
+		(source_[source_data_pointer_ + 0] << 0) |
+		(source_[source_data_pointer_ + 1] << 8) |
+		(source_[source_data_pointer_ + 2] << 16) |
+		(source_[source_data_pointer_ + 3] << 24));
 	source_data_pointer_ += 4;
 	return result;
 }
@@ -115,7 +117,7 @@ void CSW::invert_pulse() {
 }
 
 bool CSW::is_at_end() {
-	return source_data_pointer_ == source_data_.size();
+	return source_data_pointer_ == source_.size();
 }
 
 void CSW::virtual_reset() {
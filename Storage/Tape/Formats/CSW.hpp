@@ -10,7 +10,9 @@
 #define CSW_hpp
 
 #include "../Tape.hpp"
+#include "../../FileHolder.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <zlib.h>
@@ -37,8 +39,10 @@ class CSW: public Tape {
 
 		/*!
 			Constructs a @c CSW containing content as specified. Does not throw.
+
+			Uncompressed data is used in place, so @c data must remain valid for the lifetime of this CSW.
 		*/
-		CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate);
+		CSW(Storage::FileHolder::Span data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate, uint32_t number_of_waves);
 
 		enum {
 			ErrorNotCSW
@@ -58,7 +62,11 @@ class CSW: public Tape {
 		uint32_t get_next_int32le();
 		void invert_pulse();
 
-		std::vector<uint8_t> source_data_;
+		void set_data(Storage::FileHolder::Span data, CompressionType compression_type, uint32_t number_of_waves);
+
+		std::unique_ptr<Storage::FileHolder> file_;	// Retained, if the source is a file, so that it can be used in place.
+		std::vector<uint8_t> source_data_;			// Holds the decompressed data, if the source was compressed.
+		Storage::FileHolder::Span source_;
 		std::size_t source_data_pointer_;
 };
 
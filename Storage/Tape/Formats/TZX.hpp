@@ -35,6 +35,7 @@ class TZX: public PulseQueuedTape {
 
 	private:
 		Storage::FileHolder file_;
+		Storage::FileHolder::Cursor data_;	// All parsing is in place, via this cursor.
 
 		void virtual_reset();
 		void get_next_pulses();
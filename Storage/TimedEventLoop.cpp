@@ -10,7 +10,6 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cmath>
 
 using namespace Storage;
 
@@ -54,7 +53,7 @@ Cycles::IntType TimedEventLoop::get_input_clock_rate() const {
 }
 
 void TimedEventLoop::reset_timer() {
-	subcycles_until_event_ = 0.0;
+	subcycles_until_event_ = 0;
 	cycles_until_event_ = 0;
 }
 
@@ -64,21 +63,26 @@ void TimedEventLoop::jump_to_next_event() {
 }
 
 void TimedEventLoop::set_next_event_time_interval(Time interval) {
-	set_next_event_time_interval(interval.get<float>());
+	// [interval] * [input clock rate] = [interval.length] * [input clock rate] / [interval.clock_rate].
+	set_next_event_cycle_interval(uint64_t(interval.length) * uint64_t(input_clock_rate_), interval.clock_rate);
 }
 
-void TimedEventLoop::set_next_event_time_interval(float interval) {
-	// Calculate [interval]*[input clock rate] + [subcycles until this event]
-	float float_interval = interval * float(input_clock_rate_) + subcycles_until_event_;
+void TimedEventLoop::set_next_event_cycle_interval(uint64_t numerator, uint32_t denominator) {
+	assert(denominator);
+
+	// Re-express the fraction carried from the previous interval if the denominator has changed.
+	if(denominator != subcycle_denominator_) {
+		subcycles_until_event_ = (subcycles_until_event_ * denominator) / subcycle_denominator_;
+		subcycle_denominator_ = denominator;
+	}
 
 	// So this event will fire in the integral number of cycles from now, putting us at the remainder
-	// number of subcycles
-	const Cycles::IntType addition = Cycles::IntType(float_interval);
-	cycles_until_event_ += addition;
-	subcycles_until_event_ = fmodf(float_interval, 1.0);
+	// number of subcycles.
+	const uint64_t total = numerator + subcycles_until_event_;
+	cycles_until_event_ += Cycles::IntType(total / denominator);
+	subcycles_until_event_ = total % denominator;
 
 	assert(cycles_until_event_ >= 0);
-	assert(subcycles_until_event_ >= 0.0);
 }
 
 Time TimedEventLoop::get_time_into_next_event() {
@@ -64,7 +64,16 @@ namespace Storage {
 				Sets the time interval, as a proportion of a second, until the next event should be triggered.
 			*/
 			void set_next_event_time_interval(Time interval);
-			void set_next_event_time_interval(float interval);
+
+			/*!
+				Sets the interval until the next event should be triggered as @c numerator / @c denominator input cycles.
+
+				Arithmetic is integral; any fraction of a cycle is carried forward to the next interval, exactly if that
+				has the same denominator and otherwise rounded down to the nearest 1/denominator. So a stream of events
+				that shares a denominator, such as the bits of a track or the pulses of a tape block, is timed without
+				cumulative error.
+			*/
+			void set_next_event_cycle_interval(uint64_t numerator, uint32_t denominator);
 
 			/*!
 				Communicates that the next event is triggered. A subclass will idiomatically process that event
@@ -103,7 +112,10 @@ namespace Storage {
 		private:
 			Cycles::IntType input_clock_rate_ = 0;
 			Cycles::IntType cycles_until_event_ = 0;
-			float subcycles_until_event_ = 0.0;
+
+			// The fraction of a cycle until the event, as subcycles_until_event_ / subcycle_denominator_.
+			uint64_t subcycles_until_event_ = 0;
+			uint32_t subcycle_denominator_ = 1;
 	};
 
 }